@@ -10,189 +10,95 @@
 // (at your option) any later version.
 
 #include "audio.hpp"
-#include <aesndlib.h>
-#include <cstring>
-#include <vector>
 
-// Generated symbols from Makefile (bin2o)
+// Generated symbols from Makefile (sfx_convert, then bin2o)
 extern "C" {
-    extern const u8 sfx_flap_wav[];
-    extern const u8 sfx_flap_wav_end[];
+    extern const u8 sfx_flap_pcm[];
+    extern const u8 sfx_flap_pcm_end[];
 
-    extern const u8 sfx_score_wav[];
-    extern const u8 sfx_score_wav_end[];
+    extern const u8 sfx_score_pcm[];
+    extern const u8 sfx_score_pcm_end[];
 
-    extern const u8 sfx_hit_wav[];
-    extern const u8 sfx_hit_wav_end[];
+    extern const u8 sfx_hit_pcm[];
+    extern const u8 sfx_hit_pcm_end[];
 
-    extern const u8 sfx_fall_wav[];
-    extern const u8 sfx_fall_wav_end[];
+    extern const u8 sfx_fall_pcm[];
+    extern const u8 sfx_fall_pcm_end[];
 
-    extern const u8 sfx_transition_wav[];
-    extern const u8 sfx_transition_wav_end[];
+    extern const u8 sfx_transition_pcm[];
+    extern const u8 sfx_transition_pcm_end[];
+}
+
+// Which sound keeps a voice when they are all busy: the crash above the
+// point scored above the flap, which repeats so often that losing one
+// goes unnoticed
+static const u8 PRIORITY_FLAP = 0;
+static const u8 PRIORITY_TRANSITION = 1;
+static const u8 PRIORITY_SCORE = 2;
+static const u8 PRIORITY_FALL = 3;
+static const u8 PRIORITY_HIT = 3;
+
+// The samples are played straight out of the embedded files
+static SoundBank load_sounds()
+{
+  SoundBank bank;
+  bank.flap = open_sound(sfx_flap_pcm, sfx_flap_pcm_end - sfx_flap_pcm);
+  bank.score = open_sound(sfx_score_pcm, sfx_score_pcm_end - sfx_score_pcm);
+  bank.hit = open_sound(sfx_hit_pcm, sfx_hit_pcm_end - sfx_hit_pcm);
+  bank.fall = open_sound(sfx_fall_pcm, sfx_fall_pcm_end - sfx_fall_pcm);
+  bank.transition = open_sound(sfx_transition_pcm, sfx_transition_pcm_end - sfx_transition_pcm);
+  return bank;
+}
+
+const SoundBank& sound_bank()
+{
+  static const SoundBank bank = load_sounds();
+  return bank;
 }
 
 Audio::Audio()
+  : sounds(sound_bank())
 {
-  AESND_Init();
-  AESND_Pause(false);
-
-  // Initialize Voices
-  voice_flap = std::make_unique<Voice>();
-  voice_score = std::make_unique<Voice>();
-  voice_hit = std::make_unique<Voice>();
-  voice_fall = std::make_unique<Voice>();
-  voice_transition = std::make_unique<Voice>();
-
-  // Load Sounds
-  sound_flap = LoadWav(sfx_flap_wav, sfx_flap_wav_end - sfx_flap_wav);
-  sound_score = LoadWav(sfx_score_wav, sfx_score_wav_end - sfx_score_wav);
-  sound_hit = LoadWav(sfx_hit_wav, sfx_hit_wav_end - sfx_hit_wav);
-  sound_fall = LoadWav(sfx_fall_wav, sfx_fall_wav_end - sfx_fall_wav);
-  sound_transition = LoadWav(sfx_transition_wav, sfx_transition_wav_end - sfx_transition_wav);
+  Voice::InitBackend();
+  voices = std::make_unique<VoicePool>();
 }
 
 Audio::~Audio()
 {
-  voice_flap.reset();
-  voice_score.reset();
-  voice_hit.reset();
-  voice_fall.reset();
-  voice_transition.reset();
+  voices.reset();
 
-  AESND_Pause(true);
+  Voice::ShutdownBackend();
 }
 
 void Audio::PlayFlap()
 {
-  if (sound_flap)
-  {
-    voice_flap->SetVolume(200);
-    voice_flap->Play(*sound_flap);
-  }
+  Play(sounds.flap.get(), PRIORITY_FLAP, 200);
 }
 
 void Audio::PlayScore()
 {
-  if (sound_score)
-  {
-    voice_score->SetVolume(255);
-    voice_score->Play(*sound_score);
-  }
+  Play(sounds.score.get(), PRIORITY_SCORE);
 }
 
 void Audio::PlayHit()
 {
-  if (sound_hit)
-  {
-    voice_hit->SetVolume(255);
-    voice_hit->Play(*sound_hit);
-  }
+  Play(sounds.hit.get(), PRIORITY_HIT);
 }
 
 void Audio::PlayFall()
 {
-  if (sound_fall)
-  {
-    voice_fall->SetVolume(255);
-    voice_fall->Play(*sound_fall);
-  }
+  Play(sounds.fall.get(), PRIORITY_FALL);
 }
 
 void Audio::PlayTransition()
 {
-  if (sound_transition)
-  {
-    voice_transition->SetVolume(255);
-    voice_transition->Play(*sound_transition);
-  }
+  Play(sounds.transition.get(), PRIORITY_TRANSITION);
 }
 
-std::unique_ptr<Sound> Audio::LoadWav(const u8* data, u32 size)
+bool Audio::Play(const Sound* sound, u8 priority, u16 volume, f32 pitch)
 {
-  if (size < 44) return nullptr;
-
-  auto read16 = [&](u32 offset) -> u16 {
-    return data[offset] | (data[offset + 1] << 8);
-  };
-  auto read32 = [&](u32 offset) -> u32 {
-    return data[offset] | (data[offset + 1] << 8) |
-           (data[offset + 2] << 16) | (data[offset + 3] << 24);
-  };
-
-  if (memcmp(data, "RIFF", 4) != 0) return nullptr;
-  if (memcmp(data + 8, "WAVE", 4) != 0) return nullptr;
-
-  u32 ptr = 12;
-  u32 fmt_size = 0;
-  u16 channels = 0;
-  u32 sample_rate = 0;
-  u16 bits_per_sample = 0;
-
-  while (ptr < size - 8)
-  {
-    if (memcmp(data + ptr, "fmt ", 4) == 0)
-    {
-      fmt_size = read32(ptr + 4);
-      channels = read16(ptr + 10);
-      sample_rate = read32(ptr + 12);
-      bits_per_sample = read16(ptr + 22);
-      break;
-    }
-    ptr++;
-  }
-
-  if (sample_rate == 0) return nullptr;
-
-  ptr = 12 + 8 + fmt_size;
-  u32 data_offset = 0;
-  u32 data_len = 0;
-
-  ptr = 12;
-  while (ptr < size - 8)
-  {
-    if (memcmp(data + ptr, "data", 4) == 0)
-    {
-      data_len = read32(ptr + 4);
-      data_offset = ptr + 8;
-      break;
-    }
-    ptr++;
-  }
-
-  if (data_offset == 0 || data_offset + data_len > size) return nullptr;
-
-  u32 format;
-  std::vector<u8> audio_buffer;
-
-  if (bits_per_sample == 8)
-  {
-    format = (channels == 2) ? VOICE_STEREO8 : VOICE_MONO8;
-    audio_buffer.assign(data + data_offset, data + data_offset + data_len);
-  }
-  else if (bits_per_sample == 16)
-  {
-    format = (channels == 2) ? VOICE_STEREO16 : VOICE_MONO16;
-
-    audio_buffer.resize(data_len);
-    for (u32 i = 0; i < data_len; i += 2)
-    {
-      u8 low = data[data_offset + i];
-      u8 high = data[data_offset + i + 1];
-      audio_buffer[i] = high;
-      audio_buffer[i + 1] = low;
-    }
-  }
-  else
-  {
-    return nullptr;
-  }
-
-  return std::make_unique<Sound>(
-    format,
-    std::move(audio_buffer),
-    static_cast<f32>(sample_rate)
-  );
+  return sound && voices->play(*sound, priority, volume, pitch,
+                               Voice::PlaybackMicros());
 }
 
 // EOF
@@ -12,8 +12,22 @@
 #pragma once
 
 #include <memory>
-#include "voice.hpp"
 #include "sound.hpp"
+#include "voice_pool.hpp"
+
+// The game's sound effects: views over the converted sound files embedded
+// in the binary, made on first use and kept for the life of the program.
+// Nothing here touches the audio hardware.
+struct SoundBank
+{
+  std::unique_ptr<Sound> flap;
+  std::unique_ptr<Sound> score;
+  std::unique_ptr<Sound> hit;
+  std::unique_ptr<Sound> fall;
+  std::unique_ptr<Sound> transition;
+};
+
+const SoundBank& sound_bank();
 
 class Audio
 {
@@ -27,23 +41,17 @@ public:
   void PlayFall();
   void PlayTransition();
 
+  // Fire and forget on the shared voices; a sound of higher priority may
+  // take over a voice from one of lower (see VoicePool). Volume is 0 to
+  // 255; pitch scales the sample rate. False if the sound was dropped.
+  bool Play(const Sound* sound, u8 priority, u16 volume = 255, f32 pitch = 1.0f);
+
 private:
-  // Voices (Channels)
-  std::unique_ptr<Voice> voice_flap;
-  std::unique_ptr<Voice> voice_score;
-  std::unique_ptr<Voice> voice_hit;
-  std::unique_ptr<Voice> voice_fall;
-  std::unique_ptr<Voice> voice_transition;
+  // Voices (Channels), made once the backend is up
+  std::unique_ptr<VoicePool> voices;
 
   // Sounds (Data)
-  std::unique_ptr<Sound> sound_flap;
-  std::unique_ptr<Sound> sound_score;
-  std::unique_ptr<Sound> sound_hit;
-  std::unique_ptr<Sound> sound_fall;
-  std::unique_ptr<Sound> sound_transition;
-
-  // Helper to parse WAV data from memory
-  std::unique_ptr<Sound> LoadWav(const u8* data, u32 size);
+  const SoundBank& sounds;
 };
 
 // EOF
@@ -0,0 +1,135 @@
+// src/autopilot.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#include "autopilot.hpp"
+#include "constants.hpp"
+
+static int count_down(int cooldown)
+{
+  return cooldown > 0 ? cooldown - 1 : 0;
+}
+
+Autopilot::Autopilot(int horizon, int node_budget)
+  : horizon(horizon)
+  , node_budget(node_budget)
+  , nodes_left(0)
+  , cooldown(0)
+  , total_nodes(0)
+{
+}
+
+void Autopilot::reset()
+{
+  cooldown = 0;
+}
+
+// Move ordering: flap first when the bird sits low in the next gap
+bool Autopilot::prefers_flap(const GameSnapshot& state)
+{
+  const Pipe& next = state.physics.pipe_iter ? state.pipe_2 : state.pipe_1;
+  const Scalar bird_bottom = state.physics.get_y() + Scalar(BIRD_HEIGHT * BIRD_SCALE);
+  return bird_bottom > next.y - PIPE_GAP / 4;
+}
+
+// Returns how many ticks deep the best line found survives
+int Autopilot::search(const GameSnapshot& state, int depth, int cooldown)
+{
+  if (depth >= horizon)
+  {
+    return horizon;
+  }
+
+  int best = depth;
+  const bool flap_first = cooldown == 0 && prefers_flap(state);
+
+  for (int i = 0; i < 2 && nodes_left > 0; i++)
+  {
+    const bool flap = (i == 0) == flap_first;
+    if (flap && cooldown > 0)
+    {
+      continue;
+    }
+
+    GameSnapshot child = state;
+    step_snapshot(child, flap);
+    nodes_left--;
+
+    if (child.physics.dead)
+    {
+      continue;
+    }
+
+    int reached = search(child, depth + 1,
+                         flap ? FLAP_COOLDOWN : count_down(cooldown));
+    if (reached >= horizon)
+    {
+      return horizon;
+    }
+    if (reached > best)
+    {
+      best = reached;
+    }
+  }
+
+  return best;
+}
+
+bool Autopilot::decide(const GameSnapshot& now)
+{
+  const bool flap_first = cooldown == 0 && prefers_flap(now);
+
+  bool best_flap = false;
+  int best_depth = -1;
+  int used = 0;
+
+  // Each root move gets half the budget; the second also inherits whatever
+  // the first left unused
+  nodes_left = 0;
+  for (int i = 0; i < 2; i++)
+  {
+    const bool flap = (i == 0) == flap_first;
+    if (flap && cooldown > 0)
+    {
+      continue;
+    }
+
+    int share = i == 0 ? node_budget / 2 : node_budget - used - nodes_left;
+    nodes_left += share;
+    int before = nodes_left;
+
+    GameSnapshot child = now;
+    step_snapshot(child, flap);
+    nodes_left--;
+
+    int reached = 0;
+    if (!child.physics.dead)
+    {
+      reached = search(child, 1, flap ? FLAP_COOLDOWN : count_down(cooldown));
+    }
+    used += before - nodes_left;
+
+    if (reached > best_depth)
+    {
+      best_depth = reached;
+      best_flap = flap;
+    }
+    if (reached >= horizon)
+    {
+      break;
+    }
+  }
+
+  total_nodes += used;
+  cooldown = best_flap ? FLAP_COOLDOWN : count_down(cooldown);
+  return best_flap;
+}
+
+// EOF
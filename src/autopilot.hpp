@@ -0,0 +1,54 @@
+// src/autopilot.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include "game_snapshot.hpp"
+#include "types.hpp"
+
+// Lookahead search over flap/no-flap sequences. Every tick it clones the
+// current snapshot and searches depth-first for an input sequence that
+// survives the whole horizon, trying the move that heads toward the next
+// gap first. The work per tick is capped by a node budget (one node = one
+// simulated tick), which keeps it inside the frame time on the console and
+// makes its choices identical on every platform.
+class Autopilot
+{
+private:
+  int horizon;
+  int node_budget;
+  int nodes_left;
+  int cooldown;
+  u64 total_nodes;
+
+  int search(const GameSnapshot& state, int depth, int cooldown);
+  static bool prefers_flap(const GameSnapshot& state);
+
+public:
+  // Ticks after a flap before the search considers flapping again
+  static const int FLAP_COOLDOWN = 6;
+
+  explicit Autopilot(int horizon = 40, int node_budget = 1500);
+
+  // Call at the start of every run
+  void reset();
+
+  // Input for the next tick
+  bool decide(const GameSnapshot& now);
+
+  // Simulated ticks since construction (search throughput benchmark)
+  u64 get_total_nodes() const
+  {
+    return total_nodes;
+  }
+};
+
+// EOF
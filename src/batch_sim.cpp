@@ -0,0 +1,703 @@
+// src/batch_sim.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C Standard Library
+#include <string.h>
+
+// SIMD intrinsics (host builds only)
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Project headers
+#include "batch_sim.hpp"
+#include "constants.hpp"
+#include "physics.hpp"
+#include "bird_shape.hpp"
+#include "sprite_mask.hpp"
+
+// Every value the bird loop needs that does not depend on the bird. All
+// expressions are evaluated in the same order and precision as Physics so
+// the comparisons below see bit-identical operands.
+//
+// The SIMD kernels only filter: they look up each bird's tilted shape,
+// apply the screen bounds exactly and test the box around the bird's whole
+// move (plus a pixel of slack for rounding) against the pipe edges. Birds
+// that touch a pipe that way go through pipe_hit, which runs the same
+// Physics::pipe_contact as the game.
+struct StepTerms
+{
+  Scalar gravity;
+  Scalar flap_height;
+  Scalar bird_x;
+  const Pipe* pipes[2];
+
+  // Pipe 1 / pipe 2 vertical edges (see Physics::get_pipe_*_hitbox)
+  Scalar top_bottom[2];     // Bottom edge of the top pipe
+  Scalar bottom_top[2];     // Top edge of the bottom pipe
+  Scalar bottom_bottom[2];  // Bottom edge of the bottom pipe
+  bool overlaps_x[2];       // The pipe comes within reach of any tilt
+
+  // Scoring windows (see Physics::update_score)
+  bool passing[2];
+};
+
+// Added around the SIMD filter's box so the heights pipe_contact
+// interpolates, which may round past the ends of the move, stay inside it
+const Scalar FILTER_SLACK = 1;
+
+// Stride of BIRD_SHAPES in Scalars, for gathers
+const int SHAPE_STRIDE = sizeof(BirdShape) / sizeof(Scalar);
+
+static StepTerms compute_terms(const Pipe& pipe_1, const Pipe& pipe_2)
+{
+  StepTerms terms;
+  terms.gravity = Physics::gravity;
+  terms.flap_height = Physics::flap_height;
+  terms.bird_x = Scalar(BIRD_START_X);
+
+  const Scalar bird_center_x = terms.bird_x + Scalar((BIRD_WIDTH * BIRD_SCALE) / 2);
+  const Scalar scoring_zone = 20;
+
+  const Pipe* pipes[2] = { &pipe_1, &pipe_2 };
+  for (int p = 0; p < 2; p++)
+  {
+    const Pipe& pipe = *pipes[p];
+    terms.pipes[p] = pipes[p];
+
+    terms.top_bottom[p] = Scalar(0) + (pipe.y - PIPE_GAP);
+    terms.bottom_top[p] = pipe.y;
+    terms.bottom_bottom[p] = pipe.y + (GROUND_Y - pipe.y);
+
+    Scalar enter, exit;
+    terms.overlaps_x[p] = Physics::overlap_window(terms.bird_x + bird_reach_left(),
+                                                  terms.bird_x + bird_reach_right(),
+                                                  pipe, enter, exit);
+    terms.passing[p] = pipe.x + PIPE_WIDTH < bird_center_x &&
+                       pipe.x + PIPE_WIDTH + scoring_zone > bird_center_x;
+  }
+
+  return terms;
+}
+
+// Whether a bird moving from `from` to `top` hits a pipe, as Physics::sweep
+// decides it
+static bool pipe_hit(const StepTerms& t, Scalar from, Scalar top, int tilt)
+{
+  for (int p = 0; p < 2; p++)
+  {
+    if (t.overlaps_x[p] &&
+        Physics::pipe_contact(t.bird_x, from, top, tilt, *t.pipes[p]).surface !=
+          Surface::None)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+// Reference kernel, also handles the tail left over by the SIMD kernels
+static void step_scalar(const StepTerms& t, size_t begin, size_t end,
+                        const u8* flaps, Scalar* y, Scalar* velocity, u32* dead,
+                        u32* pipe_iter, s32* score)
+{
+  for (size_t i = begin; i < end; i++)
+  {
+    bool is_dead = dead[i] != 0;
+
+    if (flaps[i] && !is_dead)
+    {
+      velocity[i] = t.flap_height;
+    }
+    else
+    {
+      velocity[i] += t.gravity;
+    }
+
+    const Scalar from = y[i];
+    y[i] += velocity[i];
+
+    if (is_dead)
+    {
+      continue;
+    }
+
+    const Scalar top = y[i];
+    const int tilt = bird_tilt(velocity[i]);
+    const BirdShape& shape = bird_shape(tilt);
+
+    if (top + shape.top < 0 || top + shape.bottom >= GROUND_Y ||
+        pipe_hit(t, from, top, tilt))
+    {
+      dead[i] = ~0u;
+      continue;
+    }
+
+    bool passed = pipe_iter[i] ? t.passing[1] : t.passing[0];
+    if (passed)
+    {
+      pipe_iter[i] = ~pipe_iter[i];
+      score[i]++;
+    }
+  }
+}
+
+#if defined(__AVX2__)
+
+// Pipe test for the lanes set in `candidates` (birds whose box met a
+// pipe's edges). from/top/velocity hold floats or Fixed values, whichever
+// Scalar is. Returns all ones in the lanes that really hit.
+static __m256i narrow_phase(const StepTerms& t, __m256i candidates, __m256i from,
+                            __m256i top, __m256i velocity)
+{
+  const int lanes = _mm256_movemask_ps(_mm256_castsi256_ps(candidates));
+  if (lanes == 0)
+  {
+    return _mm256_setzero_si256();
+  }
+
+  Scalar from_lanes[8], top_lanes[8], velocity_lanes[8];
+  s32 hits[8];
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(from_lanes), from);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(top_lanes), top);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(velocity_lanes), velocity);
+  for (int lane = 0; lane < 8; lane++)
+  {
+    hits[lane] = ((lanes >> lane) & 1) &&
+                 pipe_hit(t, from_lanes[lane], top_lanes[lane],
+                          bird_tilt(velocity_lanes[lane]))
+                 ? -1 : 0;
+  }
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hits));
+}
+
+// Clamps half-velocity steps to a tilt (see bird_tilt) and returns its
+// offset in Scalars from the untilted entry of BIRD_SHAPES, for gathers
+static __m256i shape_index(__m256i steps)
+{
+  const __m256i tilt = _mm256_max_epi32(
+    _mm256_min_epi32(steps, _mm256_set1_epi32(TILT_STEPS)),
+    _mm256_set1_epi32(-TILT_STEPS));
+  return _mm256_mullo_epi32(tilt, _mm256_set1_epi32(SHAPE_STRIDE));
+}
+
+#elif defined(__SSE2__)
+
+static __m128i narrow_phase(const StepTerms& t, __m128i candidates, __m128i from,
+                            __m128i top, __m128i velocity)
+{
+  const int lanes = _mm_movemask_ps(_mm_castsi128_ps(candidates));
+  if (lanes == 0)
+  {
+    return _mm_setzero_si128();
+  }
+
+  Scalar from_lanes[4], top_lanes[4], velocity_lanes[4];
+  s32 hits[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(from_lanes), from);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(top_lanes), top);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(velocity_lanes), velocity);
+  for (int lane = 0; lane < 4; lane++)
+  {
+    hits[lane] = ((lanes >> lane) & 1) &&
+                 pipe_hit(t, from_lanes[lane], top_lanes[lane],
+                          bird_tilt(velocity_lanes[lane]))
+                 ? -1 : 0;
+  }
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(hits));
+}
+
+// Top and bottom edges of the tilted shape for half-velocity steps (see
+// bird_tilt). SSE2 has no gather, so this looks them up one lane at a time.
+static void shape_edges(__m128i steps, __m128i& top_edge, __m128i& bottom_edge)
+{
+  s32 lanes[4];
+  Scalar tops[4], bottoms[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), steps);
+  for (int lane = 0; lane < 4; lane++)
+  {
+    const int tilt = lanes[lane] < -TILT_STEPS ? -TILT_STEPS
+                     : (lanes[lane] > TILT_STEPS ? TILT_STEPS : lanes[lane]);
+    tops[lane] = bird_shape(tilt).top;
+    bottoms[lane] = bird_shape(tilt).bottom;
+  }
+  top_edge = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tops));
+  bottom_edge = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottoms));
+}
+
+#endif
+
+#if defined(FLAPWII_FIXED_POINT) && defined(__AVX2__)
+
+// Fixed-point birds: the same steps on the raw s32 values. Integers have no
+// NaN, so each !(a < b) of the reference kernel is a plain a >= b here.
+static size_t step_simd(const StepTerms& t, size_t count, const u8* flaps,
+                        Scalar* y, Scalar* velocity, u32* dead, u32* pipe_iter,
+                        s32* score)
+{
+  const __m256i gravity = _mm256_set1_epi32(t.gravity.raw);
+  const __m256i flap_height = _mm256_set1_epi32(t.flap_height.raw);
+  const __m256i half = _mm256_set1_epi32(Fixed::ONE / 2);
+  const __m256i slack = _mm256_set1_epi32(FILTER_SLACK.raw);
+  const __m256i ground = _mm256_set1_epi32(Scalar(GROUND_Y).raw);
+  const int* top_offsets = &BIRD_SHAPES[TILT_STEPS].top.raw;
+  const int* bottom_offsets = &BIRD_SHAPES[TILT_STEPS].bottom.raw;
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i ones = _mm256_set1_epi32(-1);
+  const __m256i passing_1 = _mm256_set1_epi32(t.passing[0] ? -1 : 0);
+  const __m256i passing_2 = _mm256_set1_epi32(t.passing[1] ? -1 : 0);
+
+  __m256i top_bottom[2], bottom_top[2], bottom_bottom[2];
+  for (int p = 0; p < 2; p++)
+  {
+    top_bottom[p] = _mm256_set1_epi32(t.top_bottom[p].raw);
+    bottom_top[p] = _mm256_set1_epi32(t.bottom_top[p].raw);
+    bottom_bottom[p] = _mm256_set1_epi32(t.bottom_bottom[p].raw);
+  }
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256i was_dead = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dead + i));
+    __m256i flap = _mm256_cvtepu8_epi32(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(flaps + i)));
+    __m256i do_flap = _mm256_andnot_si256(
+      was_dead, _mm256_xor_si256(_mm256_cmpeq_epi32(flap, zero), ones));
+
+    __m256i v = _mm256_add_epi32(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(velocity + i)), gravity);
+    v = _mm256_blendv_epi8(v, flap_height, do_flap);
+    __m256i from = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+    __m256i top = _mm256_add_epi32(from, v);
+
+    // to_pixel(v + v), clamped to a tilt
+    __m256i index = shape_index(_mm256_srai_epi32(
+      _mm256_add_epi32(_mm256_add_epi32(v, v), half), Fixed::FRACTION_BITS));
+    __m256i top_edge = _mm256_i32gather_epi32(top_offsets, index, 4);
+    __m256i bottom_edge = _mm256_i32gather_epi32(bottom_offsets, index, 4);
+    __m256i high = _mm256_sub_epi32(
+      _mm256_add_epi32(_mm256_min_epi32(from, top), top_edge), slack);
+    __m256i low_bottom = _mm256_add_epi32(
+      _mm256_add_epi32(_mm256_max_epi32(from, top), bottom_edge), slack);
+
+    // top + shape.top < 0 || top + shape.bottom >= GROUND_Y
+    __m256i bounds = _mm256_or_si256(
+      _mm256_cmpgt_epi32(zero, _mm256_add_epi32(top, top_edge)),
+      _mm256_xor_si256(_mm256_cmpgt_epi32(ground, _mm256_add_epi32(top, bottom_edge)),
+                       ones));
+    __m256i pipe_box = zero;
+    for (int p = 0; p < 2; p++)
+    {
+      if (!t.overlaps_x[p])
+      {
+        continue;
+      }
+      // low_bottom >= 0 && high <= top_bottom
+      __m256i miss_top = _mm256_or_si256(_mm256_cmpgt_epi32(zero, low_bottom),
+                                         _mm256_cmpgt_epi32(high, top_bottom[p]));
+      // low_bottom >= bottom_top && high <= bottom_bottom
+      __m256i miss_bottom = _mm256_or_si256(_mm256_cmpgt_epi32(bottom_top[p], low_bottom),
+                                            _mm256_cmpgt_epi32(high, bottom_bottom[p]));
+      pipe_box = _mm256_or_si256(pipe_box, _mm256_andnot_si256(miss_top, ones));
+      pipe_box = _mm256_or_si256(pipe_box, _mm256_andnot_si256(miss_bottom, ones));
+    }
+    __m256i candidates = _mm256_andnot_si256(_mm256_or_si256(was_dead, bounds), pipe_box);
+    __m256i hit = _mm256_or_si256(bounds, narrow_phase(t, candidates, from, top, v));
+
+    __m256i now_dead = _mm256_or_si256(was_dead, hit);
+
+    __m256i iter = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pipe_iter + i));
+    __m256i passed = _mm256_or_si256(_mm256_andnot_si256(iter, passing_1),
+                                     _mm256_and_si256(iter, passing_2));
+    __m256i scored = _mm256_andnot_si256(now_dead, passed);
+    __m256i points = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(score + i));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(velocity + i), v);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(y + i), top);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dead + i), now_dead);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pipe_iter + i),
+                        _mm256_xor_si256(iter, scored));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(score + i),
+                        _mm256_sub_epi32(points, scored));
+  }
+
+  return i;
+}
+
+#elif defined(FLAPWII_FIXED_POINT) && defined(__SSE2__)
+
+static inline __m128i select_si128(__m128i mask, __m128i a, __m128i b)
+{
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static size_t step_simd(const StepTerms& t, size_t count, const u8* flaps,
+                        Scalar* y, Scalar* velocity, u32* dead, u32* pipe_iter,
+                        s32* score)
+{
+  const __m128i gravity = _mm_set1_epi32(t.gravity.raw);
+  const __m128i flap_height = _mm_set1_epi32(t.flap_height.raw);
+  const __m128i half = _mm_set1_epi32(Fixed::ONE / 2);
+  const __m128i slack = _mm_set1_epi32(FILTER_SLACK.raw);
+  const __m128i ground = _mm_set1_epi32(Scalar(GROUND_Y).raw);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ones = _mm_set1_epi32(-1);
+  const __m128i passing_1 = _mm_set1_epi32(t.passing[0] ? -1 : 0);
+  const __m128i passing_2 = _mm_set1_epi32(t.passing[1] ? -1 : 0);
+
+  __m128i top_bottom[2], bottom_top[2], bottom_bottom[2];
+  for (int p = 0; p < 2; p++)
+  {
+    top_bottom[p] = _mm_set1_epi32(t.top_bottom[p].raw);
+    bottom_top[p] = _mm_set1_epi32(t.bottom_top[p].raw);
+    bottom_bottom[p] = _mm_set1_epi32(t.bottom_bottom[p].raw);
+  }
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    int flap_bytes;
+    memcpy(&flap_bytes, flaps + i, sizeof(flap_bytes));
+    __m128i flap = _mm_cvtsi32_si128(flap_bytes);
+    flap = _mm_unpacklo_epi16(_mm_unpacklo_epi8(flap, zero), zero);
+
+    __m128i was_dead = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dead + i));
+    __m128i do_flap = _mm_andnot_si128(
+      was_dead, _mm_xor_si128(_mm_cmpeq_epi32(flap, zero), ones));
+
+    __m128i v = _mm_add_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(velocity + i)), gravity);
+    v = select_si128(do_flap, flap_height, v);
+    __m128i from = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+    __m128i top = _mm_add_epi32(from, v);
+
+    __m128i top_edge, bottom_edge;
+    shape_edges(_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(v, v), half),
+                               Fixed::FRACTION_BITS),
+                top_edge, bottom_edge);
+    __m128i rising = _mm_cmplt_epi32(from, top);
+    __m128i high = _mm_sub_epi32(
+      _mm_add_epi32(select_si128(rising, from, top), top_edge), slack);
+    __m128i low_bottom = _mm_add_epi32(
+      _mm_add_epi32(select_si128(rising, top, from), bottom_edge), slack);
+
+    __m128i bounds = _mm_or_si128(
+      _mm_cmplt_epi32(_mm_add_epi32(top, top_edge), zero),
+      _mm_xor_si128(_mm_cmplt_epi32(_mm_add_epi32(top, bottom_edge), ground), ones));
+    __m128i pipe_box = zero;
+    for (int p = 0; p < 2; p++)
+    {
+      if (!t.overlaps_x[p])
+      {
+        continue;
+      }
+      __m128i miss_top = _mm_or_si128(_mm_cmplt_epi32(low_bottom, zero),
+                                      _mm_cmpgt_epi32(high, top_bottom[p]));
+      __m128i miss_bottom = _mm_or_si128(_mm_cmplt_epi32(low_bottom, bottom_top[p]),
+                                         _mm_cmpgt_epi32(high, bottom_bottom[p]));
+      pipe_box = _mm_or_si128(pipe_box, _mm_andnot_si128(miss_top, ones));
+      pipe_box = _mm_or_si128(pipe_box, _mm_andnot_si128(miss_bottom, ones));
+    }
+    __m128i candidates = _mm_andnot_si128(_mm_or_si128(was_dead, bounds), pipe_box);
+    __m128i hit = _mm_or_si128(bounds, narrow_phase(t, candidates, from, top, v));
+
+    __m128i now_dead = _mm_or_si128(was_dead, hit);
+
+    __m128i iter = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pipe_iter + i));
+    __m128i passed = _mm_or_si128(_mm_andnot_si128(iter, passing_1),
+                                  _mm_and_si128(iter, passing_2));
+    __m128i scored = _mm_andnot_si128(now_dead, passed);
+    __m128i points = _mm_loadu_si128(reinterpret_cast<const __m128i*>(score + i));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(velocity + i), v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(y + i), top);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dead + i), now_dead);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pipe_iter + i),
+                     _mm_xor_si128(iter, scored));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(score + i),
+                     _mm_sub_epi32(points, scored));
+  }
+
+  return i;
+}
+
+#elif defined(__AVX2__)
+
+static size_t step_simd(const StepTerms& t, size_t count, const u8* flaps,
+                        float* y, float* velocity, u32* dead, u32* pipe_iter,
+                        s32* score)
+{
+  const __m256 gravity = _mm256_set1_ps(t.gravity);
+  const __m256 flap_height = _mm256_set1_ps(t.flap_height);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 slack = _mm256_set1_ps(FILTER_SLACK);
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 ground = _mm256_set1_ps(static_cast<float>(GROUND_Y));
+  const __m256i zero_i = _mm256_setzero_si256();
+  const __m256i ones = _mm256_set1_epi32(-1);
+  const __m256i passing_1 = _mm256_set1_epi32(t.passing[0] ? -1 : 0);
+  const __m256i passing_2 = _mm256_set1_epi32(t.passing[1] ? -1 : 0);
+
+  __m256 top_bottom[2], bottom_top[2], bottom_bottom[2];
+  for (int p = 0; p < 2; p++)
+  {
+    top_bottom[p] = _mm256_set1_ps(t.top_bottom[p]);
+    bottom_top[p] = _mm256_set1_ps(t.bottom_top[p]);
+    bottom_bottom[p] = _mm256_set1_ps(t.bottom_bottom[p]);
+  }
+
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256i was_dead = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dead + i));
+    __m256i flap = _mm256_cvtepu8_epi32(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(flaps + i)));
+    __m256i do_flap = _mm256_andnot_si256(
+      was_dead, _mm256_xor_si256(_mm256_cmpeq_epi32(flap, zero_i), ones));
+
+    __m256 v = _mm256_add_ps(_mm256_loadu_ps(velocity + i), gravity);
+    v = _mm256_blendv_ps(v, flap_height, _mm256_castsi256_ps(do_flap));
+    __m256 from = _mm256_loadu_ps(y + i);
+    __m256 top = _mm256_add_ps(from, v);
+
+    // to_pixel(v + v): truncate, then step down where that rounded up
+    __m256 steps = _mm256_add_ps(_mm256_add_ps(v, v), half);
+    __m256i whole = _mm256_cvttps_epi32(steps);
+    whole = _mm256_add_epi32(whole, _mm256_castps_si256(_mm256_cmp_ps(
+      steps, _mm256_cvtepi32_ps(whole), _CMP_LT_OQ)));
+    __m256i index = shape_index(whole);
+    __m256 top_edge = _mm256_i32gather_ps(&BIRD_SHAPES[TILT_STEPS].top, index, 4);
+    __m256 bottom_edge = _mm256_i32gather_ps(&BIRD_SHAPES[TILT_STEPS].bottom, index, 4);
+    __m256 high = _mm256_sub_ps(_mm256_add_ps(_mm256_min_ps(from, top), top_edge), slack);
+    __m256 low_bottom = _mm256_add_ps(_mm256_add_ps(_mm256_max_ps(top, from), bottom_edge),
+                                      slack);
+
+    __m256 bounds = _mm256_or_ps(
+      _mm256_cmp_ps(_mm256_add_ps(top, top_edge), zero, _CMP_LT_OQ),
+      _mm256_cmp_ps(_mm256_add_ps(top, bottom_edge), ground, _CMP_GE_OQ));
+    __m256 pipe_box = zero;
+    for (int p = 0; p < 2; p++)
+    {
+      if (!t.overlaps_x[p])
+      {
+        continue;
+      }
+      __m256 hit_top = _mm256_and_ps(_mm256_cmp_ps(low_bottom, zero, _CMP_NLT_UQ),
+                                     _mm256_cmp_ps(high, top_bottom[p], _CMP_NGT_UQ));
+      __m256 hit_bottom = _mm256_and_ps(_mm256_cmp_ps(low_bottom, bottom_top[p], _CMP_NLT_UQ),
+                                        _mm256_cmp_ps(high, bottom_bottom[p], _CMP_NGT_UQ));
+      pipe_box = _mm256_or_ps(pipe_box, _mm256_or_ps(hit_top, hit_bottom));
+    }
+    __m256i candidates = _mm256_andnot_si256(
+      _mm256_or_si256(was_dead, _mm256_castps_si256(bounds)), _mm256_castps_si256(pipe_box));
+    __m256i hit = _mm256_or_si256(
+      _mm256_castps_si256(bounds),
+      narrow_phase(t, candidates, _mm256_castps_si256(from), _mm256_castps_si256(top),
+                   _mm256_castps_si256(v)));
+
+    __m256i now_dead = _mm256_or_si256(was_dead, hit);
+
+    __m256i iter = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pipe_iter + i));
+    __m256i passed = _mm256_or_si256(_mm256_andnot_si256(iter, passing_1),
+                                     _mm256_and_si256(iter, passing_2));
+    __m256i scored = _mm256_andnot_si256(now_dead, passed);
+    __m256i points = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(score + i));
+
+    _mm256_storeu_ps(velocity + i, v);
+    _mm256_storeu_ps(y + i, top);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dead + i), now_dead);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pipe_iter + i),
+                        _mm256_xor_si256(iter, scored));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(score + i),
+                        _mm256_sub_epi32(points, scored));
+  }
+
+  return i;
+}
+
+#elif defined(__SSE2__)
+
+static inline __m128 select_ps(__m128 mask, __m128 a, __m128 b)
+{
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static size_t step_simd(const StepTerms& t, size_t count, const u8* flaps,
+                        float* y, float* velocity, u32* dead, u32* pipe_iter,
+                        s32* score)
+{
+  const __m128 gravity = _mm_set1_ps(t.gravity);
+  const __m128 flap_height = _mm_set1_ps(t.flap_height);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 slack = _mm_set1_ps(FILTER_SLACK);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 ground = _mm_set1_ps(static_cast<float>(GROUND_Y));
+  const __m128i zero_i = _mm_setzero_si128();
+  const __m128i ones = _mm_set1_epi32(-1);
+  const __m128i passing_1 = _mm_set1_epi32(t.passing[0] ? -1 : 0);
+  const __m128i passing_2 = _mm_set1_epi32(t.passing[1] ? -1 : 0);
+
+  __m128 top_bottom[2], bottom_top[2], bottom_bottom[2];
+  for (int p = 0; p < 2; p++)
+  {
+    top_bottom[p] = _mm_set1_ps(t.top_bottom[p]);
+    bottom_top[p] = _mm_set1_ps(t.bottom_top[p]);
+    bottom_bottom[p] = _mm_set1_ps(t.bottom_bottom[p]);
+  }
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    int flap_bytes;
+    memcpy(&flap_bytes, flaps + i, sizeof(flap_bytes));
+    __m128i flap = _mm_cvtsi32_si128(flap_bytes);
+    flap = _mm_unpacklo_epi16(_mm_unpacklo_epi8(flap, zero_i), zero_i);
+
+    __m128i was_dead = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dead + i));
+    __m128i do_flap = _mm_andnot_si128(
+      was_dead, _mm_xor_si128(_mm_cmpeq_epi32(flap, zero_i), ones));
+
+    __m128 v = _mm_add_ps(_mm_loadu_ps(velocity + i), gravity);
+    v = select_ps(_mm_castsi128_ps(do_flap), flap_height, v);
+    __m128 from = _mm_loadu_ps(y + i);
+    __m128 top = _mm_add_ps(from, v);
+
+    __m128 steps = _mm_add_ps(_mm_add_ps(v, v), half);
+    __m128i whole = _mm_cvttps_epi32(steps);
+    whole = _mm_add_epi32(whole, _mm_castps_si128(_mm_cmplt_ps(steps, _mm_cvtepi32_ps(whole))));
+    __m128i top_edge_i, bottom_edge_i;
+    shape_edges(whole, top_edge_i, bottom_edge_i);
+    __m128 top_edge = _mm_castsi128_ps(top_edge_i);
+    __m128 bottom_edge = _mm_castsi128_ps(bottom_edge_i);
+    __m128 high = _mm_sub_ps(_mm_add_ps(_mm_min_ps(from, top), top_edge), slack);
+    __m128 low_bottom = _mm_add_ps(_mm_add_ps(_mm_max_ps(top, from), bottom_edge), slack);
+
+    __m128 bounds = _mm_or_ps(_mm_cmplt_ps(_mm_add_ps(top, top_edge), zero),
+                              _mm_cmpge_ps(_mm_add_ps(top, bottom_edge), ground));
+    __m128 pipe_box = zero;
+    for (int p = 0; p < 2; p++)
+    {
+      if (!t.overlaps_x[p])
+      {
+        continue;
+      }
+      __m128 hit_top = _mm_and_ps(_mm_cmpnlt_ps(low_bottom, zero),
+                                  _mm_cmpngt_ps(high, top_bottom[p]));
+      __m128 hit_bottom = _mm_and_ps(_mm_cmpnlt_ps(low_bottom, bottom_top[p]),
+                                     _mm_cmpngt_ps(high, bottom_bottom[p]));
+      pipe_box = _mm_or_ps(pipe_box, _mm_or_ps(hit_top, hit_bottom));
+    }
+    __m128i candidates = _mm_andnot_si128(
+      _mm_or_si128(was_dead, _mm_castps_si128(bounds)), _mm_castps_si128(pipe_box));
+    __m128i hit = _mm_or_si128(
+      _mm_castps_si128(bounds),
+      narrow_phase(t, candidates, _mm_castps_si128(from), _mm_castps_si128(top),
+                   _mm_castps_si128(v)));
+
+    __m128i now_dead = _mm_or_si128(was_dead, hit);
+
+    __m128i iter = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pipe_iter + i));
+    __m128i passed = _mm_or_si128(_mm_andnot_si128(iter, passing_1),
+                                  _mm_and_si128(iter, passing_2));
+    __m128i scored = _mm_andnot_si128(now_dead, passed);
+    __m128i points = _mm_loadu_si128(reinterpret_cast<const __m128i*>(score + i));
+
+    _mm_storeu_ps(velocity + i, v);
+    _mm_storeu_ps(y + i, top);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dead + i), now_dead);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pipe_iter + i),
+                     _mm_xor_si128(iter, scored));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(score + i),
+                     _mm_sub_epi32(points, scored));
+  }
+
+  return i;
+}
+
+#else
+
+// PowerPC and other targets: the scalar kernel does all the work
+static size_t step_simd(const StepTerms&, size_t, const u8*, Scalar*, Scalar*,
+                        u32*, u32*, s32*)
+{
+  return 0;
+}
+
+#endif
+
+// ============================================================================
+// BatchSim
+// ============================================================================
+
+BatchSim::BatchSim(size_t count, u32 seed)
+  : count(count)
+  , rng(seed)
+  , y(count)
+  , velocity(count)
+  , dead(count)
+  , pipe_iter(count)
+  , score(count)
+  , pipe_1(rng)
+  , pipe_2(rng)
+  , first_round(true)
+{
+  collision_masks();  // Build the masks now rather than mid-step
+  reset(seed);
+}
+
+void BatchSim::reset(u32 seed)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    y[i] = Scalar(BIRD_START_Y);
+    velocity[i] = 0;
+    dead[i] = 0;
+    pipe_iter[i] = 0;
+    score[i] = 0;
+  }
+
+  rng.reseed(seed);
+  pipe_1.reset(rng);
+  pipe_2.reset(rng);
+  first_round = true;
+}
+
+void BatchSim::step(const u8* flaps)
+{
+  step_birds(flaps);
+  advance_pipes(pipe_1, pipe_2, first_round, rng);
+}
+
+void BatchSim::step_birds(const u8* flaps)
+{
+  const StepTerms terms = compute_terms(pipe_1, pipe_2);
+
+  size_t done = step_simd(terms, count, flaps, y.data(), velocity.data(),
+                          dead.data(), pipe_iter.data(), score.data());
+  step_scalar(terms, done, count, flaps, y.data(), velocity.data(),
+              dead.data(), pipe_iter.data(), score.data());
+}
+
+size_t BatchSim::alive_count() const
+{
+  size_t alive = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    alive += dead[i] == 0;
+  }
+  return alive;
+}
+
+// EOF
@@ -0,0 +1,84 @@
+// src/batch_sim.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+#include "pipe.hpp"
+#include "rng.hpp"
+#include "scalar.hpp"
+#include "types.hpp"
+
+// Structure-of-arrays simulator for many birds flying through one shared
+// pipe stream. Each step produces bit-identical results to calling
+// Physics::update_bird for every bird followed by advance_pipes, as
+// GameState::update_game does. Used for bot evaluation and benchmarking.
+//
+// The inner loop is written with SSE2/AVX2 intrinsics on x86 hosts and
+// falls back to plain scalar code elsewhere (e.g. the Wii's PowerPC).
+// Fixed-point builds use integer versions of the same kernels.
+class BatchSim
+{
+private:
+  size_t count;
+  Rng rng;
+
+  std::vector<Scalar> y;
+  std::vector<Scalar> velocity;
+  std::vector<u32> dead;       // All ones when dead (SIMD select mask)
+  std::vector<u32> pipe_iter;  // All ones when the next pipe is pipe_2
+  std::vector<s32> score;
+
+  void step_birds(const u8* flaps);
+
+public:
+  Pipe pipe_1;
+  Pipe pipe_2;
+  bool first_round;
+
+  BatchSim(size_t count, u32 seed);
+
+  // Put every bird back at the start and lay out the pipes from the seed,
+  // exactly as GameState does at the start of a run
+  void reset(u32 seed);
+
+  // Advance all birds and the pipes by one tick.
+  // flaps[i] != 0 means bird i pressed flap this tick.
+  void step(const u8* flaps);
+
+  size_t size() const
+  {
+    return count;
+  }
+
+  size_t alive_count() const;
+
+  // Per-bird state, laid out contiguously
+  const Scalar* get_y() const
+  {
+    return y.data();
+  }
+  const Scalar* get_velocity() const
+  {
+    return velocity.data();
+  }
+  const s32* get_score() const
+  {
+    return score.data();
+  }
+  bool is_dead(size_t i) const
+  {
+    return dead[i] != 0;
+  }
+};
+
+// EOF
@@ -0,0 +1,161 @@
+// src/bird_shape.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <array>
+#include "collision.hpp"
+#include "constants.hpp"
+#include "scalar.hpp"
+
+// The bird collides as it is drawn: turned by its velocity times
+// BIRD_TILT_PER_VELOCITY degrees (see render_game). The velocity is
+// quantized to half steps, its tilt index, and the shape for every index
+// comes from a table computed at compile time, so no trig runs while
+// playing and every build gets the same numbers.
+
+const int TILT_STEPS_PER_VELOCITY = 2;
+
+constexpr double TILT_DEGREES_PER_STEP =
+  static_cast<double>(BIRD_TILT_PER_VELOCITY) / SIM_FRAME_SCALE / TILT_STEPS_PER_VELOCITY;
+
+// Tilt indices run from -TILT_STEPS to TILT_STEPS (straight up to straight
+// down); steeper tilts are clamped
+const int TILT_STEPS = static_cast<int>(90.0 / TILT_DEGREES_PER_STEP);
+const int TILT_COUNT = 2 * TILT_STEPS + 1;
+
+// The bird at one tilt, relative to its position (the top-left corner of
+// the untilted sprite)
+struct BirdShape
+{
+  Scalar center_x;  // Where DrawImage puts the sprite's center
+  Scalar center_y;
+  Rotation rotation;
+
+  // Axis-aligned box around the tilted sprite
+  Scalar left;
+  Scalar top;
+  Scalar right;
+  Scalar bottom;
+};
+
+// Taylor series; only evaluated by the compiler, for |x| <= pi / 2
+constexpr double tilt_sine(double x)
+{
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 16; n++)
+  {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr double tilt_cosine(double x)
+{
+  double term = 1;
+  double sum = 1;
+  for (int n = 1; n < 16; n++)
+  {
+    term *= -x * x / ((2 * n - 1) * (2 * n));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr std::array<BirdShape, TILT_COUNT> make_bird_shapes()
+{
+  const double pi = 3.14159265358979323846;
+  const double scale = static_cast<double>(BIRD_SCALE);
+  const double half_width = BIRD_WIDTH * 0.5 * scale;
+  const double half_height = BIRD_HEIGHT * 0.5 * scale;
+
+  std::array<BirdShape, TILT_COUNT> shapes = {};
+  for (int i = 0; i < TILT_COUNT; i++)
+  {
+    const double radians = (i - TILT_STEPS) * TILT_DEGREES_PER_STEP * pi / 180;
+    const double s = tilt_sine(radians);
+    const double c = tilt_cosine(radians);
+
+    // GRRLIB_DrawImg's placement with the default (centered) handle, as
+    // SoftRenderer::DrawImage mirrors it
+    const double center_x = half_width * c - half_height * s;
+    const double center_y = half_height * c - half_width * s;
+    const double abs_s = s < 0 ? -s : s;
+    const double abs_c = c < 0 ? -c : c;
+    const double extent_x = half_width * abs_c + half_height * abs_s;
+    const double extent_y = half_width * abs_s + half_height * abs_c;
+
+    BirdShape& shape = shapes[i];
+    shape.center_x = Scalar(center_x);
+    shape.center_y = Scalar(center_y);
+    shape.rotation.sin = Scalar(s);
+    shape.rotation.cos = Scalar(c);
+    shape.left = Scalar(center_x - extent_x);
+    shape.top = Scalar(center_y - extent_y);
+    shape.right = Scalar(center_x + extent_x);
+    shape.bottom = Scalar(center_y + extent_y);
+  }
+  return shapes;
+}
+
+inline constexpr std::array<BirdShape, TILT_COUNT> BIRD_SHAPES = make_bird_shapes();
+
+// Widest horizontal reach of the bird over every tilt
+constexpr Scalar bird_reach_left()
+{
+  Scalar left = BIRD_SHAPES[0].left;
+  for (const BirdShape& shape : BIRD_SHAPES)
+  {
+    left = shape.left < left ? shape.left : left;
+  }
+  return left;
+}
+
+constexpr Scalar bird_reach_right()
+{
+  Scalar right = BIRD_SHAPES[0].right;
+  for (const BirdShape& shape : BIRD_SHAPES)
+  {
+    right = shape.right > right ? shape.right : right;
+  }
+  return right;
+}
+
+// Tilt index of a bird moving with `velocity` (per tick)
+constexpr int bird_tilt(Scalar velocity)
+{
+  static_assert(TILT_STEPS_PER_VELOCITY == 2, "bird_tilt doubles by adding");
+
+  const int steps = to_pixel(velocity + velocity);
+  return steps < -TILT_STEPS ? -TILT_STEPS : (steps > TILT_STEPS ? TILT_STEPS : steps);
+}
+
+constexpr const BirdShape& bird_shape(int tilt)
+{
+  return BIRD_SHAPES[tilt + TILT_STEPS];
+}
+
+// The tilted sprite's outline for a bird at `position`
+inline OrientedBox bird_box(Vec2 position, int tilt)
+{
+  const BirdShape& shape = bird_shape(tilt);
+  OrientedBox box;
+  box.center.x = position.x + shape.center_x;
+  box.center.y = position.y + shape.center_y;
+  box.half_width = Scalar(BIRD_WIDTH * BIRD_SCALE / 2);
+  box.half_height = Scalar(BIRD_HEIGHT * BIRD_SCALE / 2);
+  box.rotation = shape.rotation;
+  return box;
+}
+
+// EOF
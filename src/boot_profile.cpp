@@ -0,0 +1,101 @@
+// src/boot_profile.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Project headers
+#include "boot_profile.hpp"
+#include "platform.hpp"
+#include "text_format.hpp"
+
+static const char* const PHASE_NAMES[] = {
+  "Video", "Textures", "Fonts", "Input", "Storage", "Sounds", "Masks", "Game",
+  "First frame"
+};
+
+static_assert(sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]) == BootProfile::PHASES,
+              "BootPhase changed; update PHASE_NAMES");
+
+// Width of the name column
+static const u32 NAME_COLUMN = 12;
+
+// Tenths of a millisecond, rounded
+static u32 to_tenths_ms(u64 micros)
+{
+  return static_cast<u32>((micros + 50) / 100);
+}
+
+BootProfile::BootProfile(u64 origin)
+  : origin(origin)
+{
+}
+
+void BootProfile::begin(BootPhase phase)
+{
+  spans[static_cast<int>(phase)].start = GetTimeMicros();
+}
+
+void BootProfile::end(BootPhase phase)
+{
+  spans[static_cast<int>(phase)].end = GetTimeMicros();
+}
+
+u32 BootProfile::total() const
+{
+  u64 last = origin;
+  for (const Span& span : spans)
+  {
+    if (span.end > last)
+    {
+      last = span.end;
+    }
+  }
+  return static_cast<u32>(last - origin);
+}
+
+bool BootProfile::format_line(int line, char* text, u32 capacity) const
+{
+  if (line < 0 || line > PHASES)
+  {
+    return false;
+  }
+  TextWriter writer(text, capacity);
+  if (line == PHASES)
+  {
+    writer.put("Total").pad_to(NAME_COLUMN).put_tenths(to_tenths_ms(total())).put(" ms");
+    return true;
+  }
+
+  const Span& span = spans[line];
+  if (span.end == 0)
+  {
+    return false;
+  }
+  writer.put(PHASE_NAMES[line]).pad_to(NAME_COLUMN)
+    .put_tenths(to_tenths_ms(span.end - span.start)).put(" ms  (at ")
+    .put_tenths(to_tenths_ms(span.start - origin)).put(" ms)");
+  return true;
+}
+
+u32 BootProfile::format(const char* heading, char* text, u32 capacity) const
+{
+  TextWriter writer(text, capacity);
+  writer.put(heading).put('\n');
+  for (int line = 0; line <= PHASES; line++)
+  {
+    char buffer[64];
+    if (format_line(line, buffer, sizeof(buffer)))
+    {
+      writer.put(buffer).put('\n');
+    }
+  }
+  return writer.length();
+}
+
+// EOF
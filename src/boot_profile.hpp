@@ -0,0 +1,66 @@
+// src/boot_profile.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include "types.hpp"
+
+// The steps from launch to the first interactive frame, in report order
+enum class BootPhase
+{
+  Video,       // Video system and GX (GRRLIB_Init)
+  Textures,    // bird.png and pipe.png
+  Fonts,       // Both TrueType faces
+  Input,       // WPAD_Init
+  Storage,     // FAT mount
+  Sounds,      // Sound effect headers
+  Masks,       // Collision masks
+  Game,        // GameState: audio voices, save data, replay headers
+  FirstFrame,  // From the end of startup to the first frame shown
+  Count
+};
+
+// Start and end time of each boot phase, relative to one origin (the top
+// of main). A phase is timed by the thread that runs it and only read once
+// that thread has been joined, so nothing needs a lock. Phases that never
+// ran are left out of the report.
+class BootProfile
+{
+public:
+  static const int PHASES = static_cast<int>(BootPhase::Count);
+
+  explicit BootProfile(u64 origin);
+
+  void begin(BootPhase phase);
+  void end(BootPhase phase);
+
+  // Microseconds from the origin to the end of the last phase
+  u32 total() const;
+
+  // One report line, e.g. "Fonts       41.2 ms  (at 12.0 ms)"; false if the
+  // phase never ran. The line after the last phase is the total.
+  bool format_line(int line, char* text, u32 capacity) const;
+
+  // All lines under `heading`, newline terminated; returns the length
+  u32 format(const char* heading, char* text, u32 capacity) const;
+
+private:
+  struct Span
+  {
+    u64 start = 0;
+    u64 end = 0;
+  };
+
+  u64 origin;
+  Span spans[PHASES];
+};
+
+// EOF
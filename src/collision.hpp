@@ -11,33 +11,36 @@
 
 #pragma once
 
+#include "scalar.hpp"
+#include "vec2.hpp"
+
 struct Hitbox
 {
-  float x;      // Left edge
-  float y;      // Top edge
-  float width;
-  float height;
+  Scalar x;      // Left edge
+  Scalar y;      // Top edge
+  Scalar width;
+  Scalar height;
 
   // Constructor
-  Hitbox(float x = 0, float y = 0, float width = 0, float height = 0)
+  Hitbox(Scalar x = 0, Scalar y = 0, Scalar width = 0, Scalar height = 0)
     : x(x), y(y), width(width), height(height)
   {
   }
 
   // Getters for edges (makes collision logic clearer)
-  float left() const
+  Scalar left() const
   {
     return x;
   }
-  float right() const
+  Scalar right() const
   {
     return x + width;
   }
-  float top() const
+  Scalar top() const
   {
     return y;
   }
-  float bottom() const
+  Scalar bottom() const
   {
     return y + height;
   }
@@ -52,7 +55,7 @@ struct Hitbox
   }
 
   // Check if this hitbox is outside screen bounds
-  bool is_out_of_bounds(float screen_width, float screen_height) const
+  bool is_out_of_bounds(Scalar screen_width, Scalar screen_height) const
   {
     return (top() < 0 ||
             bottom() > screen_height ||
@@ -61,4 +64,74 @@ struct Hitbox
   }
 };
 
+// Sine and cosine of an angle; positive angles turn clockwise on screen
+struct Rotation
+{
+  Scalar sin;
+  Scalar cos;
+};
+
+// Rectangle turned about its center. Its width runs along (cos, sin) and
+// its height along (-sin, cos).
+struct OrientedBox
+{
+  Vec2 center;
+  Scalar half_width;
+  Scalar half_height;
+  Rotation rotation;
+
+  // Half the size of the axis-aligned box around it
+  Scalar extent_x() const
+  {
+    return half_width * magnitude(rotation.cos) + half_height * magnitude(rotation.sin);
+  }
+  Scalar extent_y() const
+  {
+    return half_width * magnitude(rotation.sin) + half_height * magnitude(rotation.cos);
+  }
+
+  // Separating-axis test against an axis-aligned box: the two screen axes
+  // and this box's own two. Touching counts, as in Hitbox::intersects.
+  // `sweep_y` moves this box that far down the screen and tests all it
+  // passes over on the way.
+  bool intersects(const Hitbox& box, Scalar sweep_y = 0) const
+  {
+    const Scalar low_y = sweep_y < 0 ? center.y + sweep_y : center.y;
+    const Scalar high_y = sweep_y < 0 ? center.y : center.y + sweep_y;
+
+    // Screen axes: the box around the swept path
+    if (center.x + extent_x() < box.left() || center.x - extent_x() > box.right() ||
+        high_y + extent_y() < box.top() || low_y - extent_y() > box.bottom())
+    {
+      return false;
+    }
+
+    // Own axes
+    return overlaps_on(box, rotation.cos, rotation.sin, half_width, sweep_y) &&
+           overlaps_on(box, -rotation.sin, rotation.cos, half_height, sweep_y);
+  }
+
+private:
+  static Scalar magnitude(Scalar value)
+  {
+    return value < 0 ? -value : value;
+  }
+
+  // Projections onto the unit axis (axis_x, axis_y) overlap
+  bool overlaps_on(const Hitbox& box, Scalar axis_x, Scalar axis_y, Scalar half,
+                   Scalar sweep_y) const
+  {
+    const Scalar box_min = (axis_x < 0 ? box.right() : box.left()) * axis_x +
+                           (axis_y < 0 ? box.bottom() : box.top()) * axis_y;
+    const Scalar box_max = (axis_x < 0 ? box.left() : box.right()) * axis_x +
+                           (axis_y < 0 ? box.top() : box.bottom()) * axis_y;
+
+    const Scalar start = center.x * axis_x + center.y * axis_y;
+    const Scalar end = start + sweep_y * axis_y;
+    const Scalar low = start < end ? start : end;
+    const Scalar high = start < end ? end : start;
+    return !(high + half < box_min || low - half > box_max);
+  }
+};
+
 // EOF
@@ -15,17 +15,34 @@
 const int SCREEN_WIDTH = 640;
 const int SCREEN_HEIGHT = 480;
 
+// Simulation clock. The game logic runs at a fixed tick rate independent of
+// the video mode (50 Hz PAL, 60 Hz NTSC). Speeds and accelerations below are
+// tuned per 60 Hz frame and scaled to the tick rate, so a higher rate only
+// tightens input response. Override with -DFLAPWII_TICK_RATE=<hz>.
+#ifndef FLAPWII_TICK_RATE
+#define FLAPWII_TICK_RATE 60
+#endif
+const int SIM_TICK_RATE = FLAPWII_TICK_RATE;
+constexpr float SIM_FRAME_SCALE = 60.0f / SIM_TICK_RATE;  // 60 Hz frames per tick
+const int SIM_MAX_TICKS_PER_FRAME = SIM_TICK_RATE / 10;  // Catch up <= 100 ms
+
 // Bird constants
 const int BIRD_WIDTH = 144;
 const int BIRD_HEIGHT = 100;
-const float BIRD_SCALE = 0.3f;
+constexpr float BIRD_SCALE = 0.3f;
 const float BIRD_START_X = SCREEN_WIDTH / 3.0f;
 const float BIRD_START_Y = SCREEN_HEIGHT / 3.0f;
+constexpr float BIRD_TILT_PER_VELOCITY = 1.3f;  // Degrees per 60 Hz unit of velocity
 
 // Pipe constants
 const int PIPE_WIDTH = 52;
 const int PIPE_GAP = 100;
-const float PIPE_SPEED = 1.0f;
+const float PIPE_SPEED = 1.0f * SIM_FRAME_SCALE;
+
+// Gap heights (Pipe::y, top of the bottom pipe) are drawn uniformly from
+// PIPE_Y_COUNT whole-pixel values starting at PIPE_Y_MIN
+const int PIPE_Y_MIN = 1 + SCREEN_HEIGHT / 4;
+const int PIPE_Y_COUNT = SCREEN_HEIGHT / 2;
 
 // Ground constants - using fractions for resolution independence
 const float GROUND_HEIGHT_RATIO = 0.16f;  // ~1/6 of screen (similar to original)
@@ -40,10 +57,27 @@ const unsigned int GROUND_GRASS_COLOR = 0x5AC54FFF;    // Bright grass green
 const unsigned int GROUND_DARK_GRASS = 0x4A9E3FFF;     // Darker grass shade
 const unsigned int GROUND_OUTLINE = 0x000000FF;        // Black outline
 
+// Attract mode: an autopilot demo starts after the menu sits idle this long
+const int ATTRACT_IDLE_TICKS = 10 * SIM_TICK_RATE;
+
+// Practice mode: how far back holding B can rewind a run
+const int REWIND_SECONDS = 30;
+
 // Wiimote constants
 const int WSP_POINTER_CORRECTION_Y = 200;
 const double WIIMOTE_SENSITIVITY = 0.7;
 
+// Save data
+const char* const SAVE_PATH = "/apps/flapwii/game.sav";
+const char* const REPLAY_LAST_PATH = "/apps/flapwii/last.rpl";
+const char* const REPLAY_BEST_PATH = "/apps/flapwii/best.rpl";
+const char* const TELEMETRY_PATH = "/apps/flapwii/telemetry.bin";
+const char* const BOOT_LOG_PATH = "/apps/flapwii/boot.log";
+
+// How long the boot phase times stay on the title screen (any button
+// clears them sooner)
+const int BOOT_REPORT_SECONDS = 5;
+
 // Colors
 const unsigned int GRRLIB_BLACK = 0x000000FF;
 const unsigned int GRRLIB_WHITE = 0xFFFFFFFF;
@@ -0,0 +1,41 @@
+// src/cpu_opponent.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Generated by tools/neuro_train.cpp; do not edit by hand.
+// Trainer seed 1, 8 generations, population 256, 16 pipe seeds
+// per genome, 60 Hz ticks. Mean survival 18000 ticks, mean score 51.0.
+
+#pragma once
+
+#include "flap_policy.hpp"
+
+// Weights for the on-console CPU opponent (see FlapPolicy)
+const float CPU_OPPONENT_WEIGHTS[] = {
+  0x1.7b81a6p-1f, 0x1.8b732p-4f, -0x1.1cdd3cp-1f, -0x1.cf2a0ap-2f,
+  0x1.d98f74p+0f, -0x1.34b68p+0f, -0x1.17401ap+0f, 0x1.5b3992p-1f,
+  0x1.6702c8p+0f, 0x1.dd97e4p-1f, 0x1.09d5b8p+0f, -0x1.86b3bcp-2f,
+  -0x1.58bc3ep+0f, -0x1.04ee4ep-1f, 0x1.f7683ep-4f, -0x1.f88998p-5f,
+  -0x1.cffc68p-1f, 0x1.0cd74p-6f, -0x1.2deea2p-3f, -0x1.2437a4p+0f,
+  -0x1.9b1e1p+0f, -0x1.c7932p-3f, 0x1.202938p-2f, 0x1.1495b2p+0f,
+  0x1.0afef4p+1f, -0x1.25934cp+1f, -0x1.a1b23p-2f, 0x1.0ef1b4p+1f,
+  0x1.48fa9cp+0f, -0x1.2e61e8p+0f, 0x1.2aa35ep-2f, -0x1.12ba7ap+1f,
+  0x1.3ea114p+0f, 0x1.8af29cp+0f, 0x1.e755c6p-2f, -0x1.47bd08p+0f,
+  0x1.27f87p-2f, 0x1.4cb7a2p-1f, -0x1.1b72e6p+1f, 0x1.3b8d84p-2f,
+  -0x1.d70f02p-4f, 0x1.3f6276p-2f, 0x1.d7a068p-1f, -0x1.33087ap+0f,
+  -0x1.6f90fap+0f, -0x1.aed60cp-1f, -0x1.359e5cp-1f, 0x1.a1534cp+0f,
+  0x1.e5e67cp-3f,
+};
+
+static_assert(sizeof(CPU_OPPONENT_WEIGHTS) ==
+                POLICY_WEIGHT_COUNT * sizeof(float),
+              "FlapPolicy shape changed; retrain the CPU opponent");
+
+// EOF
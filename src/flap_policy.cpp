@@ -0,0 +1,73 @@
+// src/flap_policy.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#include "flap_policy.hpp"
+#include "constants.hpp"
+#include "physics.hpp"
+
+// Softsign: tanh-shaped without calling into libm
+static float squash(float x)
+{
+  return x / (1.0f + (x < 0 ? -x : x));
+}
+
+FlapPolicy::FlapPolicy(const float* weights)
+  : weights(weights)
+{
+}
+
+const Pipe& FlapPolicy::next_pipe(const Pipe& pipe_1, const Pipe& pipe_2)
+{
+  const bool ahead_1 = pipe_1.x + PIPE_WIDTH >= Scalar(BIRD_START_X);
+  const bool ahead_2 = pipe_2.x + PIPE_WIDTH >= Scalar(BIRD_START_X);
+
+  if (ahead_1 && ahead_2)
+  {
+    return pipe_1.x <= pipe_2.x ? pipe_1 : pipe_2;
+  }
+  return ahead_2 ? pipe_2 : pipe_1;
+}
+
+void FlapPolicy::features(Scalar bird_y, Scalar velocity, const Pipe& pipe_1,
+                          const Pipe& pipe_2, float* out)
+{
+  const Pipe& next = next_pipe(pipe_1, pipe_2);
+  const float y = to_float(bird_y);
+
+  // Scaled so the values that matter land roughly in [-1, 1]
+  out[0] = (y - SCREEN_HEIGHT / 2) / (SCREEN_HEIGHT / 2);
+  out[1] = to_float(velocity) / -to_float(Physics::flap_height);
+  out[2] = (to_float(next.x) - BIRD_START_X) / (SCREEN_WIDTH / 2);
+  out[3] = (to_float(next.y) - y) / PIPE_GAP;
+}
+
+bool FlapPolicy::decide(const float* features) const
+{
+  const float* w = weights;
+  const float* output = weights + POLICY_HIDDEN * (POLICY_INPUTS + 1);
+
+  float sum = output[POLICY_HIDDEN];
+  for (int h = 0; h < POLICY_HIDDEN; h++)
+  {
+    float activation = w[POLICY_INPUTS];
+    for (int i = 0; i < POLICY_INPUTS; i++)
+    {
+      activation += w[i] * features[i];
+    }
+    w += POLICY_INPUTS + 1;
+
+    sum += output[h] * squash(activation);
+  }
+
+  return sum > 0.0f;
+}
+
+// EOF
@@ -0,0 +1,58 @@
+// src/flap_policy.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include "pipe.hpp"
+#include "types.hpp"
+
+// Network shape: inputs -> one hidden layer -> a single flap output
+const int POLICY_INPUTS = 4;
+const int POLICY_HIDDEN = 8;
+const int POLICY_WEIGHT_COUNT =
+  POLICY_HIDDEN * (POLICY_INPUTS + 1) + POLICY_HIDDEN + 1;
+
+// Small fixed-topology network that decides when a bird flaps. Weights are
+// evolved on the host by tools/neuro_train.cpp and exported as a header
+// (see cpu_opponent.hpp). Uses only adds, multiplies and divides, so the
+// same weights fly the same way on the host and on the console.
+class FlapPolicy
+{
+private:
+  const float* weights;
+
+public:
+  // Weight layout: per hidden unit POLICY_INPUTS weights and a bias, then
+  // POLICY_HIDDEN output weights and the output bias
+  explicit FlapPolicy(const float* weights);
+
+  // The pipe the bird still has to get past: the nearest one whose right
+  // edge is not yet behind the bird's left edge
+  static const Pipe& next_pipe(const Pipe& pipe_1, const Pipe& pipe_2);
+
+  // Normalized inputs from the values Physics::sweep and
+  // Physics::pipe_contact work on: the bird's top edge and velocity, and the
+  // next pipe's distance and gap
+  static void features(Scalar bird_y, Scalar velocity, const Pipe& pipe_1,
+                       const Pipe& pipe_2, float* out);
+
+  bool decide(const float* features) const;
+
+  bool decide(Scalar bird_y, Scalar velocity, const Pipe& pipe_1,
+              const Pipe& pipe_2) const
+  {
+    float in[POLICY_INPUTS];
+    features(bird_y, velocity, pipe_1, pipe_2, in);
+    return decide(in);
+  }
+};
+
+// EOF
@@ -0,0 +1,66 @@
+// src/game_snapshot.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <type_traits>
+#include "constants.hpp"
+#include "physics.hpp"
+#include "pipe.hpp"
+#include "rng.hpp"
+
+// Everything that decides how a run continues, and nothing else: no audio,
+// text or render state. At most 80 bytes (checked below), copied with a
+// single memcpy, so search code can clone the game freely.
+struct GameSnapshot
+{
+  Physics physics;
+  Pipe pipe_1;
+  Pipe pipe_2;
+  Rng rng;
+  float ground_scroll_offset;
+  float world_scroll_x;
+  bool first_round;
+  bool is_dying;
+};
+
+static_assert(std::is_trivially_copyable_v<GameSnapshot>,
+              "GameSnapshot must stay a plain memcpy-able value");
+
+// The autopilot keeps one per search level
+static_assert(sizeof(GameSnapshot) <= 80,
+              "GameSnapshot grew; recheck RewindBuffer's memory budget");
+
+// One tick of ground scrolling, as GameState::update_game applies it
+inline void scroll_ground(float& scroll_offset, float& world_x)
+{
+  // Parallax Grass: Wraps around the pattern width to save logic
+  scroll_offset -= GROUND_SCROLL_SPEED;
+  if (scroll_offset <= -GROUND_PATTERN_WIDTH)
+  {
+    scroll_offset += GROUND_PATTERN_WIDTH;
+  }
+
+  // Procedural Dirt: Continually increases to provide a unique "seed"
+  // for the noise generation, preventing the dirt texture from looping.
+  world_x += GROUND_SCROLL_SPEED;
+}
+
+// One tick of live play on a snapshot, in GameState::update_game order.
+// The cosmetic scroll offsets are not advanced.
+inline void step_snapshot(GameSnapshot& snapshot, bool flap)
+{
+  snapshot.physics.update_bird(flap, snapshot.pipe_1, snapshot.pipe_2);
+  advance_pipes(snapshot.pipe_1, snapshot.pipe_2, snapshot.first_round,
+                snapshot.rng);
+}
+
+// EOF
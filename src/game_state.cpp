@@ -9,25 +9,31 @@
 // the Free Software Foundation, either version 3 of the License, or
 // (at your option) any later version.
 
-// C++ Standard Library
-#include <fstream>
-
-// C Standard Library
-#include <stdio.h>
-
-// System libraries
-#include <fat.h>
-
 // Project headers
 #include "game_state.hpp"
 #include "constants.hpp"
+#include "cpu_opponent.hpp"
+#include "sprite_mask.hpp"
+#include "text_format.hpp"
+
+static const FlapPolicy cpu_opponent(CPU_OPPONENT_WEIGHTS);
 
 // ============================================================================
 // Initialization & Cleanup
 // ============================================================================
 
-GameState::GameState()
-  : first_round(true)
+GameState::GameState(Storage& storage, u32 seed)
+  : rng(seed)
+  , pipe_1(rng)
+  , pipe_2(rng)
+  , storage(storage)
+  , ghost(storage)
+  , racing_ghost(false)
+  , telemetry(storage)
+  , run_seed(0)
+  , run_ticks(0)
+  , run_flaps(0)
+  , first_round(true)
   , is_menu(true)
   , is_dying(false)
   , cursor_x(0)
@@ -37,70 +43,309 @@ GameState::GameState()
   , score(0)
   , highscore(0)
   , last_score(0)
+  , run_mode(RunMode::Player)
+  , run_start_highscore(0)
+  , idle_ticks(0)
+  , shown_score(-1)
+  , shown_highscore(-1)
+  , shown_rival(-1)
+  , shown_racing(false)
 {
   // Initialize Audio System
   audio = std::make_unique<Audio>();
 
-  bird_position.x = BIRD_START_X;
-  bird_position.y = BIRD_START_Y;
+  // Decode the collision masks at load time, not on the first pipe hit
+  collision_masks();
+
+  bird_position.x = Scalar(BIRD_START_X);
+  bird_position.y = Scalar(BIRD_START_Y);
+  previous = capture_render_state();
   load_highscore();
+  load_last_replay();
+  ghost.load();
   update_score_text();
 }
 
 GameState::~GameState()
 {
   save_highscore();
+  telemetry.flush();
 }
 
 // ============================================================================
 // Game Logic Loop
 // ============================================================================
 
-void GameState::update(u32 buttons, const ir_t &ir)
+void GameState::update(const InputState& input)
 {
+  previous = capture_render_state();
+
+  // Keeps the ghost's chunks coming in and telemetry going out, in the
+  // menu as well
+  ghost.poll();
+  telemetry.poll();
+
   if (is_menu)
   {
-    update_menu(buttons, ir);
+    update_menu(input);
+  }
+  else if (run_mode == RunMode::Practice && (input.held & INPUT_BUTTON_B))
+  {
+    update_rewind();
   }
   else if (is_dying)
   {
-    update_death_fall(buttons);
+    update_death_fall(input.buttons);
   }
   else
   {
-    update_game(buttons);
+    update_game(input.buttons);
   }
 }
 
-void GameState::update_menu(u32 buttons, const ir_t &ir)
+void GameState::update_menu(const InputState& input)
 {
   // Map Wiimote pointer to screen coordinates
-  cursor_x = ir.sx * WIIMOTE_SENSITIVITY;
-  cursor_y = (ir.sy - WSP_POINTER_CORRECTION_Y) * WIIMOTE_SENSITIVITY;
+  cursor_x = input.pointer_x * WIIMOTE_SENSITIVITY;
+  cursor_y = (input.pointer_y - WSP_POINTER_CORRECTION_Y) * WIIMOTE_SENSITIVITY;
 
-  if (buttons & WPAD_BUTTON_A)
+  if (input.buttons & INPUT_BUTTON_A)
+  {
+    // Each run draws its own seed so it can be replayed in isolation
+    start_run(rng.next(), RunMode::Player);
+  }
+  else if ((input.buttons & INPUT_BUTTON_B) && !last_replay.empty())
+  {
+    if (player.open(last_replay.data(), last_replay.size()))
+    {
+      start_run(player.get_info().seed, RunMode::Replay);
+    }
+  }
+  else if (input.buttons & INPUT_BUTTON_PLUS)
+  {
+    start_run(rng.next(), RunMode::Practice);
+  }
+  else if ((input.buttons & INPUT_BUTTON_MINUS) && ghost.available())
+  {
+    start_ghost_race();
+  }
+  else if (input.buttons != 0)
+  {
+    idle_ticks = 0;
+  }
+  else if (++idle_ticks >= ATTRACT_IDLE_TICKS)
   {
-    audio->PlayTransition(); // Play transition sound
-    is_menu = false;
+    start_autopilot();
+  }
+}
 
-    // Reset State
-    ground_scroll_offset = 0;
-    world_scroll_x = 0;       // Reset world coordinate seed
-    physics.reset();          // Reset physics for fresh start
+void GameState::start_autopilot()
+{
+  start_run(rng.next(), RunMode::Autopilot);
+}
+
+void GameState::start_game(u32 seed)
+{
+  start_run(seed, RunMode::Player);
+}
+
+void GameState::start_practice(u32 seed)
+{
+  start_run(seed, RunMode::Practice);
+}
 
-    // Reset Bird
-    bird_position.x = BIRD_START_X;
-    bird_position.y = BIRD_START_Y;
+bool GameState::start_ghost_race()
+{
+  if (!ghost.available())
+  {
+    return false;
+  }
+
+  // The ghost only flies its run through the pipes it was recorded in
+  start_run(ghost.get_info().seed, RunMode::Player);
+  racing_ghost = true;
+  ghost.start();
+  previous = capture_render_state();
+  update_score_text();
+  return true;
+}
+
+bool GameState::play_replay(const u8* data, size_t size)
+{
+  last_replay.assign(data, data + size);
+  if (!player.open(last_replay.data(), last_replay.size()))
+  {
+    return false;
+  }
+
+  start_run(player.get_info().seed, RunMode::Replay);
+  return true;
+}
+
+void GameState::start_run(u32 seed, RunMode mode)
+{
+  audio->PlayTransition(); // Play transition sound
+  is_menu = false;
+  run_mode = mode;
+  racing_ghost = false;
+  idle_ticks = 0;
+
+  run_seed = seed;
+  run_ticks = 0;
+  run_flaps = 0;
+  frame_times.clear();
+
+  // Lay out the pipes from the run seed alone
+  rng.reseed(seed);
+  pipe_1.reset(rng);
+  pipe_2.reset(rng);
+  first_round = true;
+
+  // Reset State
+  ground_scroll_offset = 0;
+  world_scroll_x = 0;       // Reset world coordinate seed
+  physics.reset();          // Reset physics for fresh start
+  rival.reset();
+
+  // Reset Bird
+  bird_position.x = Scalar(BIRD_START_X);
+  bird_position.y = Scalar(BIRD_START_Y);
+
+  // Nothing to interpolate from on the first frame
+  previous = capture_render_state();
+
+  if (run_mode == RunMode::Player)
+  {
+    recorder.begin(seed);
+    run_start_highscore = highscore;
+  }
+  else if (run_mode == RunMode::Autopilot)
+  {
+    autopilot.reset();
+  }
+  else if (run_mode == RunMode::Practice)
+  {
+    rewind.clear();
+  }
+}
+
+void GameState::finish_run()
+{
+  log_run();
+
+  if (run_mode != RunMode::Player)
+  {
+    return;
+  }
+
+  const std::vector<u8>& file = recorder.finish(score);
+  last_replay = file;
+  storage.WriteFile(REPLAY_LAST_PATH, file.data(), file.size());
+
+  // A new best is the next ghost, if it made it to the card; otherwise
+  // the old one starts over
+  if (score > run_start_highscore)
+  {
+    storage.WriteFile(REPLAY_BEST_PATH, file.data(), file.size());
+    ghost.load();
+  }
+  else if (racing_ghost)
+  {
+    ghost.rewind();
+  }
+}
+
+// Replays are left out: they repeat a run that was logged already
+void GameState::log_run()
+{
+  RunRecord record;
+  switch (run_mode)
+  {
+    case RunMode::Replay:
+      return;
+    case RunMode::Autopilot:
+      record.mode = static_cast<u8>(TelemetryMode::Autopilot);
+      break;
+    case RunMode::Practice:
+      record.mode = static_cast<u8>(TelemetryMode::Practice);
+      break;
+    default:
+      record.mode = static_cast<u8>(racing_ghost ? TelemetryMode::GhostRace
+                                                 : TelemetryMode::Player);
+      break;
+  }
+
+  record.cause = static_cast<u8>(physics.contact.surface);
+  record.numeric_mode = SIM_NUMERIC_MODE;
+  record.tick_rate = SIM_TICK_RATE;
+  record.score = static_cast<u16>(score < 0xFFFF ? score : 0xFFFF);
+  record.seed = run_seed;
+  record.ticks = run_ticks;
+  record.flaps = run_flaps;
+  record.frames = frame_times.count();
+  record.frame_us[0] = frame_times.percentile(50);
+  record.frame_us[1] = frame_times.percentile(90);
+  record.frame_us[2] = frame_times.percentile(99);
+  record.frame_us[3] = frame_times.longest();
+  telemetry.push(record);
+}
+
+void GameState::record_frame_time(u32 micros)
+{
+  if (!is_menu && !is_dying)
+  {
+    frame_times.add(micros);
   }
 }
 
 void GameState::update_game(u32 buttons)
 {
-  bool did_flap = buttons & WPAD_BUTTON_A;
+  // Any button ends a demo and hands the menu back
+  if (run_mode == RunMode::Autopilot && buttons != 0)
+  {
+    handle_collision();
+    return;
+  }
+
+  bool did_flap;
+  switch (run_mode)
+  {
+    case RunMode::Replay:
+      did_flap = player.next();
+      break;
+    case RunMode::Autopilot:
+      did_flap = autopilot.decide(save_snapshot());
+      break;
+    case RunMode::Practice:
+      did_flap = (buttons & INPUT_BUTTON_A) != 0;
+      rewind.push(save_snapshot(), did_flap);
+      break;
+    default:
+      did_flap = (buttons & INPUT_BUTTON_A) != 0;
+      recorder.record(did_flap);
+      break;
+  }
+
   bird_position = physics.update_bird(did_flap, pipe_1, pipe_2);
 
+  // The rival keeps falling after it dies and simply drops off the screen,
+  // and so does the ghost that takes its place in a race
+  if (racing_ghost)
+  {
+    ghost.physics.update_bird(!ghost.physics.dead && ghost.next(), pipe_1, pipe_2);
+  }
+  else if (has_rival())
+  {
+    bool rival_flap = !rival.dead &&
+                      cpu_opponent.decide(rival.get_y(), rival.velocity,
+                                          pipe_1, pipe_2);
+    rival.update_bird(rival_flap, pipe_1, pipe_2);
+  }
+
+  run_ticks++;
   if (did_flap && !physics.dead)
   {
+    run_flaps++;
     audio->PlayFlap();
   }
 
@@ -116,39 +361,13 @@ void GameState::update_game(u32 buttons)
   // Pipe Management
   // --------------------------------------------------------------------------
 
-  pipe_1.move();
-  if (pipe_1.x < SCREEN_WIDTH / 2 && first_round)
-  {
-    first_round = false;
-  }
-  if (pipe_1.x < -PIPE_WIDTH)
-  {
-    pipe_1.reset();
-  }
-
-  if (!first_round)
-  {
-    pipe_2.move();
-    if (pipe_2.x < -PIPE_WIDTH)
-    {
-      pipe_2.reset();
-    }
-  }
+  advance_pipes(pipe_1, pipe_2, first_round, rng);
 
   // --------------------------------------------------------------------------
   // World Scrolling
   // --------------------------------------------------------------------------
 
-  // Parallax Grass: Wraps around the pattern width to save logic
-  ground_scroll_offset -= GROUND_SCROLL_SPEED;
-  if (ground_scroll_offset <= -GROUND_PATTERN_WIDTH)
-  {
-    ground_scroll_offset += GROUND_PATTERN_WIDTH;
-  }
-
-  // Procedural Dirt: Continually increases to provide a unique "seed"
-  // for the noise generation, preventing the dirt texture from looping.
-  world_scroll_x += GROUND_SCROLL_SPEED;
+  scroll_ground(ground_scroll_offset, world_scroll_x);
 
   // --------------------------------------------------------------------------
   // State Checks
@@ -162,16 +381,23 @@ void GameState::update_game(u32 buttons)
     // Only play the "fall" sound if we are NOT hitting the ground directly.
     // If we hit a pipe or the ceiling, we fall.
     // If we hit the ground, we just stop (no fall sound).
-    if (bird_position.y + (BIRD_HEIGHT * BIRD_SCALE) < GROUND_Y)
+    if (physics.contact.surface != Surface::Ground)
     {
       audio->PlayFall();
     }
 
+    // A practice run can be rewound past its crash and crash again (with
+    // the sounds again, as the player sees it happen), so it is only
+    // logged once it is left, in update_death_fall
     is_dying = true;
+    if (run_mode != RunMode::Practice)
+    {
+      finish_run();
+    }
   }
 
-  // Update highscore
-  if (score > highscore)
+  // Update highscore (replays and demos never change it)
+  if (score > highscore && run_mode == RunMode::Player)
   {
     highscore = score;
   }
@@ -181,11 +407,27 @@ void GameState::update_game(u32 buttons)
 
 void GameState::update_death_fall(u32 buttons)
 {
+  // A practice bird stays on the ground, where B can still rewind it,
+  // until A goes back to the menu
+  if (run_mode == RunMode::Practice)
+  {
+    if (has_landed())
+    {
+      if (buttons & INPUT_BUTTON_A)
+      {
+        finish_run();
+        handle_collision();
+      }
+      return;
+    }
+    rewind.push(save_snapshot(), false);
+  }
+
   // Continue physics simulation but ignore user input
   bird_position = physics.update_bird(false, pipe_1, pipe_2);
 
   // Check if bird hit the ground
-  if (bird_position.y + (BIRD_HEIGHT * BIRD_SCALE) >= GROUND_Y)
+  if (has_landed() && run_mode != RunMode::Practice)
   {
     // Do NOT play sound here.
     // If we fell from a pipe, sfx_fall played earlier.
@@ -194,12 +436,52 @@ void GameState::update_death_fall(u32 buttons)
   }
 }
 
+bool GameState::has_landed() const
+{
+  return bird_position.y + Scalar(BIRD_HEIGHT * BIRD_SCALE) >= GROUND_Y;
+}
+
+// Practice runs have no rival: it could not follow a rewind. Ghost races
+// have the ghost instead.
+bool GameState::has_rival() const
+{
+  return run_mode != RunMode::Practice && !racing_ghost;
+}
+
+// One tick back while B is held in practice. Holding still once the
+// history runs out (or while it catches up on decoding) costs nothing.
+// The run's tick and flap counts follow the timeline back, so the run is
+// logged with what its final timeline played.
+void GameState::update_rewind()
+{
+  GameSnapshot state;
+  bool flap;
+  if (!rewind.step_back(state, flap))
+  {
+    return;
+  }
+
+  // Undo what update_game counted for the tick stepped over; falling
+  // ticks were never counted. The bird still holds that tick's outcome.
+  if (!state.is_dying)
+  {
+    run_ticks--;
+    if (flap && !physics.dead)
+    {
+      run_flaps--;
+    }
+  }
+  restore_snapshot(state);
+}
+
 void GameState::handle_collision()
 {
   first_round = true;
   is_dying = false;
-  pipe_1.reset();
-  pipe_2.reset();
+  run_mode = RunMode::Player;
+  racing_ghost = false;
+  pipe_1.reset(rng);
+  pipe_2.reset(rng);
   score = 0;
   last_score = 0;
   is_menu = true;
@@ -209,36 +491,125 @@ void GameState::handle_collision()
 
 void GameState::update_score_text()
 {
-  sprintf(score_text, "Score: %i", score);
-  sprintf(highscore_text, "Highscore: %i", highscore);
+  if (score != shown_score)
+  {
+    shown_score = score;
+    TextWriter(score_text, sizeof(score_text)).put("Score: ").put(score);
+  }
+  if (highscore != shown_highscore)
+  {
+    shown_highscore = highscore;
+    TextWriter(highscore_text, sizeof(highscore_text)).put("Highscore: ").put(highscore);
+  }
+
+  const int rival_score = racing_ghost ? ghost.physics.score : rival.score;
+  if (rival_score != shown_rival || racing_ghost != shown_racing)
+  {
+    shown_rival = rival_score;
+    shown_racing = racing_ghost;
+    TextWriter(rival_text, sizeof(rival_text))
+      .put(racing_ghost ? "Best: " : "CPU: ")
+      .put(rival_score);
+  }
+}
+
+GameSnapshot GameState::save_snapshot() const
+{
+  return GameSnapshot{
+    physics,
+    pipe_1,
+    pipe_2,
+    rng,
+    ground_scroll_offset,
+    world_scroll_x,
+    first_round,
+    is_dying
+  };
+}
+
+void GameState::restore_snapshot(const GameSnapshot& snapshot)
+{
+  physics = snapshot.physics;
+  pipe_1 = snapshot.pipe_1;
+  pipe_2 = snapshot.pipe_2;
+  rng = snapshot.rng;
+  ground_scroll_offset = snapshot.ground_scroll_offset;
+  world_scroll_x = snapshot.world_scroll_x;
+  first_round = snapshot.first_round;
+  is_dying = snapshot.is_dying;
+
+  // Derived state follows the restored physics
+  bird_position = physics.get_position();
+  score = physics.score;
+  last_score = score;
+  update_score_text();
+
+  // Jumping in time is not something to interpolate across
+  previous = capture_render_state();
+}
+
+GameState::RenderState GameState::capture_render_state() const
+{
+  return RenderState{
+    to_float(bird_position.y),
+    to_float(physics.velocity),
+    to_float(rival.get_y()),
+    to_float(rival.velocity),
+    to_float(ghost.physics.get_y()),
+    to_float(ghost.physics.velocity),
+    to_float(pipe_1.x),
+    to_float(pipe_2.x),
+    ground_scroll_offset,
+    world_scroll_x
+  };
 }
 
 // ============================================================================
 // Rendering
 // ============================================================================
 
-void GameState::render(GRRLIB_texImg* bird_tex, GRRLIB_texImg* pipe_tex,
-                       GRRLIB_ttfFont* font, GRRLIB_ttfFont* title_font)
+static float lerp(float from, float to, float alpha)
+{
+  return from + (to - from) * alpha;
+}
+
+void GameState::render(Renderer& renderer, float alpha)
 {
   if (is_menu)
   {
-    render_menu(bird_tex, title_font);
+    render_menu(renderer);
   }
   else
   {
-    render_game(bird_tex, pipe_tex);
+    render_game(renderer, alpha);
   }
 
   // Draw the ground layer on top of pipes, unless in main menu
   if (!is_menu)
   {
-    render_ground();
+    // The grass offset wraps by one pattern width; unwrap before blending
+    float previous_offset = previous.ground_scroll_offset;
+    if (ground_scroll_offset > previous_offset)
+    {
+      previous_offset += GROUND_PATTERN_WIDTH;
+    }
+
+    // The world position only jumps backwards on reset; snap when it does
+    float world_x = world_scroll_x;
+    if (world_scroll_x >= previous.world_scroll_x)
+    {
+      world_x = lerp(previous.world_scroll_x, world_scroll_x, alpha);
+    }
+
+    render_ground(renderer, lerp(previous_offset, ground_scroll_offset, alpha),
+                  world_x);
   }
 
-  render_score(font);
+  render_score(renderer);
 }
 
-void GameState::render_ground()
+void GameState::render_ground(Renderer& renderer, float scroll_offset,
+                              float world_x)
 {
   // Configuration
   const int outline_height = 2;
@@ -255,7 +626,7 @@ void GameState::render_ground()
   // Layer: Top Outline
   // --------------------------------------------------------------------------
 
-  GRRLIB_Rectangle(0, GROUND_Y - outline_height, SCREEN_WIDTH, outline_height,
+  renderer.Rectangle(0, GROUND_Y - outline_height, SCREEN_WIDTH, outline_height,
                    GROUND_OUTLINE, true);
 
   // --------------------------------------------------------------------------
@@ -264,24 +635,24 @@ void GameState::render_ground()
 
   // Background Fill:
   // We fill the entire grass strip with the darker green color first.
-  GRRLIB_Rectangle(0, GROUND_Y, SCREEN_WIDTH, grass_height,
+  renderer.Rectangle(0, GROUND_Y, SCREEN_WIDTH, grass_height,
                    grass_background_dark, true);
 
   // Chevron Overlay:
   // We draw light green shapes ON TOP of the dark background.
   // This creates the ">>>>>" pattern effect.
-  for (int x = static_cast<int>(ground_scroll_offset);
+  for (int x = static_cast<int>(scroll_offset);
        x < SCREEN_WIDTH + chevron_spacing; x += chevron_spacing)
   {
     // Draw the upper diagonal stroke: /
     for (int i = 0; i < grass_height / 2; i++)
     {
-      GRRLIB_Rectangle(x + i, GROUND_Y + i, chevron_line_width, 1, chevron_color, true);
+      renderer.Rectangle(x + i, GROUND_Y + i, chevron_line_width, 1, chevron_color, true);
     }
     // Draw the lower diagonal stroke: \ (flipped)
     for (int i = 0; i < grass_height / 2; i++)
     {
-      GRRLIB_Rectangle(x + (grass_height / 2 - 1 - i), GROUND_Y + grass_height / 2 + i,
+      renderer.Rectangle(x + (grass_height / 2 - 1 - i), GROUND_Y + grass_height / 2 + i,
                        chevron_line_width, 1, chevron_color, true);
     }
   }
@@ -290,7 +661,7 @@ void GameState::render_ground()
   // Layer: Shadow Divider
   // --------------------------------------------------------------------------
 
-  GRRLIB_Rectangle(0, GROUND_Y + grass_height, SCREEN_WIDTH, shadow_height,
+  renderer.Rectangle(0, GROUND_Y + grass_height, SCREEN_WIDTH, shadow_height,
                    0x4A9E3FFF, true);
 
   // --------------------------------------------------------------------------
@@ -301,14 +672,14 @@ void GameState::render_ground()
   const int dirt_height = SCREEN_HEIGHT - dirt_y;
 
   // Draw solid dirt base
-  GRRLIB_Rectangle(0, dirt_y, SCREEN_WIDTH, dirt_height, GROUND_BASE_COLOR, true);
+  renderer.Rectangle(0, dirt_y, SCREEN_WIDTH, dirt_height, GROUND_BASE_COLOR, true);
 
   // Procedural Noise Generation (Generate noise based on world coordinates)
   const unsigned int color_speck_dark = 0xB0A96CFF;  // Subtly darker brown
   const unsigned int color_speck_light = 0xF5F1BEFF; // Pale Chiffon/Cream
   const unsigned int color_rock = 0xB0A565FF;        // Earthy Metallic Brass
 
-  int scroll_int = static_cast<int>(world_scroll_x);
+  int scroll_int = static_cast<int>(world_x);
 
   // Align to grid: We snap the starting position to a 4-pixel grid in
   // world-space so the hashing remains consistent while scrolling.
@@ -339,18 +710,18 @@ void GameState::render_ground()
       {
         if (val < 15)
         {
-          GRRLIB_Plot(draw_x, draw_y, color_speck_dark);
+          renderer.Plot(draw_x, draw_y, color_speck_dark);
         }
         else if (val < 20)
         {
-          GRRLIB_Plot(draw_x, draw_y, color_speck_light);
+          renderer.Plot(draw_x, draw_y, color_speck_light);
         }
         else if (val == 25)
         {
           // Draw rock (checking bounds to prevent overflow)
           if (draw_x + 1 < SCREEN_WIDTH && draw_y + 1 < SCREEN_HEIGHT)
           {
-            GRRLIB_Rectangle(draw_x, draw_y, 2, 2, color_rock, true);
+            renderer.Rectangle(draw_x, draw_y, 2, 2, color_rock, true);
           }
         }
       }
@@ -358,47 +729,109 @@ void GameState::render_ground()
   }
 }
 
-void GameState::render_menu(GRRLIB_texImg* bird_tex, GRRLIB_ttfFont* title_font)
+void GameState::render_menu(Renderer& renderer)
 {
-  GRRLIB_PrintfTTF(165, 70, title_font, "Flapwii Bird", 96, 0xf6ef29ff);
-  GRRLIB_PrintfTTF(175, 300, title_font, "Press A to flap", 72, 0xf6ef29ff);
-  GRRLIB_DrawImg(cursor_x, cursor_y, bird_tex, 0, 1, 1, GRRLIB_WHITE);
+  renderer.PrintText(165, 70, FontId::Title, "Flapwii Bird", 96, 0xf6ef29ff);
+  renderer.PrintText(175, 300, FontId::Title, "Press A to flap", 72, 0xf6ef29ff);
+  if (!last_replay.empty())
+  {
+    renderer.PrintText(215, 390, FontId::Score, "Press B to watch the last run",
+                       24, 0xf6ef29ff);
+  }
+  renderer.PrintText(232, 420, FontId::Score, "Press + to practice", 24, 0xf6ef29ff);
+  if (ghost.available())
+  {
+    renderer.PrintText(204, 450, FontId::Score, "Press - to race your best", 24,
+                       0xf6ef29ff);
+  }
+  renderer.DrawImage(cursor_x, cursor_y, TextureId::Bird, 0, 1, 1, GRRLIB_WHITE);
 }
 
-void GameState::render_pipe(GRRLIB_texImg* pipe_tex, const Pipe& pipe)
+void GameState::render_pipe(Renderer& renderer, float x, float y)
 {
   // Bottom pipe
-  GRRLIB_DrawImg(pipe.x, pipe.y, pipe_tex, 0, 1, 1, GRRLIB_WHITE);
+  renderer.DrawImage(x, y, TextureId::Pipe, 0, 1, 1, GRRLIB_WHITE);
   // Top pipe (flipped vertically)
-  GRRLIB_DrawImg(pipe.x, pipe.y - PIPE_GAP, pipe_tex, 180, -1, 1, GRRLIB_WHITE);
+  renderer.DrawImage(x, y - PIPE_GAP, TextureId::Pipe, 180, -1, 1, GRRLIB_WHITE);
 }
 
-void GameState::render_bird(GRRLIB_texImg* bird_tex, float x, float y, float rotation)
+void GameState::render_bird(Renderer& renderer, float x, float y, float rotation)
 {
-  GRRLIB_DrawImg(x, y, bird_tex, rotation, BIRD_SCALE, BIRD_SCALE, GRRLIB_WHITE);
+  renderer.DrawImage(x, y, TextureId::Bird, rotation, BIRD_SCALE, BIRD_SCALE, GRRLIB_WHITE);
 }
 
-void GameState::render_score(GRRLIB_ttfFont* font)
+void GameState::render_score(Renderer& renderer)
 {
-  GRRLIB_PrintfTTF(20, 10, font, score_text, 24, 0xf6ef23ff);
-  GRRLIB_PrintfTTF(150, 10, font, highscore_text, 24, 0xf6ef23ff);
+  renderer.PrintText(20, 10, FontId::Score, score_text, 24, 0xf6ef23ff);
+  renderer.PrintText(150, 10, FontId::Score, highscore_text, 24, 0xf6ef23ff);
+  if (in_practice())
+  {
+    renderer.PrintText(340, 10, FontId::Score, "Practice - hold B to rewind", 24,
+                       0xf6ef23ff);
+  }
+  else if (!is_menu)
+  {
+    renderer.PrintText(340, 10, FontId::Score, rival_text, 24, 0xf6ef23ff);
+  }
+  if (in_demo())
+  {
+    renderer.PrintText(480, 10, FontId::Score, "Demo - press A", 24, 0xf6ef23ff);
+  }
 }
 
-void GameState::render_game(GRRLIB_texImg* bird_tex, GRRLIB_texImg* pipe_tex)
+void GameState::render_game(Renderer& renderer, float alpha)
 {
+  // Pipes jump right when they respawn; draw those at their new position
+  const RenderState current = capture_render_state();
+
+  float pipe_1_x = current.pipe_1_x;
+  if (current.pipe_1_x <= previous.pipe_1_x)
+  {
+    pipe_1_x = lerp(previous.pipe_1_x, current.pipe_1_x, alpha);
+  }
+
+  float pipe_2_x = current.pipe_2_x;
+  if (current.pipe_2_x <= previous.pipe_2_x)
+  {
+    pipe_2_x = lerp(previous.pipe_2_x, current.pipe_2_x, alpha);
+  }
+
   // Render first pipe
-  render_pipe(pipe_tex, pipe_1);
+  render_pipe(renderer, pipe_1_x, to_float(pipe_1.y));
 
   // Render second pipe if active
   if (!first_round)
   {
-    render_pipe(pipe_tex, pipe_2);
+    render_pipe(renderer, pipe_2_x, to_float(pipe_2.y));
   }
 
-  // Render bird
-  Vec2 bird_pos = physics.get_position();
-  float bird_rotation = physics.velocity * 1.3f;
-  render_bird(bird_tex, bird_pos.x, bird_pos.y, bird_rotation);
+  // Render the rival behind the player, half transparent
+  float rival_y = lerp(previous.rival_y, current.rival_y, alpha);
+  if (rival_y < SCREEN_HEIGHT && has_rival())
+  {
+    float rival_velocity = lerp(previous.rival_velocity, current.rival_velocity,
+                                alpha);
+    renderer.DrawImage(to_float(rival.get_x()), rival_y, TextureId::Bird,
+                       rival_velocity / SIM_FRAME_SCALE * BIRD_TILT_PER_VELOCITY,
+                       BIRD_SCALE, BIRD_SCALE, 0xFFFFFF80);
+  }
+
+  // The ghost is fainter still
+  float ghost_y = lerp(previous.ghost_y, current.ghost_y, alpha);
+  if (ghost_y < SCREEN_HEIGHT && racing_ghost)
+  {
+    float ghost_velocity = lerp(previous.ghost_velocity, current.ghost_velocity,
+                                alpha);
+    renderer.DrawImage(to_float(ghost.physics.get_x()), ghost_y, TextureId::Bird,
+                       ghost_velocity / SIM_FRAME_SCALE * BIRD_TILT_PER_VELOCITY,
+                       BIRD_SCALE, BIRD_SCALE, 0xFFFFFF50);
+  }
+
+  // Render bird (rotation is tuned against 60 Hz velocities)
+  float bird_y = lerp(previous.bird_y, current.bird_y, alpha);
+  float velocity = lerp(previous.bird_velocity, current.bird_velocity, alpha);
+  float bird_rotation = velocity / SIM_FRAME_SCALE * BIRD_TILT_PER_VELOCITY;
+  render_bird(renderer, to_float(bird_position.x), bird_y, bird_rotation);
 }
 
 // ============================================================================
@@ -407,23 +840,37 @@ void GameState::render_game(GRRLIB_texImg* bird_tex, GRRLIB_texImg* pipe_tex)
 
 void GameState::load_highscore()
 {
-  fatInitDefault();
-  std::ifstream save;
-  save.open("/apps/flapwii/game.sav", std::ifstream::in);
+  char buffer[16];
+  int length = storage.ReadFile(SAVE_PATH, buffer, sizeof(buffer));
+
+  int value;
+  if (length > 0 && parse_int(buffer, static_cast<u32>(length), value))
+  {
+    highscore = value;
+  }
+}
+
+void GameState::load_last_replay()
+{
+  last_replay.resize(REPLAY_MAX_SIZE);
+  int length = storage.ReadFile(REPLAY_LAST_PATH, last_replay.data(),
+                                last_replay.size());
 
-  if (!save.fail())
+  ReplayInfo info;
+  if (length <= 0 || !read_replay_info(last_replay.data(), length, info))
   {
-    save >> highscore;
+    length = 0;
   }
-  save.close();
+  last_replay.resize(length);
+  last_replay.shrink_to_fit();
 }
 
 void GameState::save_highscore()
 {
-  std::ofstream save;
-  save.open("/apps/flapwii/game.sav");
-  save << highscore;
-  save.close();
+  char buffer[16];
+  TextWriter text(buffer, sizeof(buffer));
+  text.put(highscore);
+  storage.WriteFile(SAVE_PATH, buffer, text.length());
 }
 
 // EOF
@@ -14,23 +14,66 @@
 #include "physics.hpp"
 #include "pipe.hpp"
 #include "audio.hpp"
-#include <grrlib.h>
-#include <wiiuse/wpad.h>
+#include "autopilot.hpp"
+#include "game_snapshot.hpp"
+#include "ghost.hpp"
+#include "platform.hpp"
+#include "replay.hpp"
+#include "rewind.hpp"
+#include "rng.hpp"
+#include "telemetry.hpp"
 #include <memory>
+#include <vector>
 
 class GameState
 {
 private:
+  // Per-game generator; must be declared before the pipes it seeds
+  Rng rng;
+
   Pipe pipe_1;
   Pipe pipe_2;
   Physics physics;
 
+  // CPU opponent racing through the same pipes (see cpu_opponent.hpp)
+  Physics rival;
+
   // Audio System
   std::unique_ptr<Audio> audio;
 
+  // Save data backend
+  Storage& storage;
+
+  // Personal best streamed from best.rpl, raced in place of the rival
+  Ghost ghost;
+  bool racing_ghost;
+
+  // Per-run telemetry, appended to the card in the background
+  TelemetryLog telemetry;
+  FrameTimes frame_times;
+  u32 run_seed;
+  u32 run_ticks;
+  u32 run_flaps;
+
   // Cache bird position to avoid running physics in render
   Vec2 bird_position;
 
+  // State at the start of the last tick, for render interpolation
+  struct RenderState
+  {
+    float bird_y;
+    float bird_velocity;
+    float rival_y;
+    float rival_velocity;
+    float ghost_y;
+    float ghost_velocity;
+    float pipe_1_x;
+    float pipe_2_x;
+    float ground_scroll_offset;
+    float world_scroll_x;
+  };
+  RenderState previous;
+
   bool first_round;
   bool is_menu;
   bool is_dying;
@@ -49,30 +92,153 @@ private:
   int highscore;
   int last_score;
 
+  // Who supplies the flaps for the current run
+  enum class RunMode
+  {
+    Player,
+    Replay,    // Stored run played back in place of controller input
+    Autopilot, // Attract-mode demo driven by the lookahead search
+    Practice   // Player run without a rival that B rewinds; never recorded
+  };
+  RunMode run_mode;
+
+  // Replays: every player run is recorded; a stored run can be played back
+  // through the regular update path in place of controller input
+  ReplayRecorder recorder;
+  ReplayPlayer player;
+  std::vector<u8> last_replay;
+  int run_start_highscore;
+
+  // Attract mode: the autopilot takes over after the menu sits idle
+  Autopilot autopilot;
+  int idle_ticks;
+
+  // Practice mode: the ticks holding B can step back through
+  RewindBuffer rewind;
+
   char score_text[32];
   char highscore_text[32];
+  char rival_text[32];
+
+  // What the texts above last showed, so the per-tick refresh only
+  // rewrites them when a number changes (-1 forces the next one)
+  int shown_score;
+  int shown_highscore;
+  int shown_rival;
+  bool shown_racing;
 
   void update_game(u32 buttons);
-  void update_menu(u32 buttons, const ir_t &ir);
+  void update_menu(const InputState& input);
   void update_death_fall(u32 buttons);
+  void update_rewind();
+  bool has_landed() const;
+  bool has_rival() const;
   void handle_collision();
+  void start_run(u32 seed, RunMode mode);
+  void finish_run();
+  void log_run();
+  void load_last_replay();
   void update_score_text();
+  RenderState capture_render_state() const;
 
   // Render helpers
-  void render_menu(GRRLIB_texImg* bird_tex, GRRLIB_ttfFont* title_font);
-  void render_game(GRRLIB_texImg* bird_tex, GRRLIB_texImg* pipe_tex);
-  void render_pipe(GRRLIB_texImg* pipe_tex, const Pipe& pipe);
-  void render_bird(GRRLIB_texImg* bird_tex, float x, float y, float rotation);
-  void render_score(GRRLIB_ttfFont* font);
-  void render_ground();
+  void render_menu(Renderer& renderer);
+  void render_game(Renderer& renderer, float alpha);
+  void render_pipe(Renderer& renderer, float x, float y);
+  void render_bird(Renderer& renderer, float x, float y, float rotation);
+  void render_score(Renderer& renderer);
 
 public:
-  GameState();
+  GameState(Storage& storage, u32 seed);
   ~GameState();
 
-  void update(u32 buttons, const ir_t &ir);
-  void render(GRRLIB_texImg* bird_tex, GRRLIB_texImg* pipe_tex,
-              GRRLIB_ttfFont* font, GRRLIB_ttfFont* title_font);
+  GameState(GameState const&) = delete;
+  GameState& operator=(GameState const&) = delete;
+
+  // Advance the simulation by one fixed tick (see SimClock)
+  void update(const InputState& input);
+
+  // Draw the state alpha of the way from the previous tick to the current
+  void render(Renderer& renderer, float alpha = 1.0f);
+
+  // Time since the previous frame, for the run's telemetry
+  void record_frame_time(u32 micros);
+
+  // Ground strip drawn over the pipes during play. It depends only on the
+  // scroll position, so the benchmarks can time it on its own.
+  static void render_ground(Renderer& renderer, float scroll_offset,
+                            float world_x);
+
+  // Start playing back an encoded replay (see replay.hpp) right away.
+  // The data is copied. Returns false if it cannot be parsed.
+  bool play_replay(const u8* data, size_t size);
+
+  // Start an autopilot demo run right away, as attract mode does
+  void start_autopilot();
+
+  // Start a player run on the given seed right away (host tools)
+  void start_game(u32 seed);
+
+  // Start a practice run on the given seed right away (host tools)
+  void start_practice(u32 seed);
+
+  // Start a player run against the ghost of the best run, on that run's
+  // seed. Returns false if there is no usable best.rpl.
+  bool start_ghost_race();
+
+  // Copy out / restore everything that decides how the run continues.
+  // Audio, menu and replay state are left alone.
+  GameSnapshot save_snapshot() const;
+  void restore_snapshot(const GameSnapshot& snapshot);
+
+  bool in_menu() const
+  {
+    return is_menu;
+  }
+  bool in_demo() const
+  {
+    return !is_menu && run_mode == RunMode::Autopilot;
+  }
+  bool in_practice() const
+  {
+    return !is_menu && run_mode == RunMode::Practice;
+  }
+  bool in_ghost_race() const
+  {
+    return !is_menu && racing_ghost;
+  }
+
+  const Ghost& get_ghost() const
+  {
+    return ghost;
+  }
+
+  const TelemetryLog& get_telemetry() const
+  {
+    return telemetry;
+  }
+
+  // Whether holding B would step the run back
+  bool can_rewind() const
+  {
+    return in_practice() && !rewind.empty();
+  }
+  int get_score() const
+  {
+    return score;
+  }
+
+  // Ticks simulated by autopilot searches so far
+  u64 get_autopilot_nodes() const
+  {
+    return autopilot.get_total_nodes();
+  }
+
+  // Encoded replay of the most recent run (empty if there is none)
+  const std::vector<u8>& get_last_replay() const
+  {
+    return last_replay;
+  }
 
   void load_highscore();
   void save_highscore();
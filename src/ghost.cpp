@@ -0,0 +1,256 @@
+// src/ghost.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Project headers
+#include "ghost.hpp"
+#include "constants.hpp"
+
+Ghost::Ghost(Storage& storage)
+  : storage(storage)
+{
+  chunk_bytes[0] = -1;
+  chunk_bytes[1] = -1;
+}
+
+void Ghost::load()
+{
+  u8 head[REPLAY_HEADER_MAX];
+  const int length = storage.ReadFile(REPLAY_BEST_PATH, head, sizeof(head));
+
+  // Like ReplayPlayer, only a run from a matching build reproduces
+  size_t offset = 0;
+  has_run = length > 0 && read_replay_info(head, length, info, &offset) &&
+            info.tick_rate == SIM_TICK_RATE && info.numeric_mode == SIM_NUMERIC_MODE;
+  stream_offset = static_cast<u32>(offset);
+  bytes_streamed = 0;
+  rewind();
+}
+
+void Ghost::start()
+{
+  physics.reset();
+  if (!fresh)
+  {
+    rewind();
+  }
+  underruns = 0;
+}
+
+void Ghost::rewind()
+{
+  current = 0;
+  pos = 0;
+  chunk_bytes[0] = -1;
+  chunk_bytes[1] = -1;
+  next_offset = stream_offset;
+  file_end = false;
+  fresh = true;
+
+  flaps_left = has_run ? info.flaps : 0;
+  gap = 0;
+  has_gap = false;
+  partial = 0;
+  shift = 0;
+  owed = 0;
+
+  // A read still in flight lands in a chunk that is now empty again
+  discard = reading >= 0;
+  poll();
+}
+
+void Ghost::poll()
+{
+  if (reading >= 0)
+  {
+    const int result = storage.PollRead();
+    if (result == IO_PENDING)
+    {
+      return;
+    }
+
+    if (!discard)
+    {
+      chunk_bytes[reading] = result > 0 ? result : 0;
+      file_end = result < CHUNK_SIZE;
+      bytes_streamed += chunk_bytes[reading];
+    }
+    discard = false;
+    reading = -1;
+  }
+
+  if (!has_run || file_end)
+  {
+    return;
+  }
+
+  // Fill the chunk being decoded first, then the one after it
+  const int target = chunk_bytes[current] < 0 ? current : 1 - current;
+  if (chunk_bytes[target] < 0 &&
+      storage.ReadFileAsync(REPLAY_BEST_PATH, next_offset, chunks[target], CHUNK_SIZE))
+  {
+    reading = target;
+    next_offset += CHUNK_SIZE;
+  }
+}
+
+bool Ghost::next()
+{
+  poll();
+  fresh = false;
+
+  // Catch up on the ticks flown while the stream was late
+  while (owed > 0 && advance() >= 0)
+  {
+    owed--;
+  }
+
+  const int input = owed == 0 ? advance() : -1;
+  if (input < 0)
+  {
+    underruns++;
+    owed++;
+    return false;
+  }
+  return input == 1;
+}
+
+// The stream's input for one tick: 1 for a flap, 0 for none, or -1 if its
+// bytes are not in yet
+int Ghost::advance()
+{
+  if (!has_gap)
+  {
+    if (flaps_left == 0)
+    {
+      return 0;  // No flaps left: coast until the bird dies
+    }
+    if (!read_gap())
+    {
+      if (flaps_left == 0 || at_end())
+      {
+        flaps_left = 0;  // Cut short or damaged: coast as well
+        return 0;
+      }
+      return -1;
+    }
+    has_gap = true;
+    flaps_left--;
+  }
+
+  if (gap == 0)
+  {
+    has_gap = false;
+    return 1;
+  }
+
+  gap--;
+  return 0;
+}
+
+bool Ghost::ready() const
+{
+  if ((has_gap && gap >= owed) || flaps_left == 0)
+  {
+    return true;
+  }
+
+  // The rest of the next varint must be in the chunks already
+  int chunk = current;
+  int at = pos;
+  for (int hop = 0; hop < 2; hop++)
+  {
+    if (chunk_bytes[chunk] < 0)
+    {
+      return false;
+    }
+    for (; at < chunk_bytes[chunk]; at++)
+    {
+      if (!(chunks[chunk][at] & 0x80))
+      {
+        return true;
+      }
+    }
+    if (chunk_bytes[chunk] < CHUNK_SIZE)
+    {
+      return true;  // The file ends here; next() coasts
+    }
+    chunk = 1 - chunk;
+    at = 0;
+  }
+  return true;
+}
+
+// LEB128 one byte at a time, so a gap can straddle two chunks
+bool Ghost::read_gap()
+{
+  u8 byte;
+  while (read_byte(byte))
+  {
+    partial |= static_cast<u32>(byte & 0x7F) << shift;
+    shift += 7;
+    if (!(byte & 0x80))
+    {
+      gap = partial;
+      partial = 0;
+      shift = 0;
+      return true;
+    }
+    if (shift >= 35)
+    {
+      flaps_left = 0;  // Not a varint: the file is damaged
+      return false;
+    }
+  }
+  return false;
+}
+
+bool Ghost::read_byte(u8& byte)
+{
+  if (chunk_bytes[current] < 0)
+  {
+    return false;
+  }
+
+  if (pos == chunk_bytes[current])
+  {
+    // A full chunk is followed by another, maybe still on its way
+    const int other = 1 - current;
+    if (chunk_bytes[current] < CHUNK_SIZE || chunk_bytes[other] < 0)
+    {
+      return false;
+    }
+
+    // Hand the used chunk back to poll() for the read after the next
+    chunk_bytes[current] = -1;
+    current = other;
+    pos = 0;
+    poll();
+    if (chunk_bytes[current] == 0)
+    {
+      return false;
+    }
+  }
+
+  byte = chunks[current][pos++];
+  return true;
+}
+
+// Whether the stream ran out, as opposed to its next chunk being late
+bool Ghost::at_end() const
+{
+  if (chunk_bytes[current] < 0 || pos < chunk_bytes[current])
+  {
+    return false;
+  }
+  return chunk_bytes[current] < CHUNK_SIZE;
+}
+
+// EOF
@@ -0,0 +1,116 @@
+// src/ghost.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include "physics.hpp"
+#include "platform.hpp"
+#include "replay.hpp"
+#include "types.hpp"
+
+// The personal best, flying again next to the player. The flaps are
+// decoded straight from best.rpl as the run goes, through two chunks of
+// CHUNK_SIZE bytes: one is decoded while Storage::ReadFileAsync fills the
+// other, so the file is never held whole and no tick waits on the card.
+// A chunk lasts for hundreds of flaps, so the next one is in long before
+// it is needed. Should it be late anyway, the ghost flies on without a
+// flap rather than wait, and the tick is counted (see get_underruns). Once
+// the bytes are in, the stream skips the ticks it owes, so the flaps after
+// them keep their timing; only a flap due during the wait is lost.
+//
+// The ghost has its own Physics and is stepped against the live pipes,
+// so it only follows its run on the seed that run was recorded with.
+class Ghost
+{
+public:
+  static const int CHUNK_SIZE = 256;
+
+  Physics physics;
+
+  explicit Ghost(Storage& storage);
+
+  // Read the header of best.rpl (a few bytes, blocking) and start
+  // fetching the first chunks. Without a usable file the ghost is
+  // unavailable. Call again whenever the file is rewritten.
+  void load();
+
+  bool available() const
+  {
+    return has_run;
+  }
+
+  const ReplayInfo& get_info() const
+  {
+    return info;
+  }
+
+  // Reset the bird and, unless it is still there, the stream
+  void start();
+
+  // Go back to the start of the stream once the run is over
+  void rewind();
+
+  // Move background reads along; cheap, call every tick
+  void poll();
+
+  // Input for the next tick. Never blocks.
+  bool next();
+
+  // Whether next() can decode its input without waiting for a read (the
+  // host test paces itself on this; the game never waits)
+  bool ready() const;
+
+  // Ticks whose input had not been read in time
+  u32 get_underruns() const
+  {
+    return underruns;
+  }
+
+  // Bytes of stream read from the file so far
+  u32 get_bytes_streamed() const
+  {
+    return bytes_streamed;
+  }
+
+private:
+  Storage& storage;
+  ReplayInfo info;
+  bool has_run = false;
+  u32 stream_offset = 0;
+
+  u8 chunks[2][CHUNK_SIZE];
+  int chunk_bytes[2];    // Bytes held by each chunk; -1 while empty
+  int current = 0;       // Chunk being decoded
+  int pos = 0;           // Next byte in the current chunk
+  int reading = -1;      // Chunk a read is filling, or -1
+  bool discard = false;  // The read in flight is from before a rewind
+  u32 next_offset = 0;   // File offset of the next chunk to fetch
+  bool file_end = false; // A short read reached the end of the file
+  bool fresh = false;    // Nothing decoded since the last rewind
+
+  // Decoder state, kept across chunk boundaries
+  u32 flaps_left = 0;
+  u32 gap = 0;
+  bool has_gap = false;
+  u32 partial = 0;
+  int shift = 0;
+  u32 owed = 0;          // Ticks flown before their input was read
+
+  u32 underruns = 0;
+  u32 bytes_streamed = 0;
+
+  int advance();
+  bool read_byte(u8& byte);
+  bool at_end() const;
+  bool read_gap();
+};
+
+// EOF
@@ -0,0 +1,157 @@
+// src/host/env_shm.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C Standard Library
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Project headers
+#include "env_shm.hpp"
+#include "flapwii_env.h"
+
+static u64 align_up(u64 value)
+{
+  return (value + 63) & ~u64(63);
+}
+
+EnvShm::~EnvShm()
+{
+  if (!base)
+  {
+    return;
+  }
+
+  if (owner)
+  {
+    sem_destroy(&header().request);
+    sem_destroy(&header().response);
+    shm_unlink(name);
+  }
+  munmap(base, size);
+}
+
+bool EnvShm::create(const char* segment, u32 count, u32 seed)
+{
+  snprintf(name, sizeof(name), "%s", segment);
+
+  EnvShmHeader layout = {};
+  layout.magic = ENV_SHM_MAGIC;
+  layout.abi_version = FLAPWII_ENV_ABI_VERSION;
+  layout.count = count;
+  layout.obs_size = FLAPWII_ENV_OBS_SIZE;
+  layout.seed = seed;
+  layout.actions_offset = align_up(sizeof(EnvShmHeader));
+  layout.mask_offset = align_up(layout.actions_offset + count);
+  layout.observations_offset = align_up(layout.mask_offset + count);
+  layout.rewards_offset = align_up(layout.observations_offset +
+                                   u64(count) * FLAPWII_ENV_OBS_SIZE * sizeof(float));
+  layout.dones_offset = align_up(layout.rewards_offset + u64(count) * sizeof(float));
+  layout.total_size = align_up(layout.dones_offset + count);
+
+  shm_unlink(name);
+  int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  size = layout.total_size;
+  if (ftruncate(fd, size) != 0)
+  {
+    close(fd);
+    shm_unlink(name);
+    return false;
+  }
+
+  void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+  {
+    shm_unlink(name);
+    return false;
+  }
+
+  base = static_cast<u8*>(mapped);
+  owner = true;
+  header() = layout;
+  sem_init(&header().request, 1, 0);
+  sem_init(&header().response, 1, 0);
+  return true;
+}
+
+bool EnvShm::open(const char* segment)
+{
+  snprintf(name, sizeof(name), "%s", segment);
+
+  int fd = shm_open(name, O_RDWR, 0);
+  if (fd < 0)
+  {
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 ||
+      static_cast<size_t>(info.st_size) < sizeof(EnvShmHeader))
+  {
+    close(fd);
+    return false;
+  }
+
+  size = info.st_size;
+  void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+  {
+    return false;
+  }
+  base = static_cast<u8*>(mapped);
+
+  const EnvShmHeader& layout = header();
+  return layout.magic == ENV_SHM_MAGIC &&
+         layout.abi_version == FLAPWII_ENV_ABI_VERSION &&
+         layout.obs_size == FLAPWII_ENV_OBS_SIZE &&
+         layout.total_size == size;
+}
+
+bool EnvShm::call(EnvCommand command, int timeout_ms)
+{
+  header().command = command;
+  sem_post(&header().request);
+
+  timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+  deadline.tv_sec += timeout_ms / 1000;
+  deadline.tv_nsec += (timeout_ms % 1000) * 1000000L;
+  if (deadline.tv_nsec >= 1000000000L)
+  {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000L;
+  }
+
+  while (sem_timedwait(&header().response, &deadline) != 0)
+  {
+    if (errno != EINTR)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// EOF
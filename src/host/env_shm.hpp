@@ -0,0 +1,110 @@
+// src/host/env_shm.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <semaphore.h>
+#include <stddef.h>
+#include "types.hpp"
+
+// Shared-memory transport for the training environment (flapwii_env.h).
+// A server process owns the environments and binds their output buffers
+// directly inside a POSIX shared memory segment; a client on the same
+// machine writes actions into the segment, posts a command and waits for
+// the reply, then reads observations, rewards and done flags in place.
+//
+// Segment layout: EnvShmHeader, then the actions, reset mask,
+// observations, rewards and dones arrays, each 64-byte aligned.
+
+const u32 ENV_SHM_MAGIC = 0x56455746;  // "FWEV"
+const char* const ENV_SHM_DEFAULT_NAME = "/flapwii_env";
+
+enum class EnvCommand : u32
+{
+  Step,
+  Reset,  // Uses the reset mask
+  Close
+};
+
+struct EnvShmHeader
+{
+  u32 magic;
+  u32 abi_version;
+  u32 count;
+  u32 obs_size;
+  u32 seed;
+  EnvCommand command;
+
+  // Client posts request after filling in command; server posts response
+  sem_t request;
+  sem_t response;
+
+  u64 actions_offset;
+  u64 mask_offset;
+  u64 observations_offset;
+  u64 rewards_offset;
+  u64 dones_offset;
+  u64 total_size;
+};
+
+class EnvShm
+{
+private:
+  char name[64];
+  u8* base = nullptr;
+  size_t size = 0;
+  bool owner = false;
+
+public:
+  EnvShm() = default;
+  ~EnvShm();
+
+  EnvShm(EnvShm const&) = delete;
+  EnvShm& operator=(EnvShm const&) = delete;
+
+  // Server side: create (replacing any stale segment of the same name)
+  bool create(const char* name, u32 count, u32 seed);
+
+  // Client side: map an existing segment
+  bool open(const char* name);
+
+  EnvShmHeader& header() const
+  {
+    return *reinterpret_cast<EnvShmHeader*>(base);
+  }
+
+  u8* actions() const
+  {
+    return base + header().actions_offset;
+  }
+  u8* mask() const
+  {
+    return base + header().mask_offset;
+  }
+  float* observations() const
+  {
+    return reinterpret_cast<float*>(base + header().observations_offset);
+  }
+  float* rewards() const
+  {
+    return reinterpret_cast<float*>(base + header().rewards_offset);
+  }
+  u8* dones() const
+  {
+    return base + header().dones_offset;
+  }
+
+  // Client: run one command on the server. False if the server did not
+  // answer within timeout_ms.
+  bool call(EnvCommand command, int timeout_ms = 5000);
+};
+
+// EOF
@@ -0,0 +1,188 @@
+// src/host/flapwii_env.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C++ Standard Library
+#include <new>
+#include <vector>
+
+// C Standard Library
+#include <stddef.h>
+
+// Project headers
+#include "flapwii_env.h"
+#include "flap_policy.hpp"
+#include "game_snapshot.hpp"
+
+static_assert(FLAPWII_ENV_OBS_SIZE == POLICY_INPUTS,
+              "Observations are the FlapPolicy features");
+
+struct FlapwiiEnv
+{
+  std::vector<GameSnapshot> games;
+
+  // Caller-owned outputs (see flapwii_env_bind)
+  float* observations = nullptr;
+  float* rewards = nullptr;
+  u8* dones = nullptr;
+};
+
+// GameState::start_run with a seed drawn from the game's generator
+static void start_run(GameSnapshot& game)
+{
+  game.rng.reseed(game.rng.next());
+  game.pipe_1.reset(game.rng);
+  game.pipe_2.reset(game.rng);
+  game.first_round = true;
+  game.is_dying = false;
+  game.ground_scroll_offset = 0;
+  game.world_scroll_x = 0;
+  game.physics.reset();
+}
+
+// The game's death-to-next-run path with A pressed at once on the menu:
+// handle_collision lays out new pipes from the generator, then a new run
+// starts
+static void restart(GameSnapshot& game)
+{
+  game.pipe_1.reset(game.rng);
+  game.pipe_2.reset(game.rng);
+  start_run(game);
+}
+
+static void observe(const GameSnapshot& game, float* out)
+{
+  FlapPolicy::features(game.physics.get_y(), game.physics.velocity,
+                       game.pipe_1, game.pipe_2, out);
+}
+
+uint32_t flapwii_env_abi_version(void)
+{
+  return FLAPWII_ENV_ABI_VERSION;
+}
+
+FlapwiiEnv* flapwii_env_create(uint32_t n_envs, uint32_t seed)
+{
+  if (n_envs == 0)
+  {
+    return nullptr;
+  }
+
+  FlapwiiEnv* env = new (std::nothrow) FlapwiiEnv;
+  if (!env)
+  {
+    return nullptr;
+  }
+
+  try
+  {
+    env->games.resize(n_envs);
+  }
+  catch (const std::bad_alloc&)
+  {
+    delete env;
+    return nullptr;
+  }
+
+  // Each environment starts like a freshly constructed GameState with its
+  // own seed; the first run begins straight away
+  Rng seeds(seed);
+  for (GameSnapshot& game : env->games)
+  {
+    game.rng.reseed(seeds.next());
+    game.pipe_1 = Pipe(game.rng);
+    game.pipe_2 = Pipe(game.rng);
+    start_run(game);
+  }
+
+  return env;
+}
+
+void flapwii_env_destroy(FlapwiiEnv* env)
+{
+  delete env;
+}
+
+uint32_t flapwii_env_count(const FlapwiiEnv* env)
+{
+  return static_cast<uint32_t>(env->games.size());
+}
+
+int flapwii_env_bind(FlapwiiEnv* env, float* observations, float* rewards,
+                     uint8_t* dones)
+{
+  if (!observations || !rewards || !dones)
+  {
+    return -1;
+  }
+
+  env->observations = observations;
+  env->rewards = rewards;
+  env->dones = dones;
+
+  for (size_t i = 0; i < env->games.size(); i++)
+  {
+    observe(env->games[i], observations + i * FLAPWII_ENV_OBS_SIZE);
+    rewards[i] = 0.0f;
+    dones[i] = 0;
+  }
+  return 0;
+}
+
+void flapwii_env_step(FlapwiiEnv* env, const uint8_t* actions)
+{
+  if (!env->observations)
+  {
+    return;
+  }
+
+  const size_t count = env->games.size();
+  for (size_t i = 0; i < count; i++)
+  {
+    GameSnapshot& game = env->games[i];
+    const int score = game.physics.score;
+
+    step_snapshot(game, actions[i] != 0);
+
+    float reward = static_cast<float>(game.physics.score - score);
+    const bool done = game.physics.dead;
+    if (done)
+    {
+      reward -= 1.0f;
+      restart(game);
+    }
+
+    env->rewards[i] = reward;
+    env->dones[i] = done;
+    observe(game, env->observations + i * FLAPWII_ENV_OBS_SIZE);
+  }
+}
+
+void flapwii_env_reset(FlapwiiEnv* env, const uint8_t* mask)
+{
+  const size_t count = env->games.size();
+  for (size_t i = 0; i < count; i++)
+  {
+    if (mask && !mask[i])
+    {
+      continue;
+    }
+
+    restart(env->games[i]);
+    if (env->observations)
+    {
+      env->rewards[i] = 0.0f;
+      env->dones[i] = 0;
+      observe(env->games[i], env->observations + i * FLAPWII_ENV_OBS_SIZE);
+    }
+  }
+}
+
+// EOF
@@ -0,0 +1,80 @@
+// src/host/flapwii_env.h
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Vectorized training environment, exported from build_host/libflapwii_env.so
+// as a plain C ABI (usable from C, ctypes, cffi, ...).
+//
+// Each environment is one independent game with its own pipe seed. A single
+// flapwii_env_step() call advances every environment by one tick and writes
+// the results straight into buffers owned by the caller, so no memory is
+// allocated or copied per step. An environment that dies is restarted
+// immediately with a fresh seed, as the game does when it returns to the
+// menu and a new run begins. The observation written for that step is the
+// first one of the new run.
+//
+// Buffers (all contiguous, n_envs entries per row):
+//   observations  float[n_envs * FLAPWII_ENV_OBS_SIZE]
+//     bird height, velocity, distance to the next pipe, gap height relative
+//     to the bird; all scaled to roughly [-1, 1] (see FlapPolicy::features)
+//   rewards       float[n_envs]  +1 per pipe cleared, -1 on death
+//   dones         uint8_t[n_envs] 1 if the environment died this step
+//
+// Functions are not thread-safe for the same handle.
+
+#ifndef FLAPWII_ENV_H
+#define FLAPWII_ENV_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLAPWII_ENV_ABI_VERSION 1
+#define FLAPWII_ENV_OBS_SIZE 4
+
+#if defined(__GNUC__)
+#define FLAPWII_ENV_API __attribute__((visibility("default")))
+#else
+#define FLAPWII_ENV_API
+#endif
+
+typedef struct FlapwiiEnv FlapwiiEnv;
+
+// Returns FLAPWII_ENV_ABI_VERSION of the library actually loaded
+FLAPWII_ENV_API uint32_t flapwii_env_abi_version(void);
+
+// NULL if n_envs is 0 or memory runs out. Same seed, same episodes.
+FLAPWII_ENV_API FlapwiiEnv* flapwii_env_create(uint32_t n_envs, uint32_t seed);
+FLAPWII_ENV_API void flapwii_env_destroy(FlapwiiEnv* env);
+
+FLAPWII_ENV_API uint32_t flapwii_env_count(const FlapwiiEnv* env);
+
+// Attach the output buffers and write the current observations into them.
+// The buffers must stay valid until they are replaced or env is destroyed.
+// Returns 0 on success, -1 if any pointer is NULL.
+FLAPWII_ENV_API int flapwii_env_bind(FlapwiiEnv* env, float* observations,
+                                     float* rewards, uint8_t* dones);
+
+// Advance every environment by one tick. actions[i] != 0 flaps bird i.
+FLAPWII_ENV_API void flapwii_env_step(FlapwiiEnv* env, const uint8_t* actions);
+
+// Restart the environments whose mask entry is non-zero (all of them if
+// mask is NULL), clearing their reward and done entries.
+FLAPWII_ENV_API void flapwii_env_reset(FlapwiiEnv* env, const uint8_t* mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // FLAPWII_ENV_H
+
+// EOF
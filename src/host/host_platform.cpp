@@ -0,0 +1,293 @@
+// src/host/host_platform.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C++ Standard Library
+#include <chrono>
+
+// C Standard Library
+#include <stdio.h>
+#include <string.h>
+
+// Project headers
+#include "host_platform.hpp"
+
+// ============================================================================
+// NullRenderer
+// ============================================================================
+
+void NullRenderer::FillScreen(u32)
+{
+}
+
+void NullRenderer::Rectangle(f32, f32, f32, f32, u32, bool)
+{
+}
+
+void NullRenderer::Plot(f32, f32, u32)
+{
+}
+
+void NullRenderer::DrawImage(f32, f32, TextureId, f32, f32, f32, u32)
+{
+}
+
+void NullRenderer::PrintText(int, int, FontId, const char*, u32, u32)
+{
+}
+
+void NullRenderer::Present()
+{
+}
+
+// ============================================================================
+// ScriptedInput
+// ============================================================================
+
+ScriptedInput::ScriptedInput(std::string script)
+  : script(std::move(script))
+{
+}
+
+InputState ScriptedInput::Poll()
+{
+  InputState state;
+  if (script.empty())
+  {
+    return state;
+  }
+
+  switch (script[frame])
+  {
+    case 'A': state.buttons = INPUT_BUTTON_A; break;
+    case 'B': state.buttons = INPUT_BUTTON_B; break;
+    case '+': state.buttons = INPUT_BUTTON_PLUS; break;
+    case 'H': state.buttons = INPUT_BUTTON_HOME; break;
+    default: break;
+  }
+  state.held = state.buttons;
+
+  frame = (frame + 1) % script.size();
+  return state;
+}
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+u64 GetTimeMicros()
+{
+  auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+void SleepMicros(u32 micros)
+{
+  std::this_thread::sleep_for(std::chrono::microseconds(micros));
+}
+
+// ============================================================================
+// HostStorage
+// ============================================================================
+
+HostStorage::HostStorage(std::string root)
+  : root(std::move(root))
+{
+}
+
+HostStorage::~HostStorage()
+{
+  if (worker.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> hold(lock);
+      stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+  }
+}
+
+int HostStorage::ReadFile(const char* path, void* buffer, u32 capacity)
+{
+  if (root.empty())
+  {
+    return -1;
+  }
+
+  FILE* file = fopen((root + path).c_str(), "rb");
+  if (!file)
+  {
+    return -1;
+  }
+
+  size_t read = fread(buffer, 1, capacity, file);
+  fclose(file);
+  return static_cast<int>(read);
+}
+
+bool HostStorage::WriteFile(const char* path, const void* data, u32 size)
+{
+  if (root.empty())
+  {
+    return true;
+  }
+
+  // The file may be the one being read
+  {
+    std::unique_lock<std::mutex> hold(lock);
+    done.wait(hold, [this] { return !read.busy; });
+  }
+
+  FILE* file = fopen((root + path).c_str(), "wb");
+  if (!file)
+  {
+    return false;
+  }
+
+  bool ok = fwrite(data, 1, size, file) == size;
+  return fclose(file) == 0 && ok;
+}
+
+bool HostStorage::AppendFile(const char* path, const void* data, u32 size)
+{
+  if (root.empty())
+  {
+    return true;
+  }
+
+  // Keep the order of anything still being appended
+  {
+    std::unique_lock<std::mutex> hold(lock);
+    done.wait(hold, [this] { return !append.busy; });
+  }
+
+  FILE* file = fopen((root + path).c_str(), "ab");
+  if (!file)
+  {
+    return false;
+  }
+
+  bool ok = fwrite(data, 1, size, file) == size;
+  return fclose(file) == 0 && ok;
+}
+
+bool HostStorage::ReadFileAsync(const char* path, u32 offset, void* buffer,
+                                u32 size)
+{
+  if (root.empty())
+  {
+    return false;
+  }
+  return start(read, path, offset, buffer, size);
+}
+
+bool HostStorage::AppendFileAsync(const char* path, const void* data, u32 size)
+{
+  // Dropped like any other write, at once
+  if (root.empty())
+  {
+    std::lock_guard<std::mutex> hold(lock);
+    if (append.busy)
+    {
+      return false;
+    }
+    append.result = static_cast<int>(size);
+    return true;
+  }
+  return start(append, path, 0, const_cast<void*>(data), size);
+}
+
+int HostStorage::PollRead()
+{
+  std::lock_guard<std::mutex> hold(lock);
+  return read.busy ? IO_PENDING : read.result;
+}
+
+int HostStorage::PollAppend()
+{
+  std::lock_guard<std::mutex> hold(lock);
+  return append.busy ? IO_PENDING : append.result;
+}
+
+bool HostStorage::start(Request& request, const char* path, u32 offset,
+                        void* buffer, u32 size)
+{
+  if (root.size() + strlen(path) >= sizeof(request.path))
+  {
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> hold(lock);
+    if (request.busy)
+    {
+      return false;
+    }
+    snprintf(request.path, sizeof(request.path), "%s%s", root.c_str(), path);
+    request.offset = offset;
+    request.buffer = buffer;
+    request.size = size;
+    request.busy = true;
+  }
+
+  if (!worker.joinable())
+  {
+    worker = std::thread(&HostStorage::serve, this);
+  }
+  wake.notify_one();
+  return true;
+}
+
+void HostStorage::serve()
+{
+  std::unique_lock<std::mutex> hold(lock);
+  for (;;)
+  {
+    wake.wait(hold, [this] { return read.busy || append.busy || stopping; });
+
+    // Anything still busy is served first, so no append is cut off at exit
+    if (stopping && !read.busy && !append.busy)
+    {
+      return;
+    }
+
+    // A request stays put while it is busy
+    Request& request = read.busy ? read : append;
+    const bool reading = &request == &read;
+    hold.unlock();
+
+    int result = -1;
+    FILE* file = fopen(request.path, reading ? "rb" : "ab");
+    if (file)
+    {
+      if (!reading)
+      {
+        result = static_cast<int>(fwrite(request.buffer, 1, request.size, file));
+        result = fclose(file) == 0 ? result : -1;
+      }
+      else
+      {
+        if (fseek(file, request.offset, SEEK_SET) == 0)
+        {
+          result = static_cast<int>(fread(request.buffer, 1, request.size, file));
+        }
+        fclose(file);
+      }
+    }
+    hold.lock();
+
+    request.result = result;
+    request.busy = false;
+    done.notify_all();
+  }
+}
+
+// EOF
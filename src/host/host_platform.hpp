@@ -0,0 +1,98 @@
+// src/host/host_platform.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "platform.hpp"
+
+// Discards all drawing; Present() never blocks so the loop runs unthrottled
+class NullRenderer : public Renderer
+{
+public:
+  void FillScreen(u32 color) override;
+  void Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color,
+                 bool filled) override;
+  void Plot(f32 x, f32 y, u32 color) override;
+  void DrawImage(f32 x, f32 y, TextureId texture, f32 degrees,
+                 f32 scale_x, f32 scale_y, u32 color) override;
+  void PrintText(int x, int y, FontId font, const char* text,
+                 u32 size, u32 color) override;
+  void Present() override;
+};
+
+// Replays a looping button script, one character per frame:
+//   'A' = A, 'B' = B, '+' = Plus, 'H' = Home, anything else = no buttons
+// A button counts as held for as long as its character repeats.
+class ScriptedInput : public Input
+{
+private:
+  std::string script;
+  size_t frame = 0;
+
+public:
+  explicit ScriptedInput(std::string script);
+
+  InputState Poll() override;
+};
+
+// Maps console paths onto a directory on the host file system. With an
+// empty root, reads fail and writes are dropped (no disk I/O at all).
+// Background reads and appends run on a worker thread started by the
+// first one.
+class HostStorage : public Storage
+{
+private:
+  std::string root;
+
+  struct Request
+  {
+    char path[256];
+    u32 offset;
+    void* buffer;
+    u32 size;
+    bool busy = false;
+    int result = -1;
+  };
+
+  std::thread worker;
+  std::mutex lock;
+  std::condition_variable wake;  // A request arrived, or stopping
+  std::condition_variable done;  // A request finished
+  Request read;
+  Request append;
+  bool stopping = false;
+
+  bool start(Request& request, const char* path, u32 offset, void* buffer,
+             u32 size);
+  void serve();
+
+public:
+  explicit HostStorage(std::string root = "");
+  ~HostStorage() override;
+
+  HostStorage(HostStorage const&) = delete;
+  HostStorage& operator=(HostStorage const&) = delete;
+
+  int ReadFile(const char* path, void* buffer, u32 capacity) override;
+  bool WriteFile(const char* path, const void* data, u32 size) override;
+  bool AppendFile(const char* path, const void* data, u32 size) override;
+  bool ReadFileAsync(const char* path, u32 offset, void* buffer,
+                     u32 size) override;
+  bool AppendFileAsync(const char* path, const void* data, u32 size) override;
+  int PollRead() override;
+  int PollAppend() override;
+};
+
+// EOF
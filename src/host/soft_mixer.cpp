@@ -0,0 +1,459 @@
+// src/host/soft_mixer.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C++ Standard Library
+#include <algorithm>
+#include <cmath>
+
+// C Standard Library
+#include <string.h>
+
+// SIMD intrinsics (host builds only)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Project headers
+#include "soft_mixer.hpp"
+
+// ============================================================================
+// Sinks
+// ============================================================================
+
+static void put_u16_le(u8* out, u32 value)
+{
+  out[0] = static_cast<u8>(value);
+  out[1] = static_cast<u8>(value >> 8);
+}
+
+static void put_u32_le(u8* out, u32 value)
+{
+  put_u16_le(out, value);
+  put_u16_le(out + 2, value >> 16);
+}
+
+static const u32 WAV_HEADER_SIZE = 44;
+
+// Canonical 44-byte header for `frames` of 16-bit stereo
+static void wav_header(u8* out, u32 frames)
+{
+  const u32 data_size = frames * 4;
+  memcpy(out, "RIFF", 4);
+  put_u32_le(out + 4, 36 + data_size);
+  memcpy(out + 8, "WAVEfmt ", 8);
+  put_u32_le(out + 16, 16);
+  put_u16_le(out + 20, 1);  // PCM
+  put_u16_le(out + 22, 2);
+  put_u32_le(out + 24, SoftMixer::OUTPUT_RATE);
+  put_u32_le(out + 28, SoftMixer::OUTPUT_RATE * 4);
+  put_u16_le(out + 32, 4);
+  put_u16_le(out + 34, 16);
+  memcpy(out + 36, "data", 4);
+  put_u32_le(out + 40, data_size);
+}
+
+WavSink::WavSink(const char* path)
+  : file(fopen(path, "wb"))
+{
+  u8 header[WAV_HEADER_SIZE];
+  wav_header(header, 0);
+  if (file && fwrite(header, 1, sizeof(header), file) != sizeof(header))
+  {
+    fclose(file);
+    file = nullptr;
+  }
+}
+
+WavSink::~WavSink()
+{
+  if (!file)
+  {
+    return;
+  }
+  u8 header[WAV_HEADER_SIZE];
+  wav_header(header, frames_written);
+  fseek(file, 0, SEEK_SET);
+  fwrite(header, 1, sizeof(header), file);
+  fclose(file);
+}
+
+void WavSink::write(const s16* samples, u32 frames)
+{
+  if (!file)
+  {
+    return;
+  }
+
+  u8 bytes[4 * SoftMixer::BLOCK_FRAMES];
+  while (frames > 0)
+  {
+    const u32 count = std::min(frames, SoftMixer::BLOCK_FRAMES);
+    for (u32 i = 0; i < 2 * count; i++)
+    {
+      put_u16_le(bytes + 2 * i, static_cast<u16>(samples[i]));
+    }
+    fwrite(bytes, 4, count, file);
+    frames_written += count;
+    samples += 2 * count;
+    frames -= count;
+  }
+}
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+// Fraction of a 32.32 position, to 24 bits: what the SIMD kernel can
+// convert exactly, so both kernels interpolate at the same points
+static inline f32 fraction_of(u64 position)
+{
+  return static_cast<f32>(static_cast<u32>(position) >> 8) * (1.0f / 16777216.0f);
+}
+
+static inline f32 linear(const f32* data, s32 index, f32 t)
+{
+  const f32 y1 = data[index];
+  const f32 y2 = data[index + 1];
+  return y1 + (y2 - y1) * t;
+}
+
+// Catmull-Rom spline through the samples either side of the two neighbours
+static inline f32 cubic(const f32* data, s32 index, f32 t)
+{
+  const f32 y0 = data[index - 1];
+  const f32 y1 = data[index];
+  const f32 y2 = data[index + 1];
+  const f32 y3 = data[index + 2];
+  return y1 + 0.5f * t * (y2 - y0 + t * (2.0f * y0 - 5.0f * y1 + 4.0f * y2 - y3 +
+                                          t * (3.0f * (y1 - y2) + y3 - y0)));
+}
+
+// Reference kernel, also handles the frames the SIMD kernel leaves over.
+// `left` and `right` point at a sound's first frame (the same array for
+// mono); every frame read must lie inside the sound or its padding.
+static void mix_scalar(const f32* left, const f32* right, u64 position, u64 step,
+                       Resampling mode, f32 gain_l, f32 gain_r, f32* out_l,
+                       f32* out_r, u32 count)
+{
+  for (u32 i = 0; i < count; i++, position += step)
+  {
+    const s32 index = static_cast<s32>(position >> 32);
+    const f32 t = fraction_of(position);
+    f32 l, r;
+    if (mode == Resampling::Cubic)
+    {
+      l = cubic(left, index, t);
+      r = left == right ? l : cubic(right, index, t);
+    }
+    else
+    {
+      l = linear(left, index, t);
+      r = left == right ? l : linear(right, index, t);
+    }
+    out_l[i] += l * gain_l;
+    out_r[i] += r * gain_r;
+  }
+}
+
+#if defined(__AVX2__)
+
+static inline __m256 resample_avx2(const f32* data, __m256i index, __m256 t,
+                                   Resampling mode)
+{
+  const __m256 y1 = _mm256_i32gather_ps(data, index, 4);
+  const __m256 y2 = _mm256_i32gather_ps(data + 1, index, 4);
+  if (mode == Resampling::Linear)
+  {
+    return _mm256_add_ps(y1, _mm256_mul_ps(_mm256_sub_ps(y2, y1), t));
+  }
+
+  const __m256 y0 = _mm256_i32gather_ps(data - 1, index, 4);
+  const __m256 y3 = _mm256_i32gather_ps(data + 2, index, 4);
+  __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(3.0f), _mm256_sub_ps(y1, y2)),
+                           _mm256_sub_ps(y3, y0));
+  __m256 b = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), y0),
+                                         _mm256_mul_ps(_mm256_set1_ps(4.0f), y2)),
+                           _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(5.0f), y1), y3));
+  b = _mm256_add_ps(b, _mm256_mul_ps(t, c));
+  __m256 a = _mm256_add_ps(_mm256_sub_ps(y2, y0), _mm256_mul_ps(t, b));
+  a = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), t), a);
+  return _mm256_add_ps(y1, a);
+}
+
+// Eight output frames per pass; `count` must be a multiple of 8. Each
+// lane's position is added up in 64 bits, then split into the source index
+// (high half) and fraction (low half) of each lane.
+static void mix_avx2(const f32* left, const f32* right, u64 position, u64 step,
+                     Resampling mode, f32 gain_l, f32 gain_r, f32* out_l, f32* out_r,
+                     u32 count)
+{
+  const __m256i lanes_lo = _mm256_setr_epi64x(0, static_cast<s64>(step),
+                                              static_cast<s64>(2 * step),
+                                              static_cast<s64>(3 * step));
+  const __m256i lanes_hi = _mm256_add_epi64(lanes_lo,
+                                            _mm256_set1_epi64x(static_cast<s64>(4 * step)));
+  const __m256i halves = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+  const __m256 scale = _mm256_set1_ps(1.0f / 16777216.0f);
+  const __m256 gains_l = _mm256_set1_ps(gain_l);
+  const __m256 gains_r = _mm256_set1_ps(gain_r);
+
+  for (u32 i = 0; i < count; i += 8, position += 8 * step)
+  {
+    const __m256i base = _mm256_set1_epi64x(static_cast<s64>(position));
+    const __m256i lo = _mm256_permutevar8x32_epi32(_mm256_add_epi64(base, lanes_lo), halves);
+    const __m256i hi = _mm256_permutevar8x32_epi32(_mm256_add_epi64(base, lanes_hi), halves);
+    const __m256i index = _mm256_permute2x128_si256(lo, hi, 0x31);
+    const __m256i fraction = _mm256_permute2x128_si256(lo, hi, 0x20);
+    const __m256 t = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(fraction, 8)), scale);
+
+    const __m256 l = resample_avx2(left, index, t, mode);
+    const __m256 r = left == right ? l : resample_avx2(right, index, t, mode);
+    _mm256_storeu_ps(out_l + i, _mm256_add_ps(_mm256_loadu_ps(out_l + i),
+                                              _mm256_mul_ps(l, gains_l)));
+    _mm256_storeu_ps(out_r + i, _mm256_add_ps(_mm256_loadu_ps(out_r + i),
+                                              _mm256_mul_ps(r, gains_r)));
+  }
+}
+
+#endif
+
+// ============================================================================
+// Mixer
+// ============================================================================
+
+static f32 decode(const u8* data, u32 format)
+{
+  if (format == SOUND_MONO8 || format == SOUND_STEREO8)
+  {
+    return static_cast<s8>(data[0]) * (1.0f / 128.0f);
+  }
+  return static_cast<s16>((data[0] << 8) | data[1]) * (1.0f / 32768.0f);
+}
+
+const SoftMixer::Samples& SoftMixer::samples_of(const Sound& sound)
+{
+  for (const std::unique_ptr<Samples>& samples : decoded)
+  {
+    if (samples->buffer == sound.GetBufferPtr() && samples->size == sound.GetSize() &&
+        samples->format == sound.GetFormat())
+    {
+      return *samples;
+    }
+  }
+
+  auto samples = std::make_unique<Samples>();
+  samples->buffer = sound.GetBufferPtr();
+  samples->size = sound.GetSize();
+  samples->format = sound.GetFormat();
+
+  const bool stereo = samples->format == SOUND_STEREO8 || samples->format == SOUND_STEREO16;
+  const bool wide = samples->format == SOUND_MONO16 || samples->format == SOUND_STEREO16;
+  const u32 sample_size = wide ? 2 : 1;
+  const u32 frame_size = sample_size * (stereo ? 2 : 1);
+  samples->frames = samples->size / frame_size;
+
+  samples->left.assign(PAD_FRONT + samples->frames + PAD_BACK, 0.0f);
+  if (stereo)
+  {
+    samples->right.assign(samples->left.size(), 0.0f);
+  }
+  for (u32 i = 0; i < samples->frames; i++)
+  {
+    const u8* frame = samples->buffer + i * frame_size;
+    samples->left[PAD_FRONT + i] = decode(frame, samples->format);
+    if (stereo)
+    {
+      samples->right[PAD_FRONT + i] = decode(frame + sample_size, samples->format);
+    }
+  }
+
+  decoded.push_back(std::move(samples));
+  return *decoded.back();
+}
+
+void SoftMixer::add(MixVoice* voice)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  voices.push_back(voice);
+}
+
+void SoftMixer::remove(MixVoice* voice)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  voices.erase(std::remove(voices.begin(), voices.end(), voice), voices.end());
+}
+
+void SoftMixer::start(MixVoice& voice, const Sound& sound, f32 frequency, u32 delay_ms,
+                      bool looped)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  voice.sound = &sound;
+  voice.position = 0;
+  voice.step = static_cast<u64>(std::llround(static_cast<f64>(frequency) / OUTPUT_RATE *
+                                             4294967296.0));
+  voice.delay = delay_ms * (OUTPUT_RATE / 1000);
+  voice.looped = looped;
+  voice.playing = voice.step > 0 && sound.GetSize() > 0;
+}
+
+void SoftMixer::stop(MixVoice& voice)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  voice.playing = false;
+}
+
+void SoftMixer::set_volume(MixVoice& voice, u16 left, u16 right)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  voice.volume_l = left;
+  voice.volume_r = right;
+}
+
+void SoftMixer::set_mute(MixVoice& voice, bool mute)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  voice.muted = mute;
+}
+
+void SoftMixer::set_resampling(Resampling mode)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  resampling = mode;
+}
+
+void SoftMixer::set_simd(bool enable)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  simd = enable;
+}
+
+bool SoftMixer::has_simd()
+{
+#if defined(__AVX2__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void SoftMixer::set_sink(AudioSink* new_sink)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  sink = new_sink;
+}
+
+// Adds `frames` of the voice into the block; a sound that runs out either
+// stops or, looped, starts over (reading zeros across the seam)
+void SoftMixer::mix_voice(MixVoice& voice, u32 frames)
+{
+  u32 done = std::min(voice.delay, frames);
+  voice.delay -= done;
+
+  const Samples& samples = samples_of(*voice.sound);
+  const u64 end = static_cast<u64>(samples.frames) << 32;
+  const f32* left = samples.left.data() + PAD_FRONT;
+  const f32* right = samples.right.empty() ? left : samples.right.data() + PAD_FRONT;
+  const f32 gain_l = voice.muted ? 0.0f : voice.volume_l / 255.0f;
+  const f32 gain_r = voice.muted ? 0.0f : voice.volume_r / 255.0f;
+
+  while (done < frames)
+  {
+    if (voice.position >= end)
+    {
+      if (!voice.looped || end == 0)
+      {
+        voice.playing = false;
+        return;
+      }
+      voice.position %= end;
+    }
+
+    // Output frames until the position passes the last source frame
+    const u64 left_in_sound = (end - voice.position + voice.step - 1) / voice.step;
+    const u32 count = static_cast<u32>(std::min<u64>(frames - done, left_in_sound));
+    u32 vector_count = 0;
+#if defined(__AVX2__)
+    if (simd)
+    {
+      vector_count = count & ~7u;
+      mix_avx2(left, right, voice.position, voice.step, resampling, gain_l, gain_r,
+               mix_l + done, mix_r + done, vector_count);
+    }
+#endif
+    const u64 tail = voice.position + vector_count * voice.step;
+    mix_scalar(left, right, tail, voice.step, resampling, gain_l, gain_r,
+               mix_l + done + vector_count, mix_r + done + vector_count,
+               count - vector_count);
+
+    voice.position += count * voice.step;
+    done += count;
+  }
+}
+
+void SoftMixer::mix_block(u32 frames)
+{
+  std::fill(mix_l, mix_l + frames, 0.0f);
+  std::fill(mix_r, mix_r + frames, 0.0f);
+
+  playing = 0;
+  for (MixVoice* voice : voices)
+  {
+    if (voice->playing)
+    {
+      mix_voice(*voice, frames);
+      playing += voice->playing;
+    }
+  }
+
+  for (u32 i = 0; i < frames; i++)
+  {
+    const f32 l = std::clamp(mix_l[i] * 32768.0f, -32768.0f, 32767.0f);
+    const f32 r = std::clamp(mix_r[i] * 32768.0f, -32768.0f, 32767.0f);
+    output[2 * i] = static_cast<s16>(std::lrint(l));
+    output[2 * i + 1] = static_cast<s16>(std::lrint(r));
+  }
+}
+
+void SoftMixer::render(u32 frames)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  while (frames > 0)
+  {
+    const u32 count = std::min(frames, BLOCK_FRAMES);
+    mix_block(count);
+    if (sink)
+    {
+      sink->write(output, count);
+    }
+    frames_rendered += count;
+    frames -= count;
+  }
+}
+
+u64 SoftMixer::get_frames() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return frames_rendered;
+}
+
+u32 SoftMixer::get_playing() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return playing;
+}
+
+SoftMixer& host_mixer()
+{
+  static SoftMixer mixer;
+  return mixer;
+}
+
+// EOF
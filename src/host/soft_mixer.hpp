@@ -0,0 +1,177 @@
+// src/host/soft_mixer.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <stdio.h>
+#include <vector>
+#include "sound.hpp"
+#include "types.hpp"
+
+// How a voice's samples are read between source frames
+enum class Resampling
+{
+  Linear,  // Two samples per frame
+  Cubic    // Four samples per frame (Catmull-Rom)
+};
+
+// Where mixed audio goes: interleaved 16-bit stereo at SoftMixer::OUTPUT_RATE
+class AudioSink
+{
+public:
+  virtual ~AudioSink() = default;
+
+  virtual void write(const s16* samples, u32 frames) = 0;
+};
+
+// Throws the audio away, for timing the mixer or the game's audio events
+class NullSink : public AudioSink
+{
+public:
+  void write(const s16*, u32) override
+  {
+  }
+};
+
+// A 16-bit stereo WAV file; the sizes in its header are filled in when the
+// sink is destroyed
+class WavSink : public AudioSink
+{
+public:
+  explicit WavSink(const char* path);
+  ~WavSink() override;
+
+  WavSink(WavSink const&) = delete;
+  WavSink& operator=(WavSink const&) = delete;
+
+  bool ok() const
+  {
+    return file != nullptr;
+  }
+
+  void write(const s16* samples, u32 frames) override;
+
+private:
+  FILE* file;
+  u32 frames_written = 0;
+};
+
+// One voice as the mixer plays it (the host's aesndpb_t)
+struct MixVoice
+{
+  const Sound* sound = nullptr;
+  u64 position = 0;  // Source frames played, 32.32 fixed point
+  u64 step = 0;      // Source frames per output frame, 32.32 fixed point
+  u32 delay = 0;     // Output frames left before the voice starts
+  u16 volume_l = 255;
+  u16 volume_r = 255;
+  bool playing = false;
+  bool muted = false;
+  bool looped = false;
+};
+
+// Software stand-in for the console's DSP mixer. Plays every registered
+// voice from its Sound's buffer at the sound's own rate (times the pitch),
+// resampled to OUTPUT_RATE and summed into stereo, then hands the result to
+// a sink in blocks of BLOCK_FRAMES.
+//
+// Sounds are decoded to float once, the first time they are mixed, and
+// kept by their buffer (which outlives every Sound). With AVX2 the
+// resampling runs eight output frames at a time from gathers; the scalar
+// kernels are the reference and handle the frames around a sound's ends. A
+// voice's position is exact fixed point in both, so the two only differ by
+// float rounding.
+//
+// Nothing plays until someone calls render(), and the output clock only
+// moves then, so audio is timed by the frames rendered, not the wall clock.
+// Voices may be added, started and stopped from any thread.
+class SoftMixer
+{
+public:
+  static const u32 OUTPUT_RATE = 48000;
+  static const u32 BLOCK_FRAMES = 256;
+
+  SoftMixer() = default;
+
+  SoftMixer(SoftMixer const&) = delete;
+  SoftMixer& operator=(SoftMixer const&) = delete;
+
+  void add(MixVoice* voice);
+  void remove(MixVoice* voice);
+
+  // Starts `sound` on `voice` at `frequency` Hz, after `delay_ms`
+  void start(MixVoice& voice, const Sound& sound, f32 frequency, u32 delay_ms,
+             bool looped);
+  void stop(MixVoice& voice);
+
+  // Volume (0 to 255 per side) and mute, applied from the next block
+  void set_volume(MixVoice& voice, u16 left, u16 right);
+  void set_mute(MixVoice& voice, bool mute);
+
+  void set_resampling(Resampling mode);
+
+  // False forces the scalar kernels, for comparing them with the SIMD ones
+  void set_simd(bool enable);
+  static bool has_simd();
+
+  // Sink for rendered audio; none (the default) mixes and throws it away
+  void set_sink(AudioSink* sink);
+
+  // Mixes the next `frames` of output and writes them to the sink
+  void render(u32 frames);
+
+  // Output frames rendered so far: the backend's playback clock
+  u64 get_frames() const;
+
+  // Voices playing at the end of the last block
+  u32 get_playing() const;
+
+private:
+  // A sound's samples as floats in [-1, 1), one array per channel (right
+  // stays empty for mono), with PAD_FRONT zeros before and PAD_BACK after
+  // so the kernels can read around both ends
+  struct Samples
+  {
+    const u8* buffer;
+    u32 size;
+    u32 format;
+    u32 frames;
+    std::vector<f32> left;
+    std::vector<f32> right;
+  };
+
+  static const u32 PAD_FRONT = 1;
+  static const u32 PAD_BACK = 3;
+
+  mutable std::mutex mutex;
+  std::vector<MixVoice*> voices;
+  std::vector<std::unique_ptr<Samples>> decoded;
+  Resampling resampling = Resampling::Linear;
+  bool simd = true;
+  AudioSink* sink = nullptr;
+  u64 frames_rendered = 0;
+  u32 playing = 0;
+
+  f32 mix_l[BLOCK_FRAMES];
+  f32 mix_r[BLOCK_FRAMES];
+  s16 output[2 * BLOCK_FRAMES];
+
+  const Samples& samples_of(const Sound& sound);
+  void mix_voice(MixVoice& voice, u32 frames);
+  void mix_block(u32 frames);
+};
+
+// The mixer behind the host Voice backend
+SoftMixer& host_mixer();
+
+// EOF
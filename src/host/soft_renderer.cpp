@@ -0,0 +1,445 @@
+// src/host/soft_renderer.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C++ Standard Library
+#include <algorithm>
+
+// C Standard Library
+#include <math.h>
+#include <stdio.h>
+
+// System libraries
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <png.h>
+
+// Project headers
+#include "soft_renderer.hpp"
+
+// Generated symbols from Makefile (same names as bin2o)
+extern "C" {
+    extern const u8 bird_png[];
+    extern const u8 bird_png_end[];
+
+    extern const u8 pipe_png[];
+    extern const u8 pipe_png_end[];
+
+    extern const u8 font_ttf[];
+    extern const u8 font_ttf_end[];
+
+    extern const u8 flappy_ttf[];
+    extern const u8 flappy_ttf_end[];
+}
+
+static u32 pack_rgba(u32 r, u32 g, u32 b, u32 a)
+{
+  return (r << 24) | (g << 16) | (b << 8) | a;
+}
+
+// x * y / 255, rounded
+static u32 mul255(u32 x, u32 y)
+{
+  return (x * y + 127) / 255;
+}
+
+static bool load_png(const u8* data, size_t size, std::vector<u32>& pixels,
+                     int& width, int& height)
+{
+  png_image image = {};
+  image.version = PNG_IMAGE_VERSION;
+  if (!png_image_begin_read_from_memory(&image, data, size))
+  {
+    return false;
+  }
+
+  image.format = PNG_FORMAT_RGBA;
+  std::vector<u8> bytes(PNG_IMAGE_SIZE(image));
+  if (!png_image_finish_read(&image, nullptr, bytes.data(), 0, nullptr))
+  {
+    return false;
+  }
+
+  width = image.width;
+  height = image.height;
+  pixels.resize(static_cast<size_t>(width) * height);
+  for (size_t i = 0; i < pixels.size(); i++)
+  {
+    const u8* texel = &bytes[i * 4];
+    pixels[i] = pack_rgba(texel[0], texel[1], texel[2], texel[3]);
+  }
+  return true;
+}
+
+static FT_Face load_face(FT_Library library, const u8* data, const u8* end)
+{
+  FT_Face face = nullptr;
+  if (FT_New_Memory_Face(library, data, end - data, 0, &face) != 0)
+  {
+    return nullptr;
+  }
+  return face;
+}
+
+// ============================================================================
+// Initialization & Cleanup
+// ============================================================================
+
+SoftRenderer::SoftRenderer()
+  : framebuffer(WIDTH * HEIGHT, 0x000000FF)
+  , library(nullptr)
+  , score_face(nullptr)
+  , title_face(nullptr)
+  , score_size(0)
+  , title_size(0)
+{
+  if (!load_png(bird_png, bird_png_end - bird_png, bird_tex.pixels,
+                bird_tex.width, bird_tex.height) ||
+      !load_png(pipe_png, pipe_png_end - pipe_png, pipe_tex.pixels,
+                pipe_tex.width, pipe_tex.height))
+  {
+    fprintf(stderr, "SoftRenderer: cannot decode the textures\n");
+  }
+
+  FT_Library ft = nullptr;
+  if (FT_Init_FreeType(&ft) == 0)
+  {
+    library = ft;
+    score_face = load_face(ft, font_ttf, font_ttf_end);
+    title_face = load_face(ft, flappy_ttf, flappy_ttf_end);
+  }
+  if (!score_face || !title_face)
+  {
+    fprintf(stderr, "SoftRenderer: cannot load the fonts\n");
+  }
+}
+
+SoftRenderer::~SoftRenderer()
+{
+  if (score_face)
+  {
+    FT_Done_Face(static_cast<FT_Face>(score_face));
+  }
+  if (title_face)
+  {
+    FT_Done_Face(static_cast<FT_Face>(title_face));
+  }
+  if (library)
+  {
+    FT_Done_FreeType(static_cast<FT_Library>(library));
+  }
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+// Source-over blend of one pixel; the screen itself stays opaque
+void SoftRenderer::blend(int x, int y, u32 color)
+{
+  if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT)
+  {
+    return;
+  }
+
+  u32 alpha = color & 0xFF;
+  if (alpha == 0)
+  {
+    return;
+  }
+
+  u32& pixel = framebuffer[y * WIDTH + x];
+  if (alpha == 0xFF)
+  {
+    pixel = color;
+    return;
+  }
+
+  u32 r = mul255(color >> 24, alpha) + mul255(pixel >> 24, 255 - alpha);
+  u32 g = mul255((color >> 16) & 0xFF, alpha) +
+          mul255((pixel >> 16) & 0xFF, 255 - alpha);
+  u32 b = mul255((color >> 8) & 0xFF, alpha) +
+          mul255((pixel >> 8) & 0xFF, 255 - alpha);
+  pixel = pack_rgba(r, g, b, 0xFF);
+}
+
+void SoftRenderer::FillScreen(u32 color)
+{
+  std::fill(framebuffer.begin(), framebuffer.end(), color | 0xFF);
+}
+
+void SoftRenderer::Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color,
+                             bool filled)
+{
+  // Pixels whose centers fall inside [x, x + width) x [y, y + height)
+  int x0 = static_cast<int>(ceilf(x - 0.5f));
+  int y0 = static_cast<int>(ceilf(y - 0.5f));
+  int x1 = static_cast<int>(ceilf(x + width - 0.5f));
+  int y1 = static_cast<int>(ceilf(y + height - 0.5f));
+
+  if (!filled)
+  {
+    // One pixel outline, as GRRLIB's line strip
+    for (int px = x0; px < x1; px++)
+    {
+      blend(px, y0, color);
+      blend(px, y1 - 1, color);
+    }
+    for (int py = y0 + 1; py < y1 - 1; py++)
+    {
+      blend(x0, py, color);
+      blend(x1 - 1, py, color);
+    }
+    return;
+  }
+
+  x0 = x0 < 0 ? 0 : x0;
+  y0 = y0 < 0 ? 0 : y0;
+  x1 = x1 > WIDTH ? WIDTH : x1;
+  y1 = y1 > HEIGHT ? HEIGHT : y1;
+  for (int py = y0; py < y1; py++)
+  {
+    for (int px = x0; px < x1; px++)
+    {
+      blend(px, py, color);
+    }
+  }
+}
+
+void SoftRenderer::Plot(f32 x, f32 y, u32 color)
+{
+  blend(static_cast<int>(floorf(x)), static_cast<int>(floorf(y)), color);
+}
+
+const SoftRenderer::Texture& SoftRenderer::get_texture(TextureId texture) const
+{
+  return texture == TextureId::Bird ? bird_tex : pipe_tex;
+}
+
+void SoftRenderer::DrawImage(f32 x, f32 y, TextureId texture, f32 degrees,
+                             f32 scale_x, f32 scale_y, u32 color)
+{
+  const Texture& tex = get_texture(texture);
+  if (tex.pixels.empty() || scale_x == 0 || scale_y == 0)
+  {
+    return;
+  }
+
+  // GRRLIB_DrawImg with the handle GRRLIB_LoadTexture sets: the quad spans
+  // +-half the texture size, is scaled, rotated, then moved by t
+  const float half_w = tex.width * 0.5f;
+  const float half_h = tex.height * 0.5f;
+  const float handle_x = static_cast<float>(-(tex.width / 2));
+  const float handle_y = static_cast<float>(-(tex.height / 2));
+  const float radians = degrees * static_cast<float>(M_PI) / 180.0f;
+  const float c = cosf(radians);
+  const float s = sinf(radians);
+
+  const float tx = x + half_w + handle_x +
+                   scale_x * (-handle_y * sinf(-radians) - handle_x * cosf(-radians));
+  const float ty = y + half_h + handle_y +
+                   scale_y * (-handle_y * cosf(-radians) - handle_x * sinf(-radians));
+
+  // Screen-space bounding box of the four corners
+  float min_x = tx, max_x = tx, min_y = ty, max_y = ty;
+  for (int corner = 0; corner < 4; corner++)
+  {
+    float lx = (corner & 1 ? half_w : -half_w) * scale_x;
+    float ly = (corner & 2 ? half_h : -half_h) * scale_y;
+    float sx = tx + c * lx - s * ly;
+    float sy = ty + s * lx + c * ly;
+    min_x = fminf(min_x, sx);
+    max_x = fmaxf(max_x, sx);
+    min_y = fminf(min_y, sy);
+    max_y = fmaxf(max_y, sy);
+  }
+
+  int x0 = static_cast<int>(fmaxf(floorf(min_x), 0));
+  int y0 = static_cast<int>(fmaxf(floorf(min_y), 0));
+  int x1 = static_cast<int>(fminf(ceilf(max_x), WIDTH));
+  int y1 = static_cast<int>(fminf(ceilf(max_y), HEIGHT));
+
+  const u32 cr = color >> 24;
+  const u32 cg = (color >> 16) & 0xFF;
+  const u32 cb = (color >> 8) & 0xFF;
+  const u32 ca = color & 0xFF;
+
+  // Map each pixel center back into texture space (nearest texel). The
+  // mapping is affine, so along a row u and v move by a constant step.
+  const float du = c / scale_x;
+  const float dv = -s / scale_y;
+  for (int py = y0; py < y1; py++)
+  {
+    float dx = x0 + 0.5f - tx;
+    float dy = py + 0.5f - ty;
+    const float row_u = (c * dx + s * dy) / scale_x + half_w;
+    const float row_v = (-s * dx + c * dy) / scale_y + half_h;
+    for (int px = x0; px < x1; px++)
+    {
+      float u = row_u + (px - x0) * du;
+      float v = row_v + (px - x0) * dv;
+      if (u < 0 || v < 0 || u >= tex.width || v >= tex.height)
+      {
+        continue;
+      }
+
+      u32 texel = tex.pixels[static_cast<int>(v) * tex.width +
+                             static_cast<int>(u)];
+      blend(px, py, pack_rgba(mul255(texel >> 24, cr),
+                              mul255((texel >> 16) & 0xFF, cg),
+                              mul255((texel >> 8) & 0xFF, cb),
+                              mul255(texel & 0xFF, ca)));
+    }
+  }
+}
+
+// The face for the font, set to the pixel size (GRRLIB falls back to 12)
+void* SoftRenderer::use_face(FontId font, u32 size)
+{
+  FT_Face face = static_cast<FT_Face>(font == FontId::Title ? title_face
+                                                            : score_face);
+  u32& current_size = font == FontId::Title ? title_size : score_size;
+  if (face && current_size != size)
+  {
+    if (FT_Set_Pixel_Sizes(face, 0, size) != 0)
+    {
+      FT_Set_Pixel_Sizes(face, 0, 12);
+    }
+    current_size = size;
+  }
+  return face;
+}
+
+const SoftRenderer::Glyph* SoftRenderer::get_glyph(FontId font, u32 size,
+                                                   u32 index)
+{
+  const u64 key = (static_cast<u64>(font == FontId::Title) << 63) |
+                  (static_cast<u64>(size) << 32) | index;
+  auto cached = glyphs.find(key);
+  if (cached != glyphs.end())
+  {
+    return &cached->second;
+  }
+
+  FT_Face face = static_cast<FT_Face>(use_face(font, size));
+  if (FT_Load_Glyph(face, index, FT_LOAD_RENDER) != 0)
+  {
+    return nullptr;
+  }
+
+  const FT_GlyphSlot slot = face->glyph;
+  const FT_Bitmap& bitmap = slot->bitmap;
+  Glyph& glyph = glyphs[key];
+  glyph.left = slot->bitmap_left;
+  glyph.top = slot->bitmap_top;
+  glyph.advance = slot->advance.x >> 6;
+  glyph.width = bitmap.width;
+  glyph.rows = bitmap.rows;
+  glyph.coverage.resize(static_cast<size_t>(glyph.width) * glyph.rows);
+  for (int row = 0; row < glyph.rows; row++)
+  {
+    for (int column = 0; column < glyph.width; column++)
+    {
+      glyph.coverage[row * glyph.width + column] =
+        bitmap.buffer[row * bitmap.pitch + column];
+    }
+  }
+  return &glyph;
+}
+
+void SoftRenderer::PrintText(int x, int y, FontId font, const char* text,
+                             u32 size, u32 color)
+{
+  FT_Face face = static_cast<FT_Face>(use_face(font, size));
+  if (!face)
+  {
+    return;
+  }
+
+  // Glyphs plot their coverage as alpha; the color's alpha is ignored
+  const u32 rgb = color & 0xFFFFFF00;
+  const bool kerning = FT_HAS_KERNING(face);
+  int pen_x = 0;
+  const int pen_y = static_cast<int>(size);
+  FT_UInt previous = 0;
+
+  for (const char* c = text; *c; c++)
+  {
+    FT_UInt index = FT_Get_Char_Index(face, static_cast<unsigned char>(*c));
+    if (kerning && previous && index)
+    {
+      FT_Vector delta;
+      FT_Get_Kerning(face, previous, index, FT_KERNING_DEFAULT, &delta);
+      pen_x += delta.x >> 6;
+    }
+
+    const Glyph* glyph = get_glyph(font, size, index);
+    if (!glyph)
+    {
+      continue;
+    }
+
+    const int left = x + pen_x + glyph->left;
+    const int top = y + pen_y - glyph->top;
+    for (int row = 0; row < glyph->rows; row++)
+    {
+      for (int column = 0; column < glyph->width; column++)
+      {
+        u8 coverage = glyph->coverage[row * glyph->width + column];
+        if (coverage)
+        {
+          blend(left + column, top + row, rgb | coverage);
+        }
+      }
+    }
+
+    pen_x += glyph->advance;
+    previous = index;
+  }
+}
+
+void SoftRenderer::Present()
+{
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+u64 SoftRenderer::Hash() const
+{
+  u64 hash = 0xCBF29CE484222325ull;
+  for (u32 pixel : framebuffer)
+  {
+    hash = (hash ^ pixel) * 0x100000001B3ull;
+  }
+  return hash;
+}
+
+bool SoftRenderer::SavePng(const char* path) const
+{
+  std::vector<u8> bytes(framebuffer.size() * 4);
+  for (size_t i = 0; i < framebuffer.size(); i++)
+  {
+    bytes[i * 4 + 0] = framebuffer[i] >> 24;
+    bytes[i * 4 + 1] = (framebuffer[i] >> 16) & 0xFF;
+    bytes[i * 4 + 2] = (framebuffer[i] >> 8) & 0xFF;
+    bytes[i * 4 + 3] = framebuffer[i] & 0xFF;
+  }
+
+  png_image image = {};
+  image.version = PNG_IMAGE_VERSION;
+  image.width = WIDTH;
+  image.height = HEIGHT;
+  image.format = PNG_FORMAT_RGBA;
+  return png_image_write_to_file(&image, path, 0, bytes.data(), 0, nullptr) != 0;
+}
+
+// EOF
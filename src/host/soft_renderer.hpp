@@ -0,0 +1,96 @@
+// src/host/soft_renderer.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include "platform.hpp"
+
+// CPU rasterizer covering the GRRLIB calls the game makes. Draws into a
+// 640x480 RGBA framebuffer in memory, following GRRLIB's conventions:
+// DrawImage places and rotates textures the way GRRLIB_DrawImg does with
+// the default handle, texels are modulated by the color, and text is drawn
+// one FreeType glyph bitmap at a time with the coverage as alpha, as in
+// GRRLIB_PrintfTTF. Textures use nearest sampling, so images are close to,
+// not identical with, the console's filtered output.
+class SoftRenderer : public Renderer
+{
+private:
+  struct Texture
+  {
+    int width = 0;
+    int height = 0;
+    std::vector<u32> pixels;  // 0xRRGGBBAA
+  };
+
+  // A rendered glyph; FreeType only rasterizes each (font, size, glyph) once
+  struct Glyph
+  {
+    int left;
+    int top;
+    int advance;
+    int width;
+    int rows;
+    std::vector<u8> coverage;
+  };
+
+  std::vector<u32> framebuffer;  // 0xRRGGBBAA, row major
+  Texture bird_tex;
+  Texture pipe_tex;
+  std::unordered_map<u64, Glyph> glyphs;
+
+  // FreeType handles, kept opaque so users need no FreeType headers
+  void* library;
+  void* score_face;
+  void* title_face;
+  u32 score_size;
+  u32 title_size;
+
+  void blend(int x, int y, u32 color);
+  const Texture& get_texture(TextureId texture) const;
+  void* use_face(FontId font, u32 size);
+  const Glyph* get_glyph(FontId font, u32 size, u32 index);
+
+public:
+  static const int WIDTH = 640;
+  static const int HEIGHT = 480;
+
+  SoftRenderer();
+  ~SoftRenderer() override;
+
+  SoftRenderer(SoftRenderer const&) = delete;
+  SoftRenderer& operator=(SoftRenderer const&) = delete;
+
+  void FillScreen(u32 color) override;
+  void Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color,
+                 bool filled) override;
+  void Plot(f32 x, f32 y, u32 color) override;
+  void DrawImage(f32 x, f32 y, TextureId texture, f32 degrees,
+                 f32 scale_x, f32 scale_y, u32 color) override;
+  void PrintText(int x, int y, FontId font, const char* text,
+                 u32 size, u32 color) override;
+  void Present() override;
+
+  const u32* get_pixels() const
+  {
+    return framebuffer.data();
+  }
+
+  // FNV-1a over the pixel values (one step per pixel); independent of host
+  // byte order
+  u64 Hash() const;
+
+  // Write the framebuffer as an RGBA PNG; returns false on failure
+  bool SavePng(const char* path) const;
+};
+
+// EOF
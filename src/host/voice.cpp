@@ -0,0 +1,73 @@
+// src/host/voice.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#include "voice.hpp"
+#include "soft_mixer.hpp"
+
+// Software audio backend: every voice plays through host_mixer(), which
+// only mixes when a tool renders it (see soft_mixer.hpp). Until then voices
+// keep their state and cost nothing, so game code runs unchanged on hosts
+// without a sound device.
+struct aesndpb_t : MixVoice
+{
+};
+
+void Voice::InitBackend()
+{
+}
+
+void Voice::ShutdownBackend()
+{
+}
+
+u64 Voice::PlaybackMicros()
+{
+  return host_mixer().get_frames() * 1000000 / SoftMixer::OUTPUT_RATE;
+}
+
+Voice::Voice()
+{
+  _Voice = new aesndpb_t;
+  host_mixer().add(_Voice);
+}
+
+Voice::~Voice()
+{
+  host_mixer().remove(_Voice);
+  delete _Voice;
+}
+
+void Voice::SetVolume(u16 Volume)
+{
+  SetVolume(Volume, Volume);
+}
+
+void Voice::SetVolume(u16 LeftVolume, u16 RightVolume)
+{
+  host_mixer().set_volume(*_Voice, LeftVolume, RightVolume);
+}
+
+void Voice::Play(const Sound& sound, u32 delay, bool looped, f32 pitch)
+{
+  host_mixer().start(*_Voice, sound, sound.GetFrequency() * pitch, delay, looped);
+}
+
+void Voice::Stop()
+{
+  host_mixer().stop(*_Voice);
+}
+
+void Voice::Mute(bool mute)
+{
+  host_mixer().set_mute(*_Voice, mute);
+}
+
+// EOF
@@ -0,0 +1,151 @@
+// src/host/work_pool.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C++ Standard Library
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Project headers
+#include "work_pool.hpp"
+
+namespace
+{
+
+// One worker's remaining slice [begin, end). Owners pop from the front,
+// thieves split off the back, both under the slice's lock. The bounds are
+// atomic only so thieves can peek at sizes without taking every lock.
+struct alignas(64) Slice
+{
+  std::mutex lock;
+  std::atomic<size_t> begin{0};
+  std::atomic<size_t> end{0};
+};
+
+bool pop_front(Slice& slice, size_t& index)
+{
+  std::lock_guard<std::mutex> guard(slice.lock);
+  if (slice.begin >= slice.end)
+  {
+    return false;
+  }
+  index = slice.begin++;
+  return true;
+}
+
+// Move the back half of the fullest other slice into ours
+bool steal(std::vector<Slice>& slices, unsigned self)
+{
+  for (;;)
+  {
+    unsigned victim = self;
+    size_t best = 0;
+    for (unsigned i = 0; i < slices.size(); i++)
+    {
+      // Unlocked peek, only used to pick a victim
+      size_t begin = slices[i].begin.load(std::memory_order_relaxed);
+      size_t end = slices[i].end.load(std::memory_order_relaxed);
+      if (i != self && begin < end && end - begin > best)
+      {
+        best = end - begin;
+        victim = i;
+      }
+    }
+
+    if (victim == self)
+    {
+      return false;
+    }
+
+    size_t begin, end;
+    {
+      std::lock_guard<std::mutex> guard(slices[victim].lock);
+      begin = slices[victim].begin;
+      end = slices[victim].end;
+      if (begin >= end)
+      {
+        continue;  // Emptied meanwhile; look again
+      }
+      begin = end - (end - begin + 1) / 2;
+      slices[victim].end = begin;
+    }
+
+    std::lock_guard<std::mutex> guard(slices[self].lock);
+    slices[self].begin = begin;
+    slices[self].end = end;
+    return true;
+  }
+}
+
+}  // namespace
+
+WorkPool::WorkPool(unsigned threads)
+  : thread_count(threads)
+{
+  if (thread_count == 0)
+  {
+    thread_count = std::thread::hardware_concurrency();
+  }
+  if (thread_count == 0)
+  {
+    thread_count = 1;
+  }
+}
+
+void WorkPool::parallel_for(size_t count,
+                            const std::function<void(size_t, unsigned)>& fn)
+{
+  unsigned workers = thread_count;
+  if (count < workers)
+  {
+    workers = count > 0 ? static_cast<unsigned>(count) : 1;
+  }
+
+  std::vector<Slice> slices(workers);
+  for (unsigned i = 0; i < workers; i++)
+  {
+    slices[i].begin = count * i / workers;
+    slices[i].end = count * (i + 1) / workers;
+  }
+
+  auto run = [&](unsigned self)
+  {
+    size_t index;
+    for (;;)
+    {
+      while (pop_front(slices[self], index))
+      {
+        fn(index, self);
+      }
+      if (!steal(slices, self))
+      {
+        return;
+      }
+    }
+  };
+
+  // The calling thread works too, as worker 0
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  for (unsigned i = 1; i < workers; i++)
+  {
+    threads.emplace_back(run, i);
+  }
+  run(0);
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+// EOF
@@ -0,0 +1,43 @@
+// src/host/work_pool.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <stddef.h>
+#include <functional>
+
+// Work-stealing parallel loop for the host tools. Each worker starts with
+// an equal slice of the index range and takes items from the front of its
+// own slice; a worker that runs dry steals the back half of the largest
+// remaining slice. Uneven items (short and long replays, early and late
+// deaths) therefore still keep every core busy until the very end.
+class WorkPool
+{
+private:
+  unsigned thread_count;
+
+public:
+  // threads == 0 uses every hardware thread
+  explicit WorkPool(unsigned threads = 0);
+
+  unsigned size() const
+  {
+    return thread_count;
+  }
+
+  // Calls fn(index, worker) once for every index in [0, count) and returns
+  // when all calls have finished. worker is in [0, size()) and is stable for
+  // the duration of a call, so it can index per-thread scratch state.
+  void parallel_for(size_t count,
+                    const std::function<void(size_t, unsigned)>& fn);
+};
+
+// EOF
@@ -10,19 +10,17 @@
 // (at your option) any later version.
 
 #include "physics.hpp"
+#include "bird_shape.hpp"
 #include "constants.hpp"
+#include "sprite_mask.hpp"
 
 Physics::Physics()
 {
-  Physics::position.x = BIRD_START_X;
-  Physics::position.y = BIRD_START_Y;
+  Physics::position.x = Scalar(BIRD_START_X);
+  Physics::position.y = Scalar(BIRD_START_Y);
   Physics::velocity = 0;
 }
 
-Physics::~Physics()
-{
-}
-
 Vec2 Physics::update_bird(bool flap, Pipe pipe_1, Pipe pipe_2)
 {
   if (flap && !dead)  // Only allow flapping when not dead
@@ -34,12 +32,15 @@ Vec2 Physics::update_bird(bool flap, Pipe pipe_1, Pipe pipe_2)
     velocity += Physics::gravity;
   }
 
+  const Vec2 from = Physics::position;
   Physics::position.y += velocity;
 
   // Only check collision if not already dead
   if (!dead)
   {
-    Physics::dead = is_colliding(pipe_1, pipe_2);
+    Physics::contact = sweep(from, Physics::position, bird_tilt(velocity), pipe_1,
+                             pipe_2);
+    Physics::dead = contact.surface != Surface::None;
   }
 
   // Update score only when alive
@@ -53,25 +54,28 @@ Vec2 Physics::update_bird(bool flap, Pipe pipe_1, Pipe pipe_2)
 
 void Physics::reset()
 {
-  Physics::position.x = BIRD_START_X;
-  Physics::position.y = BIRD_START_Y;
+  Physics::position.x = Scalar(BIRD_START_X);
+  Physics::position.y = Scalar(BIRD_START_Y);
   Physics::velocity = 0;
+  Physics::contact = Contact();
   Physics::score = 0;
   Physics::pipe_iter = false;
   Physics::dead = false;  // Reset dead state
 }
 
-Hitbox Physics::get_bird_hitbox() const
+Hitbox Physics::get_bird_hitbox(Vec2 position, int tilt)
 {
+  // Axis-aligned box around the tilted sprite
+  const BirdShape& shape = bird_shape(tilt);
   return Hitbox(
-    position.x,
-    position.y,
-    BIRD_WIDTH * BIRD_SCALE,
-    BIRD_HEIGHT * BIRD_SCALE
+    position.x + shape.left,
+    position.y + shape.top,
+    shape.right - shape.left,
+    shape.bottom - shape.top
   );
 }
 
-Hitbox Physics::get_pipe_top_hitbox(const Pipe& pipe) const
+Hitbox Physics::get_pipe_top_hitbox(const Pipe& pipe)
 {
   // Top pipe goes from y=0 to pipe.y - PIPE_GAP
   return Hitbox(
@@ -82,7 +86,7 @@ Hitbox Physics::get_pipe_top_hitbox(const Pipe& pipe) const
   );
 }
 
-Hitbox Physics::get_pipe_bottom_hitbox(const Pipe& pipe) const
+Hitbox Physics::get_pipe_bottom_hitbox(const Pipe& pipe)
 {
   // Bottom pipe starts at pipe.y and extends to ground level
   return Hitbox(
@@ -93,37 +97,234 @@ Hitbox Physics::get_pipe_bottom_hitbox(const Pipe& pipe) const
   );
 }
 
-bool Physics::is_colliding(Pipe pipe_1, Pipe pipe_2)
+bool Physics::collides(Vec2 position, int tilt, const Pipe& pipe_1,
+                       const Pipe& pipe_2, bool pixels)
 {
-  Hitbox bird = get_bird_hitbox();
+  const BirdShape& shape = bird_shape(tilt);
+  const Hitbox bird = get_bird_hitbox(position, tilt);
+  const OrientedBox box = bird_box(position, tilt);
 
-  // Check collision with pipe 1
-  if (bird.intersects(get_pipe_top_hitbox(pipe_1)) ||
-      bird.intersects(get_pipe_bottom_hitbox(pipe_1)))
+  const Pipe* pipes[2] = { &pipe_1, &pipe_2 };
+  for (const Pipe* pipe : pipes)
   {
-    return true;
+    const Hitbox top_pipe = get_pipe_top_hitbox(*pipe);
+    const Hitbox bottom_pipe = get_pipe_bottom_hitbox(*pipe);
+    if (bird.intersects(top_pipe) && box.intersects(top_pipe) &&
+        (!pixels || pixels_touch(position.x, *pipe, 1, 1, position.y, position.y,
+                                 tilt, true)))
+    {
+      return true;
+    }
+    if (bird.intersects(bottom_pipe) && box.intersects(bottom_pipe) &&
+        (!pixels || pixels_touch(position.x, *pipe, 1, 1, position.y, position.y,
+                                 tilt, false)))
+    {
+      return true;
+    }
   }
 
-  // Check collision with pipe 2
-  if (bird.intersects(get_pipe_top_hitbox(pipe_2)) ||
-      bird.intersects(get_pipe_bottom_hitbox(pipe_2)))
+  // Check screen bounds - bird dies if hitting top or ground
+  if (position.y + shape.top < 0 || position.y + shape.bottom >= GROUND_Y)
   {
     return true;
   }
 
-  // Check screen bounds - bird dies if hitting top or ground
-  if (bird.top() < 0 || bird.bottom() >= GROUND_Y)
+  return false;
+}
+
+// When a value moving linearly from `from` to `to` over the tick reaches
+// `target`, clamped to the tick
+static Scalar crossing_time(Scalar from, Scalar to, Scalar target)
+{
+  if (from == to)
   {
-    return true;
+    return 0;
+  }
+  Scalar time = (target - from) / (to - from);
+  return time < 0 ? Scalar(0) : (time > 1 ? Scalar(1) : time);
+}
+
+// Where the pipe's left edge is at `time` into the tick
+static Scalar pipe_x_at(const Pipe& pipe, Scalar time)
+{
+  return time == 1 ? pipe.x : pipe.x + pipe.get_speed() * (Scalar(1) - time);
+}
+
+bool Physics::overlap_window(Scalar left, Scalar right, const Pipe& pipe,
+                             Scalar& enter, Scalar& exit)
+{
+  const Scalar start_x = pipe.x + pipe.get_speed();
+  const bool at_start = !(right < start_x || left > start_x + PIPE_WIDTH);
+  const bool at_end = !(right < pipe.x || left > pipe.x + PIPE_WIDTH);
+
+  enter = 0;
+  exit = 1;
+  if (at_start && !at_end)
+  {
+    // The pipe's right edge passes the bird's left edge
+    exit = Scalar(1) - (left - (pipe.x + PIPE_WIDTH)) / pipe.get_speed();
+  }
+  else if (at_end && !at_start)
+  {
+    // The pipe's left edge passes the bird's right edge
+    enter = Scalar(1) - (right - pipe.x) / pipe.get_speed();
+  }
+  return at_start || at_end;
+}
+
+// Bird mask row moved right by dx columns (left if negative)
+static u64 shift_row(u64 row, int dx)
+{
+  if (dx <= -64 || dx >= 64)
+  {
+    return 0;
   }
+  return dx >= 0 ? row << dx : row >> -dx;
+}
+
+bool Physics::pixels_touch(Scalar bird_x, const Pipe& pipe, Scalar enter,
+                           Scalar exit, Scalar high, Scalar low, int tilt,
+                           bool top_pipe)
+{
+  const CollisionMasks& masks = collision_masks();
+  const SpriteMask& bird = masks.bird_at(tilt);
+
+  // Pipe column under bird mask column 0, at the start and end of the window
+  const int dx_first = to_pixel(bird_x - pipe_x_at(pipe, enter)) + bird.x;
+  const int dx_last = to_pixel(bird_x - pipe_x_at(pipe, exit)) + bird.x;
+
+  // Pipe row under bird mask row 0, counted from the lip: down the bottom
+  // pipe, up the (flipped) top pipe
+  const Scalar edge = top_pipe ? pipe.y - PIPE_GAP : pipe.y;
+  const int dy_first = to_pixel(high - edge) + bird.y;
+  const int dy_last = to_pixel(low - edge) + bird.y;
 
+  for (int dy = dy_first; dy <= dy_last; dy++)
+  {
+    for (int bird_row = 0; bird_row < bird.height; bird_row++)
+    {
+      const int pipe_row = top_pipe ? -1 - (dy + bird_row) : dy + bird_row;
+      if (pipe_row < 0 || !bird.rows[bird_row])
+      {
+        continue;  // Inside the gap, or an empty row
+      }
+
+      // Every column the row covers while the pipe slides
+      u64 swept = 0;
+      for (int dx = dx_first; dx <= dx_last; dx++)
+      {
+        swept |= shift_row(bird.rows[bird_row], dx);
+      }
+      if (swept & masks.pipe.row(pipe_row))
+      {
+        return true;
+      }
+    }
+  }
   return false;
 }
 
+Contact Physics::pipe_contact(Scalar x, Scalar from_y, Scalar to_y, int tilt,
+                              const Pipe& pipe, bool pixels)
+{
+  const BirdShape& shape = bird_shape(tilt);
+  Contact contact;
+
+  Scalar enter, exit;
+  if (!overlap_window(x + shape.left, x + shape.right, pipe, enter, exit))
+  {
+    return contact;
+  }
+
+  // Highest and lowest the bird gets while over the pipe
+  const Scalar y_enter = enter == 0 ? from_y : from_y + (to_y - from_y) * enter;
+  const Scalar y_exit = exit == 1 ? to_y : from_y + (to_y - from_y) * exit;
+  const Scalar high = y_enter < y_exit ? y_enter : y_exit;
+  const Scalar low = y_enter < y_exit ? y_exit : y_enter;
+
+  // The bird's path over the window against the span the pipe slides over
+  const OrientedBox box = bird_box({ x, high }, tilt);
+  const Scalar pipe_left = pipe_x_at(pipe, exit);
+  const Scalar pipe_width = pipe_x_at(pipe, enter) - pipe_left + PIPE_WIDTH;
+
+  // Same edges as get_pipe_*_hitbox
+  const Scalar top_bottom = Scalar(0) + (pipe.y - PIPE_GAP);
+  const Scalar bottom_bottom = pipe.y + (GROUND_Y - pipe.y);
+
+  const Scalar from_top = from_y + shape.top;
+  const Scalar from_bottom = from_y + shape.bottom;
+
+  if (!(low + shape.bottom < 0) && !(high + shape.top > top_bottom) &&
+      box.intersects(Hitbox(pipe_left, 0, pipe_width, pipe.y - PIPE_GAP), low - high) &&
+      (!pixels || pixels_touch(x, pipe, enter, exit, high, low, tilt, true)))
+  {
+    Scalar time = from_top > top_bottom
+                  ? crossing_time(from_top, to_y + shape.top, top_bottom) : Scalar(0);
+    contact.surface = Surface::TopPipe;
+    contact.time = time < enter ? enter : time;
+  }
+  if (!(low + shape.bottom < pipe.y) && !(high + shape.top > bottom_bottom) &&
+      box.intersects(Hitbox(pipe_left, pipe.y, pipe_width, GROUND_Y - pipe.y),
+                     low - high) &&
+      (!pixels || pixels_touch(x, pipe, enter, exit, high, low, tilt, false)))
+  {
+    Scalar time = from_bottom < pipe.y
+                  ? crossing_time(from_bottom, to_y + shape.bottom, pipe.y) : Scalar(0);
+    time = time < enter ? enter : time;
+    if (contact.surface == Surface::None || time < contact.time)
+    {
+      contact.surface = Surface::BottomPipe;
+      contact.time = time;
+    }
+  }
+  return contact;
+}
+
+Contact Physics::sweep(Vec2 from, Vec2 to, int tilt, const Pipe& pipe_1,
+                       const Pipe& pipe_2, bool pixels)
+{
+  const BirdShape& shape = bird_shape(tilt);
+
+  Contact first;
+  first.time = 1;
+  auto touch = [&first](Surface surface, Scalar time)
+  {
+    if (first.surface == Surface::None || time < first.time)
+    {
+      first.surface = surface;
+      first.time = time;
+    }
+  };
+
+  const Pipe* pipes[2] = { &pipe_1, &pipe_2 };
+  for (const Pipe* pipe : pipes)
+  {
+    const Contact contact = pipe_contact(to.x, from.y, to.y, tilt, *pipe, pixels);
+    if (contact.surface != Surface::None)
+    {
+      touch(contact.surface, contact.time);
+    }
+  }
+
+  // Screen bounds - bird dies if hitting top or ground
+  const Scalar to_top = to.y + shape.top;
+  const Scalar to_bottom = to.y + shape.bottom;
+  if (to_top < 0)
+  {
+    touch(Surface::Ceiling, crossing_time(from.y + shape.top, to_top, 0));
+  }
+  if (to_bottom >= GROUND_Y)
+  {
+    touch(Surface::Ground, crossing_time(from.y + shape.bottom, to_bottom, GROUND_Y));
+  }
+
+  return first;
+}
+
 void Physics::update_score(Pipe pipe_1, Pipe pipe_2)
 {
-  const float bird_center_x = position.x + (BIRD_WIDTH * BIRD_SCALE) / 2;
-  const float scoring_zone = 20; // Tolerance
+  const Scalar bird_center_x = position.x + Scalar((BIRD_WIDTH * BIRD_SCALE) / 2);
+  const Scalar scoring_zone = 20; // Tolerance
 
   // Check if bird's center just passed the pipe's trailing edge
   bool pipe1_passed = !pipe_iter &&
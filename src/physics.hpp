@@ -14,45 +14,110 @@
 #include "pipe.hpp"
 #include "vec2.hpp"
 #include "collision.hpp"
+#include "constants.hpp"
+
+// What a bird ran into, and when (see Physics::sweep)
+enum class Surface : u8
+{
+  None,
+  TopPipe,
+  BottomPipe,
+  Ceiling,
+  Ground
+};
+
+struct Contact
+{
+  Surface surface = Surface::None;
+  Scalar time = 0;  // Fraction of the tick, 0 (its start) to 1 (its end)
+};
 
 class Physics
 {
-private:
-  const float gravity = 0.5;
-  const float flap_height = -6.5;
+public:
+  // Per-tick values (tuned at 60 Hz, see SIM_FRAME_SCALE)
+  static constexpr Scalar gravity = Scalar(0.5f * SIM_FRAME_SCALE * SIM_FRAME_SCALE);
+  static constexpr Scalar flap_height = Scalar(-6.5f * SIM_FRAME_SCALE);
 
+private:
   Vec2 position;
 
-  bool is_colliding(Pipe pipe_1, Pipe pipe_2);
   void update_score(Pipe pipe_1, Pipe pipe_2);
 
+public:
   // Helper methods for collision detection
-  Hitbox get_bird_hitbox() const;
-  Hitbox get_pipe_top_hitbox(const Pipe& pipe) const;
-  Hitbox get_pipe_bottom_hitbox(const Pipe& pipe) const;
+  static Hitbox get_bird_hitbox(Vec2 position, int tilt);
+  static Hitbox get_pipe_top_hitbox(const Pipe& pipe);
+  static Hitbox get_pipe_bottom_hitbox(const Pipe& pipe);
 
-public:
+  // No destructor or copy operations: Physics stays trivially copyable so
+  // GameSnapshot can clone it with a plain memcpy
   Physics();
-  ~Physics();
 
   Vec2 update_bird(bool flap, Pipe pipe_1, Pipe pipe_2);
   void reset();
 
+  // The bird's collision shape is its sprite turned by `tilt`, the index
+  // bird_tilt() gives for its velocity (see bird_shape.hpp). Pipes are
+  // tested in three steps, each only run if the one before hits: the box
+  // around the tilted sprite, the tilted box itself (separating axes) and,
+  // with `pixels`, the collision masks (see pixels_touch). The screen bounds
+  // are plain lines against the box around the sprite.
+
+  // Discrete collision test: a bird standing at `position`
+  static bool collides(Vec2 position, int tilt, const Pipe& pipe_1,
+                       const Pipe& pipe_2, bool pixels = true);
+
+  // The collision test update_bird applies. During a tick the bird moves
+  // in a straight line from `from` to `to` while each pipe slides from
+  // x + speed to x (pipes only stand still or jump while off screen), so a
+  // bird cannot slip past a pipe lip between two ticks. Returns the first
+  // surface touched, or Surface::None.
+  static Contact sweep(Vec2 from, Vec2 to, int tilt, const Pipe& pipe_1,
+                       const Pipe& pipe_2, bool pixels = true);
+
+  // The part of sweep for one pipe, for a bird at x moving from from_y to
+  // to_y: the first of its two halves touched, or Surface::None
+  static Contact pipe_contact(Scalar x, Scalar from_y, Scalar to_y, int tilt,
+                              const Pipe& pipe, bool pixels = true);
+
+  // Part of a tick [enter, exit] during which `pipe` overlaps the span
+  // [left, right] horizontally; false if it does not overlap at all. enter
+  // is 0 and exit is 1 whenever the pipe overlaps at both ends of the tick.
+  static bool overlap_window(Scalar left, Scalar right, const Pipe& pipe,
+                             Scalar& enter, Scalar& exit);
+
+  // Narrow phase: whether the bird's collision mask at `tilt` meets the top
+  // or bottom pipe's while the pipe slides over [enter, exit] of the tick
+  // and the bird's position stays within [high, low] vertically. Positions
+  // are rounded to whole pixels, and every pairing of the horizontal and
+  // vertical offsets in those ranges is tested, so the answer errs towards
+  // a hit.
+  static bool pixels_touch(Scalar bird_x, const Pipe& pipe, Scalar enter,
+                           Scalar exit, Scalar high, Scalar low, int tilt,
+                           bool top_pipe);
+
   // Add getters for encapsulation
   Vec2 get_position() const
   {
     return position;
   }
-  float get_x() const
+  Scalar get_x() const
   {
     return position.x;
   }
-  float get_y() const
+  Scalar get_y() const
   {
     return position.y;
   }
+  // For restoring packed history (see RewindBuffer); x never changes
+  void set_y(Scalar y)
+  {
+    position.y = y;
+  }
 
-  float velocity;
+  Scalar velocity;
+  Contact contact;  // What killed the bird (Surface::None while alive)
   bool pipe_iter = false;
   bool dead = false;
   int score = 0;
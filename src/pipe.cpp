@@ -12,15 +12,11 @@
 #include "pipe.hpp"
 #include "constants.hpp"
 
-Pipe::Pipe()
+Pipe::Pipe(Rng& rng)
 {
-  Pipe::y = rand() % (SCREEN_HEIGHT / 2) + 1 + (SCREEN_HEIGHT / 4);
+  Pipe::y = rng.below(PIPE_Y_COUNT) + PIPE_Y_MIN;
   Pipe::x = SCREEN_WIDTH;
-  Pipe::speed = PIPE_SPEED;
-}
-
-Pipe::~Pipe()
-{
+  Pipe::speed = Scalar(PIPE_SPEED);
 }
 
 void Pipe::move()
@@ -28,10 +24,32 @@ void Pipe::move()
   Pipe::x -= Pipe::speed;
 }
 
-void Pipe::reset()
+void Pipe::reset(Rng& rng)
 {
-  Pipe::y = rand() % (SCREEN_HEIGHT / 2) + 1 + (SCREEN_HEIGHT / 4);
+  Pipe::y = rng.below(PIPE_Y_COUNT) + PIPE_Y_MIN;
   Pipe::x = SCREEN_WIDTH;
 }
 
+void advance_pipes(Pipe& pipe_1, Pipe& pipe_2, bool& first_round, Rng& rng)
+{
+  pipe_1.move();
+  if (pipe_1.x < SCREEN_WIDTH / 2 && first_round)
+  {
+    first_round = false;
+  }
+  if (pipe_1.x < -PIPE_WIDTH)
+  {
+    pipe_1.reset(rng);
+  }
+
+  if (!first_round)
+  {
+    pipe_2.move();
+    if (pipe_2.x < -PIPE_WIDTH)
+    {
+      pipe_2.reset(rng);
+    }
+  }
+}
+
 // EOF
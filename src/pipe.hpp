@@ -11,20 +11,33 @@
 
 #pragma once
 
-#include <stdlib.h>
+#include "rng.hpp"
+#include "scalar.hpp"
 
 class Pipe
 {
 private:
-  float speed;
+  Scalar speed;
 
 public:
-  float x, y;
+  Scalar x, y;
 
-  Pipe();
-  ~Pipe();
+  // Trivial default constructor (fields left unset) and no destructor, so
+  // pipes can live in plain-data snapshots
+  Pipe() = default;
+  explicit Pipe(Rng& rng);
   void move();
-  void reset();
+  void reset(Rng& rng);
+
+  Scalar get_speed() const
+  {
+    return speed;
+  }
 };
 
+// Per-tick pipe movement shared by GameState and the host simulators:
+// pipe_2 joins once pipe_1 reaches mid-screen and pipes that leave the
+// screen on the left respawn on the right with a new gap height.
+void advance_pipes(Pipe& pipe_1, Pipe& pipe_2, bool& first_round, Rng& rng);
+
 // EOF
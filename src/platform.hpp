@@ -0,0 +1,140 @@
+// src/platform.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include "types.hpp"
+
+// Thin platform layer. Game code only talks to these interfaces; the Wii
+// backend (src/wii) wraps GRRLIB, WPAD and libfat, while the host backend
+// (src/host) provides headless implementations for native builds.
+// Audio goes through Voice, whose backend is selected at link time.
+
+// ============================================================================
+// Input
+// ============================================================================
+
+// Button bits. Values match libogc's WPAD_BUTTON_* so the Wii backend can
+// pass the controller state straight through.
+const u32 INPUT_BUTTON_2 = 0x0001;
+const u32 INPUT_BUTTON_1 = 0x0002;
+const u32 INPUT_BUTTON_B = 0x0004;
+const u32 INPUT_BUTTON_A = 0x0008;
+const u32 INPUT_BUTTON_MINUS = 0x0010;
+const u32 INPUT_BUTTON_HOME = 0x0080;
+const u32 INPUT_BUTTON_LEFT = 0x0100;
+const u32 INPUT_BUTTON_RIGHT = 0x0200;
+const u32 INPUT_BUTTON_DOWN = 0x0400;
+const u32 INPUT_BUTTON_UP = 0x0800;
+const u32 INPUT_BUTTON_PLUS = 0x1000;
+
+struct InputState
+{
+  u32 buttons = 0;         // Buttons pressed down this frame
+  u32 held = 0;            // Buttons held down this frame
+  float pointer_x = 0;     // Raw IR pointer position (screen space)
+  float pointer_y = 0;
+};
+
+class Input
+{
+public:
+  virtual ~Input() = default;
+
+  // Sample the controller once per frame
+  virtual InputState Poll() = 0;
+};
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+enum class TextureId
+{
+  Bird,
+  Pipe
+};
+
+enum class FontId
+{
+  Score,
+  Title
+};
+
+class Renderer
+{
+public:
+  virtual ~Renderer() = default;
+
+  virtual void FillScreen(u32 color) = 0;
+  virtual void Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color,
+                         bool filled) = 0;
+  virtual void Plot(f32 x, f32 y, u32 color) = 0;
+  virtual void DrawImage(f32 x, f32 y, TextureId texture, f32 degrees,
+                         f32 scale_x, f32 scale_y, u32 color) = 0;
+  virtual void PrintText(int x, int y, FontId font, const char* text,
+                         u32 size, u32 color) = 0;
+
+  // Finish the frame (waits for vsync on the console)
+  virtual void Present() = 0;
+};
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+// Monotonic time in microseconds
+u64 GetTimeMicros();
+
+// Give up the CPU for about this long, so background threads can run
+void SleepMicros(u32 micros);
+
+// ============================================================================
+// Storage
+// ============================================================================
+
+// PollRead / PollAppend result while the operation is still running
+const int IO_PENDING = -2;
+
+class Storage
+{
+public:
+  virtual ~Storage() = default;
+
+  // Read up to capacity bytes; returns the number of bytes read or -1
+  virtual int ReadFile(const char* path, void* buffer, u32 capacity) = 0;
+
+  // Replace the file contents; returns false on failure. Waits for a
+  // background read to finish first.
+  virtual bool WriteFile(const char* path, const void* data, u32 size) = 0;
+
+  // Add to the end of the file, creating it if needed; returns false on
+  // failure. Waits for a background append to finish first.
+  virtual bool AppendFile(const char* path, const void* data, u32 size) = 0;
+
+  // Start reading up to `size` bytes from `offset` into `buffer` in the
+  // background and return at once. One read runs at a time; returns false
+  // if one still is. The buffer must stay valid until PollRead stops
+  // returning IO_PENDING.
+  virtual bool ReadFileAsync(const char* path, u32 offset, void* buffer,
+                             u32 size) = 0;
+
+  // The same for AppendFile, independent of the read. The data must stay
+  // valid until PollAppend stops returning IO_PENDING.
+  virtual bool AppendFileAsync(const char* path, const void* data, u32 size) = 0;
+
+  // Outcome of the last background read or append without blocking: bytes
+  // read or written, -1 on failure or IO_PENDING
+  virtual int PollRead() = 0;
+  virtual int PollAppend() = 0;
+};
+
+// EOF
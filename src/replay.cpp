@@ -0,0 +1,200 @@
+// src/replay.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C Standard Library
+#include <string.h>
+
+// Project headers
+#include "replay.hpp"
+#include "constants.hpp"
+#include "physics.hpp"
+#include "pipe.hpp"
+#include "scalar.hpp"
+
+static void write_varint(std::vector<u8>& out, u32 value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<u8>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<u8>(value));
+}
+
+static bool read_varint(const u8* data, size_t size, size_t& pos, u32& value)
+{
+  value = 0;
+  for (int shift = 0; shift < 35 && pos < size; shift += 7)
+  {
+    u8 byte = data[pos++];
+    value |= static_cast<u32>(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ============================================================================
+// ReplayRecorder
+// ============================================================================
+
+void ReplayRecorder::begin(u32 seed)
+{
+  ReplayRecorder::seed = seed;
+  frames = 0;
+  flaps = 0;
+  gap = 0;
+  gaps.clear();
+  gaps.reserve(1024);
+}
+
+void ReplayRecorder::record(bool flap)
+{
+  frames++;
+  if (flap)
+  {
+    write_varint(gaps, gap);
+    flaps++;
+    gap = 0;
+  }
+  else
+  {
+    gap++;
+  }
+}
+
+const std::vector<u8>& ReplayRecorder::finish(u32 score)
+{
+  static const u8 magic[] = { 'F', 'W', 'R', 'P', REPLAY_VERSION, SIM_NUMERIC_MODE };
+
+  file.assign(magic, magic + sizeof(magic));
+  file.push_back(static_cast<u8>(SIM_TICK_RATE & 0xFF));
+  file.push_back(static_cast<u8>(SIM_TICK_RATE >> 8));
+  for (int i = 0; i < 4; i++)
+  {
+    file.push_back(static_cast<u8>(seed >> (8 * i)));
+  }
+  write_varint(file, frames);
+  write_varint(file, score);
+  write_varint(file, flaps);
+  file.insert(file.end(), gaps.begin(), gaps.end());
+  return file;
+}
+
+// ============================================================================
+// ReplayPlayer
+// ============================================================================
+
+bool read_replay_info(const u8* data, size_t size, ReplayInfo& info,
+                      size_t* stream_offset)
+{
+  if (size < 12 || memcmp(data, "FWRP", 4) != 0 || data[4] != REPLAY_VERSION)
+  {
+    return false;
+  }
+
+  info.numeric_mode = data[5];
+  info.tick_rate = static_cast<u16>(data[6] | (data[7] << 8));
+  info.seed = static_cast<u32>(data[8]) | (static_cast<u32>(data[9]) << 8) |
+              (static_cast<u32>(data[10]) << 16) | (static_cast<u32>(data[11]) << 24);
+
+  size_t pos = 12;
+  if (!read_varint(data, size, pos, info.frames) ||
+      !read_varint(data, size, pos, info.score) ||
+      !read_varint(data, size, pos, info.flaps))
+  {
+    return false;
+  }
+
+  if (stream_offset)
+  {
+    *stream_offset = pos;
+  }
+  return true;
+}
+
+bool ReplayPlayer::open(const u8* data, size_t size)
+{
+  ReplayPlayer::data = data;
+  ReplayPlayer::size = size;
+  has_gap = false;
+  gap = 0;
+  pos = 0;
+
+  // Tuning constants are per tick and float and fixed-point math differ, so
+  // only runs from a build with the same rate and numeric mode reproduce
+  if (!read_replay_info(data, size, info, &pos) || info.tick_rate != SIM_TICK_RATE ||
+      info.numeric_mode != SIM_NUMERIC_MODE)
+  {
+    ReplayPlayer::size = 0;
+    return false;
+  }
+  return true;
+}
+
+bool ReplayPlayer::next()
+{
+  if (!has_gap)
+  {
+    if (!read_varint(data, size, pos, gap))
+    {
+      return false;  // No flaps left: coast until the bird dies
+    }
+    has_gap = true;
+  }
+
+  if (gap == 0)
+  {
+    has_gap = false;
+    return true;
+  }
+
+  gap--;
+  return false;
+}
+
+// ============================================================================
+// Verification
+// ============================================================================
+
+ReplayResult simulate_replay(const u8* data, size_t size, u32 max_frames)
+{
+  ReplayResult result;
+  ReplayPlayer player;
+  if (!player.open(data, size))
+  {
+    return result;
+  }
+  result.valid = true;
+
+  // Same setup as GameState::start_run
+  Rng rng(player.get_info().seed);
+  Pipe pipe_1(rng);
+  Pipe pipe_2(rng);
+  bool first_round = true;
+  Physics physics;
+
+  // Same order as GameState::update_game
+  while (!physics.dead && result.frames < max_frames)
+  {
+    physics.update_bird(player.next(), pipe_1, pipe_2);
+    advance_pipes(pipe_1, pipe_2, first_round, rng);
+    result.frames++;
+  }
+
+  result.score = physics.score;
+  result.unused_input = !player.exhausted();
+  return result;
+}
+
+// EOF
@@ -0,0 +1,119 @@
+// src/replay.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+#include "types.hpp"
+
+// Replay file layout (all multi-byte fields little-endian):
+//
+//   "FWRP"          magic
+//   u8  version     REPLAY_VERSION
+//   u8  numeric     SIM_NUMERIC_MODE: 0 float, 1 fixed point
+//   u16 tick_rate   SIM_TICK_RATE the run was recorded at
+//   u32 seed        Run seed (see GameState::start_run)
+//   varint frames   Ticks of live play (update_game calls)
+//   varint score    Score at death
+//   varint flaps    Number of flaps in the stream
+//   varint gap...   One per flap: idle ticks since the previous flap
+//
+// Flaps are edge-triggered, so the input is a sparse bit stream; storing
+// only the run of zeros before each one costs one byte per flap at normal
+// play speeds. Varints are LEB128 (7 bits per byte, high bit = more).
+// Float and fixed-point builds do not simulate identically, so a replay
+// only plays back in a build with the same tick rate and numeric mode.
+
+// Raised whenever the rules change so old runs no longer reproduce
+// (2: swept collision, 3: pixel collision masks, 4: tilted bird)
+const u8 REPLAY_VERSION = 4;
+const size_t REPLAY_MAX_SIZE = 64 * 1024;
+
+// Fixed fields plus three varints of at most five bytes
+const size_t REPLAY_HEADER_MAX = 12 + 3 * 5;
+
+struct ReplayInfo
+{
+  u8 numeric_mode = 0;
+  u16 tick_rate = 0;
+  u32 seed = 0;
+  u32 frames = 0;
+  u32 score = 0;
+  u32 flaps = 0;
+};
+
+class ReplayRecorder
+{
+private:
+  std::vector<u8> gaps;
+  std::vector<u8> file;
+  u32 seed = 0;
+  u32 frames = 0;
+  u32 flaps = 0;
+  u32 gap = 0;
+
+public:
+  void begin(u32 seed);
+
+  // Call once per tick of live play
+  void record(bool flap);
+
+  // Close the run and return the encoded file
+  const std::vector<u8>& finish(u32 score);
+};
+
+class ReplayPlayer
+{
+private:
+  const u8* data = nullptr;
+  size_t size = 0;
+  size_t pos = 0;
+  u32 gap = 0;
+  bool has_gap = false;
+  ReplayInfo info;
+
+public:
+  // Parse the header; the data must outlive the player
+  bool open(const u8* data, size_t size);
+
+  const ReplayInfo& get_info() const
+  {
+    return info;
+  }
+
+  // Input for the next tick of live play
+  bool next();
+
+  // True once every recorded flap has been consumed
+  bool exhausted() const
+  {
+    return !has_gap && pos >= size;
+  }
+};
+
+// Header-only parse, for tools that only need the claimed result
+bool read_replay_info(const u8* data, size_t size, ReplayInfo& info,
+                      size_t* stream_offset = nullptr);
+
+struct ReplayResult
+{
+  bool valid = false;        // Header parsed and tick rate matches
+  u32 frames = 0;            // Ticks of live play until death
+  u32 score = 0;             // Score at death
+  bool unused_input = false; // Flaps left in the stream after death
+};
+
+// Re-run a replay through Physics and Pipe exactly as GameState plays it,
+// without audio or rendering. Gives up after max_frames ticks.
+ReplayResult simulate_replay(const u8* data, size_t size, u32 max_frames);
+
+// EOF
@@ -0,0 +1,244 @@
+// src/rewind.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Project headers
+#include "rewind.hpp"
+
+static const u32 NO_SEGMENT = ~0u;
+static const u32 HISTORY_TICKS = RewindBuffer::SEGMENTS * RewindBuffer::SEGMENT_TICKS;
+
+// One tick of a practice run as GameState plays it: update_game while the
+// bird is alive, update_death_fall once it is falling
+static void replay_tick(GameSnapshot& state, bool flap)
+{
+  if (state.is_dying)
+  {
+    state.physics.update_bird(false, state.pipe_1, state.pipe_2);
+    return;
+  }
+
+  step_snapshot(state, flap);
+  scroll_ground(state.ground_scroll_offset, state.world_scroll_x);
+  state.is_dying = state.physics.dead;
+}
+
+// Packed::flags
+static const u8 FLAG_PIPE_ITER = 1 << 0;
+static const u8 FLAG_DEAD = 1 << 1;
+static const u8 FLAG_FIRST_ROUND = 1 << 2;
+static const u8 FLAG_DYING = 1 << 3;
+
+RewindBuffer::RewindBuffer()
+{
+  clear();
+}
+
+void RewindBuffer::clear()
+{
+  oldest = 0;
+  newest = 0;
+  for (Half& half : halves)
+  {
+    half.segment = NO_SEGMENT;
+    half.valid = 0;
+  }
+}
+
+void RewindBuffer::push(const GameSnapshot& state, bool flap)
+{
+  const u32 tick = newest;
+  const u32 segment = tick / SEGMENT_TICKS;
+  const int offset = tick % SEGMENT_TICKS;
+
+  if (tick == 0)
+  {
+    base = state;
+  }
+
+  // A new keyframe drops the oldest segment once the ring is full
+  if (offset == 0)
+  {
+    pack(state, keyframes[segment % SEGMENTS]);
+    if (segment + 1 >= SEGMENTS && (segment + 1 - SEGMENTS) * SEGMENT_TICKS > oldest)
+    {
+      oldest = (segment + 1 - SEGMENTS) * SEGMENT_TICKS;
+    }
+  }
+
+  // The segment before keeps what this one has not grown into; anything
+  // else in the window belongs to a timeline rewound away
+  Half& half = claim(segment);
+  Half& other = halves[(segment + 1) & 1];
+  if (other.segment != segment - 1)
+  {
+    other.segment = NO_SEGMENT;
+    other.valid = 0;
+  }
+  else if (other.valid > SEGMENT_TICKS - 1 - offset)
+  {
+    other.valid = SEGMENT_TICKS - 1 - offset;
+  }
+
+  pack(state, slot(segment, offset));
+  half.valid = offset + 1;
+
+  const u32 bit = tick % HISTORY_TICKS;
+  if (flap)
+  {
+    flaps[bit / 8] |= 1 << (bit % 8);
+  }
+  else
+  {
+    flaps[bit / 8] &= ~(1 << (bit % 8));
+  }
+
+  newest = tick + 1;
+
+  // Finish decoding the segment before, should a rewind have stopped in
+  // the middle of it
+  decode_before(segment);
+}
+
+bool RewindBuffer::step_back(GameSnapshot& state, bool& flap)
+{
+  if (empty())
+  {
+    return false;
+  }
+
+  const u32 tick = newest - 1;
+  const u32 segment = tick / SEGMENT_TICKS;
+  const int offset = tick % SEGMENT_TICKS;
+  Half& half = halves[segment & 1];
+  if (half.segment != segment || half.valid <= offset)
+  {
+    decode_before(segment + 1);
+    return false;
+  }
+
+  unpack(slot(segment, offset), state);
+  flap = flap_at(tick);
+  newest = tick;
+
+  // Its slot is free for the segment before
+  half.valid = offset;
+  decode_before(segment);
+  return true;
+}
+
+void RewindBuffer::pack(const GameSnapshot& state, Packed& packed)
+{
+  const Physics& physics = state.physics;
+  packed.bird_y = physics.get_y();
+  packed.velocity = physics.velocity;
+  packed.contact_time = physics.contact.time;
+  packed.score = physics.score;
+  packed.pipe_x[0] = state.pipe_1.x;
+  packed.pipe_x[1] = state.pipe_2.x;
+  packed.pipe_y[0] = state.pipe_1.y;
+  packed.pipe_y[1] = state.pipe_2.y;
+  packed.rng[0] = static_cast<u32>(state.rng.get_state());
+  packed.rng[1] = static_cast<u32>(state.rng.get_state() >> 32);
+  packed.ground_scroll_offset = state.ground_scroll_offset;
+  packed.world_scroll_x = state.world_scroll_x;
+  packed.contact_surface = physics.contact.surface;
+  packed.flags = (physics.pipe_iter ? FLAG_PIPE_ITER : 0) |
+                 (physics.dead ? FLAG_DEAD : 0) |
+                 (state.first_round ? FLAG_FIRST_ROUND : 0) |
+                 (state.is_dying ? FLAG_DYING : 0);
+}
+
+void RewindBuffer::unpack(const Packed& packed, GameSnapshot& state) const
+{
+  state = base;
+  Physics& physics = state.physics;
+  physics.set_y(packed.bird_y);
+  physics.velocity = packed.velocity;
+  physics.contact.time = packed.contact_time;
+  physics.contact.surface = packed.contact_surface;
+  physics.score = packed.score;
+  physics.pipe_iter = packed.flags & FLAG_PIPE_ITER;
+  physics.dead = packed.flags & FLAG_DEAD;
+  state.pipe_1.x = packed.pipe_x[0];
+  state.pipe_2.x = packed.pipe_x[1];
+  state.pipe_1.y = packed.pipe_y[0];
+  state.pipe_2.y = packed.pipe_y[1];
+  state.rng.set_state(packed.rng[0] | static_cast<u64>(packed.rng[1]) << 32);
+  state.ground_scroll_offset = packed.ground_scroll_offset;
+  state.world_scroll_x = packed.world_scroll_x;
+  state.first_round = packed.flags & FLAG_FIRST_ROUND;
+  state.is_dying = packed.flags & FLAG_DYING;
+}
+
+bool RewindBuffer::flap_at(u32 tick) const
+{
+  const u32 bit = tick % HISTORY_TICKS;
+  return (flaps[bit / 8] >> (bit % 8)) & 1;
+}
+
+// Even segments count up from the front of the window, odd ones down from
+// the back
+RewindBuffer::Packed& RewindBuffer::slot(u32 segment, int offset)
+{
+  return window[(segment & 1) ? SEGMENT_TICKS - 1 - offset : offset];
+}
+
+// The half for `segment`, emptied if it held another one
+RewindBuffer::Half& RewindBuffer::claim(u32 segment)
+{
+  Half& half = halves[segment & 1];
+  if (half.segment != segment)
+  {
+    half.segment = segment;
+    half.valid = 0;
+  }
+  return half;
+}
+
+// One step of decoding the segment before `segment`, into the slots
+// `segment` leaves free: its keyframe first, then one replayed tick per
+// call
+void RewindBuffer::decode_before(u32 segment)
+{
+  if (segment * SEGMENT_TICKS <= oldest)
+  {
+    return;
+  }
+
+  const u32 target = segment - 1;
+  Half& half = claim(target);
+  Half& other = halves[segment & 1];
+  if (other.segment != segment)
+  {
+    other.segment = NO_SEGMENT;
+    other.valid = 0;
+  }
+
+  if (half.valid >= SEGMENT_TICKS - other.valid)
+  {
+    return;
+  }
+
+  if (half.valid == 0)
+  {
+    slot(target, 0) = keyframes[target % SEGMENTS];
+  }
+  else
+  {
+    GameSnapshot next;
+    unpack(slot(target, half.valid - 1), next);
+    replay_tick(next, flap_at(target * SEGMENT_TICKS + half.valid - 1));
+    pack(next, slot(target, half.valid));
+  }
+  half.valid++;
+}
+
+// EOF
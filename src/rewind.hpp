@@ -0,0 +1,125 @@
+// src/rewind.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include "constants.hpp"
+#include "game_snapshot.hpp"
+#include "types.hpp"
+
+// History of a practice run, for stepping it back one tick at a time.
+//
+// The simulation is deterministic, so a tick is fully described by the
+// state it started from plus its flap. The ring keeps a full snapshot (a
+// keyframe) every SEGMENT_TICKS ticks and one flap bit per tick in
+// between. Every state is rebuilt by playing the flaps forward from its
+// keyframe.
+//
+// Rewinding needs the states of a segment in reverse order, so a window
+// of SEGMENT_TICKS decoded states is shared by two neighbouring segments:
+// even segments fill it from the front, odd ones from the back. Each step
+// back frees the slot of the state it hands out, and that is the slot the
+// segment before needs for its next decoded state, so that segment is
+// decoded one tick per step back, keyframe first. A segment takes
+// SEGMENT_TICKS steps to rewind through and as many to decode, so each
+// step back costs one copy plus at most one simulated tick. That tick is
+// the player's bird and the pipes only, which is less than a regular
+// update. Forward play fills the window for the current segment as it
+// goes, and squeezes the segment before into what is left.
+//
+// Keyframes and decoded states are stored packed, without what stays the
+// same for a whole run (the bird's x, the pipes' speed) or padding; those
+// come from the run's first snapshot. With SEGMENT_TICKS near the square
+// root of the history, keyframes and window take about the same room,
+// under 5 KB in all for 30 seconds at 60 Hz. Everything lives inside the
+// object, so nothing is allocated after construction.
+class RewindBuffer
+{
+public:
+  static const int SEGMENT_TICKS = 40;
+
+  // Enough whole segments for REWIND_SECONDS, plus the one being filled
+  static const int SEGMENTS =
+    (REWIND_SECONDS * SIM_TICK_RATE + SEGMENT_TICKS - 1) / SEGMENT_TICKS + 1;
+
+  RewindBuffer();
+
+  // Forget the history (call at the start of every run)
+  void clear();
+
+  // Record a tick: `state` is what it starts from, `flap` its input
+  void push(const GameSnapshot& state, bool flap);
+
+  // Move back one tick and write the state it started from to `state`, and
+  // its input to `flap`. Returns false if the history is used up, or if
+  // the states before a point where an earlier rewind stopped are still
+  // being decoded (the caller just holds still that tick).
+  bool step_back(GameSnapshot& state, bool& flap);
+
+  bool empty() const
+  {
+    return newest == oldest;
+  }
+
+  // Ticks that can still be stepped back
+  u32 size() const
+  {
+    return newest - oldest;
+  }
+
+private:
+  // The parts of a GameSnapshot that change during a run
+  struct Packed
+  {
+    Scalar bird_y;
+    Scalar velocity;
+    Scalar contact_time;
+    s32 score;
+    Scalar pipe_x[2];
+    Scalar pipe_y[2];
+    u32 rng[2];  // Halves of the state, so nothing needs 8-byte alignment
+    float ground_scroll_offset;
+    float world_scroll_x;
+    Surface contact_surface;
+    u8 flags;
+  };
+
+  // The segment one end of the window holds, and how many of its states
+  // are decoded, from the keyframe on
+  struct Half
+  {
+    u32 segment;  // ~0 for none
+    int valid;
+  };
+
+  GameSnapshot base;  // The run's first state, for what Packed leaves out
+  Packed keyframes[SEGMENTS];
+  Packed window[SEGMENT_TICKS];
+  Half halves[2];     // Even segments, odd segments
+  u8 flaps[(SEGMENTS * SEGMENT_TICKS + 7) / 8];
+
+  u32 oldest;  // First tick still held (the start of a segment)
+  u32 newest;  // Ticks pushed; the live state is the start of tick `newest`
+
+  static void pack(const GameSnapshot& state, Packed& packed);
+  void unpack(const Packed& packed, GameSnapshot& state) const;
+
+  bool flap_at(u32 tick) const;
+  Packed& slot(u32 segment, int offset);
+  Half& claim(u32 segment);
+  void decode_before(u32 segment);
+};
+
+// Faster tick rates keep more ticks for the same REWIND_SECONDS
+static_assert(SIM_TICK_RATE > 60 || sizeof(RewindBuffer) <= 5 * 1024,
+              "RewindBuffer outgrew its 5 KB budget");
+
+// EOF
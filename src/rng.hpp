@@ -0,0 +1,64 @@
+// src/rng.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include "types.hpp"
+
+// Small seedable generator (PCG32, XSH-RR variant). Each game owns one, so
+// a run is fully determined by its seed and independent of any other game
+// in the same process. Produces the same sequence on every platform.
+class Rng
+{
+private:
+  u64 state;
+
+public:
+  explicit Rng(u32 seed = 0)
+  {
+    reseed(seed);
+  }
+
+  void reseed(u32 seed)
+  {
+    state = 0;
+    next();
+    state += seed;
+    next();
+  }
+
+  u32 next()
+  {
+    u64 old = state;
+    state = old * 6364136223846793005ULL + 1442695040888963407ULL;
+    u32 xorshifted = static_cast<u32>(((old >> 18) ^ old) >> 27);
+    u32 rot = static_cast<u32>(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+  }
+
+  // Uniform-ish value in [0, bound)
+  u32 below(u32 bound)
+  {
+    return static_cast<u32>((static_cast<u64>(next()) * bound) >> 32);
+  }
+
+  // Raw state, for snapshots
+  u64 get_state() const
+  {
+    return state;
+  }
+  void set_state(u64 value)
+  {
+    state = value;
+  }
+};
+
+// EOF
@@ -0,0 +1,173 @@
+// src/scalar.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <type_traits>
+#include "types.hpp"
+
+// Number type of the simulation (Vec2, Hitbox, Pipe, Physics, BatchSim).
+// By default it is float. Building with -DFLAPWII_FIXED_POINT switches it
+// to Fixed, a 16.16 fixed-point value whose results depend on integer math
+// only, so they are the same on every compiler, flag set and CPU.
+// Rendering, the policy network and other consumers convert to float with
+// to_float(). Replays record which of the two they were made with.
+
+#ifdef FLAPWII_FIXED_POINT
+
+class Fixed
+{
+public:
+  static const int FRACTION_BITS = 16;
+  static const s32 ONE = 1 << FRACTION_BITS;
+
+  s32 raw;
+
+  // Trivial, so structs of Fixed stay plain data
+  Fixed() = default;
+
+  // Whole numbers convert implicitly and exactly
+  template <typename T>
+    requires std::is_integral_v<T>
+  constexpr Fixed(T value)
+    : raw(static_cast<s32>(value) * ONE)
+  {
+  }
+
+  // Fractions must be converted explicitly; rounds to the nearest step.
+  // Meant for constants, which the compiler folds.
+  explicit constexpr Fixed(float value)
+    : raw(static_cast<s32>(value * ONE + (value < 0 ? -0.5f : 0.5f)))
+  {
+  }
+  explicit constexpr Fixed(double value)
+    : raw(static_cast<s32>(value * ONE + (value < 0 ? -0.5 : 0.5)))
+  {
+  }
+
+  static constexpr Fixed from_raw(s32 raw)
+  {
+    Fixed value;
+    value.raw = raw;
+    return value;
+  }
+
+  explicit constexpr operator float() const
+  {
+    return static_cast<float>(raw) / ONE;
+  }
+
+  constexpr Fixed& operator+=(Fixed other)
+  {
+    raw += other.raw;
+    return *this;
+  }
+  constexpr Fixed& operator-=(Fixed other)
+  {
+    raw -= other.raw;
+    return *this;
+  }
+
+  friend constexpr Fixed operator+(Fixed a, Fixed b)
+  {
+    return from_raw(a.raw + b.raw);
+  }
+  friend constexpr Fixed operator-(Fixed a, Fixed b)
+  {
+    return from_raw(a.raw - b.raw);
+  }
+  friend constexpr Fixed operator-(Fixed a)
+  {
+    return from_raw(-a.raw);
+  }
+  friend constexpr Fixed operator*(Fixed a, int b)
+  {
+    return from_raw(a.raw * b);
+  }
+  friend constexpr Fixed operator/(Fixed a, int b)
+  {
+    return from_raw(a.raw / b);
+  }
+
+  // Products round towards negative infinity (>> of a negative s64 is
+  // arithmetic in C++20) and quotients towards zero, on every target
+  friend constexpr Fixed operator*(Fixed a, Fixed b)
+  {
+    return from_raw(static_cast<s32>((static_cast<s64>(a.raw) * b.raw) >> FRACTION_BITS));
+  }
+  friend constexpr Fixed operator/(Fixed a, Fixed b)
+  {
+    return from_raw(static_cast<s32>((static_cast<s64>(a.raw) * ONE) / b.raw));
+  }
+
+  friend constexpr bool operator==(Fixed a, Fixed b)
+  {
+    return a.raw == b.raw;
+  }
+  friend constexpr bool operator<(Fixed a, Fixed b)
+  {
+    return a.raw < b.raw;
+  }
+  friend constexpr bool operator>(Fixed a, Fixed b)
+  {
+    return a.raw > b.raw;
+  }
+  friend constexpr bool operator<=(Fixed a, Fixed b)
+  {
+    return a.raw <= b.raw;
+  }
+  friend constexpr bool operator>=(Fixed a, Fixed b)
+  {
+    return a.raw >= b.raw;
+  }
+};
+
+static_assert(std::is_trivially_copyable_v<Fixed> && sizeof(Fixed) == 4,
+              "Fixed must stay a bare s32");
+
+typedef Fixed Scalar;
+
+// Stored in replay headers (see replay.hpp)
+const u8 SIM_NUMERIC_MODE = 1;
+
+constexpr float to_float(Fixed value)
+{
+  return static_cast<float>(value);
+}
+
+// Nearest whole pixel, halves rounding up (see SpriteMask)
+constexpr int to_pixel(Fixed value)
+{
+  return (value.raw + Fixed::ONE / 2) >> Fixed::FRACTION_BITS;
+}
+
+#else
+
+typedef float Scalar;
+
+const u8 SIM_NUMERIC_MODE = 0;
+
+constexpr float to_float(float value)
+{
+  return value;
+}
+
+constexpr int to_pixel(float value)
+{
+  // Truncation rounds towards zero; step down for negative fractions
+  const float shifted = value + 0.5f;
+  const int whole = static_cast<int>(shifted);
+  return shifted < static_cast<float>(whole) ? whole - 1 : whole;
+}
+
+#endif
+
+// EOF
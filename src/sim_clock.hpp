@@ -0,0 +1,63 @@
+// src/sim_clock.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include "constants.hpp"
+#include "types.hpp"
+
+// Fixed timestep accumulator. Each frame, feed it the current time and run
+// the number of simulation ticks it returns; the leftover fraction of a tick
+// is the interpolation factor for rendering.
+class SimClock
+{
+private:
+  // Time is accumulated in microseconds * SIM_TICK_RATE so one tick is
+  // exactly one million units, with no rounding drift at 50 or 60 Hz.
+  static constexpr u64 TICK_UNITS = 1000000;
+
+  u64 last_time_us;
+  u64 accumulator;
+
+public:
+  explicit SimClock(u64 now_us)
+    : last_time_us(now_us)
+    , accumulator(0)
+  {
+  }
+
+  // Returns the number of ticks to simulate for the time elapsed since the
+  // previous call. Long stalls are clamped so the game never spirals.
+  int advance(u64 now_us)
+  {
+    u64 elapsed_us = now_us - last_time_us;
+    last_time_us = now_us;
+
+    accumulator += elapsed_us * SIM_TICK_RATE;
+
+    int ticks = static_cast<int>(accumulator / TICK_UNITS);
+    accumulator %= TICK_UNITS;
+
+    if (ticks > SIM_MAX_TICKS_PER_FRAME)
+    {
+      ticks = SIM_MAX_TICKS_PER_FRAME;
+    }
+    return ticks;
+  }
+
+  // Fraction of the next tick already elapsed, in [0, 1)
+  float alpha() const
+  {
+    return static_cast<float>(accumulator) / TICK_UNITS;
+  }
+};
+
+// EOF
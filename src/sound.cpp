@@ -0,0 +1,43 @@
+// src/sound.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C Standard Library
+#include <string.h>
+
+// Project headers
+#include "sound.hpp"
+
+static u32 get_u32_be(const u8* in)
+{
+  return (static_cast<u32>(in[0]) << 24) | (static_cast<u32>(in[1]) << 16) |
+         (static_cast<u32>(in[2]) << 8) | in[3];
+}
+
+std::unique_ptr<Sound> open_sound(const u8* data, u32 size)
+{
+  if (size < SOUND_HEADER_SIZE || memcmp(data, SOUND_FILE_MAGIC, 4) != 0 ||
+      data[4] != SOUND_FILE_VERSION || data[5] > SOUND_STEREO16)
+  {
+    return nullptr;
+  }
+
+  const u32 frequency = get_u32_be(data + 8);
+  const u32 length = get_u32_be(data + 12);
+  if (frequency == 0 || length > size - SOUND_HEADER_SIZE)
+  {
+    return nullptr;
+  }
+
+  return std::make_unique<Sound>(data[5], data + SOUND_HEADER_SIZE, length,
+                                 static_cast<f32>(frequency));
+}
+
+// EOF
@@ -11,21 +11,51 @@
 
 #pragma once
 
-#include <gctypes.h>
-#include <vector>
+#include <memory>
+#include "types.hpp"
 
-// Owns the audio buffer to allow for endianness conversion
+// Sample formats (values match AESND's VOICE_* constants)
+const u32 SOUND_MONO8 = 0;
+const u32 SOUND_STEREO8 = 1;
+const u32 SOUND_MONO16 = 2;
+const u32 SOUND_STEREO16 = 3;
+
+// Sound effects are converted from WAV at build time (tools/sfx_convert)
+// into files the console plays where they lie, embedded in the binary:
+//
+//   char magic[4]   "FWSD"
+//   u8   version    SOUND_FILE_VERSION
+//   u8   format     SOUND_MONO8 .. SOUND_STEREO16
+//   u16  reserved   0
+//   u32  frequency  Sample rate in Hz
+//   u32  size       Bytes of sample data
+//   ...             Zeros up to SOUND_HEADER_SIZE
+//   samples         Signed 8-bit or big-endian 16-bit PCM, zero padded to
+//                   a multiple of SOUND_ALIGN
+//
+// Header fields are big-endian like the samples. bin2o starts every file on
+// a SOUND_ALIGN boundary, so the samples start on one too, as AESND's DMA
+// needs, and the padding keeps its last block inside the file.
+const char* const SOUND_FILE_MAGIC = "FWSD";
+const u8 SOUND_FILE_VERSION = 1;
+const u32 SOUND_HEADER_SIZE = 32;
+const u32 SOUND_ALIGN = 32;
+
+// Sample data in the form the voice backend plays. Refers to memory it does
+// not own (a converted file in the binary), which outlives every Sound.
 class Sound
 {
 private:
   const u32 _format;
-  std::vector<u8> _buffer;
+  const u8* const _buffer;
+  const u32 _size;
   const f32 _freq;
 
 public:
-  Sound(u32 format, std::vector<u8> buffer, f32 frequency)
+  Sound(u32 format, const u8* buffer, u32 size, f32 frequency)
     : _format(format)
-    , _buffer(std::move(buffer))
+    , _buffer(buffer)
+    , _size(size)
     , _freq(frequency)
   {
   }
@@ -35,12 +65,12 @@ public:
 
   [[nodiscard]] const u8* GetBufferPtr() const
   {
-    return _buffer.data();
+    return _buffer;
   }
 
   [[nodiscard]] u32 GetSize() const
   {
-    return _buffer.size();
+    return _size;
   }
 
   [[nodiscard]] u32 GetFormat() const
@@ -54,4 +84,8 @@ public:
   }
 };
 
+// A Sound over a converted file, without copying; nullptr if `data` is not
+// one this build can play
+std::unique_ptr<Sound> open_sound(const u8* data, u32 size);
+
 // EOF
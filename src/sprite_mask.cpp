@@ -0,0 +1,142 @@
+// src/sprite_mask.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// System libraries
+#include <png.h>
+
+// Project headers
+#include "sprite_mask.hpp"
+#include "constants.hpp"
+
+// Embedded by the build (bin2o on the console, ld -r -b binary on the host)
+extern "C" {
+    extern const u8 bird_png[];
+    extern const u8 bird_png_end[];
+
+    extern const u8 pipe_png[];
+    extern const u8 pipe_png_end[];
+}
+
+// Alpha channel of an embedded PNG; false if it does not decode
+static bool load_alpha(const u8* data, size_t size, std::vector<u8>& alpha,
+                       int& width, int& height)
+{
+  png_image image = {};
+  image.version = PNG_IMAGE_VERSION;
+  if (!png_image_begin_read_from_memory(&image, data, size))
+  {
+    return false;
+  }
+
+  image.format = PNG_FORMAT_RGBA;
+  std::vector<u8> bytes(PNG_IMAGE_SIZE(image));
+  if (!png_image_finish_read(&image, nullptr, bytes.data(), 0, nullptr))
+  {
+    return false;
+  }
+
+  width = image.width;
+  height = image.height;
+  alpha.resize(static_cast<size_t>(width) * height);
+  for (size_t i = 0; i < alpha.size(); i++)
+  {
+    alpha[i] = bytes[i * 4 + 3];
+  }
+  return true;
+}
+
+// Largest whole number <= value (to_pixel rounds to the nearest)
+static int floor_pixel(Scalar value)
+{
+  return to_pixel(value - Scalar(0.5f));
+}
+
+SpriteMask SpriteMask::from_alpha(const u8* alpha, int texture_width,
+                                  int texture_height, Scalar scale,
+                                  Rotation rotation, Vec2 center,
+                                  const Hitbox& bounds)
+{
+  SpriteMask mask;
+  mask.x = floor_pixel(bounds.left());
+  mask.y = floor_pixel(bounds.top());
+  mask.width = -floor_pixel(-bounds.right()) - mask.x;
+  mask.height = -floor_pixel(-bounds.bottom()) - mask.y;
+  mask.width = mask.width < 64 ? mask.width : 64;
+  mask.rows.assign(mask.height, 0);
+
+  // Texture coordinates of each cell center, as in SoftRenderer::DrawImage
+  const Scalar half = Scalar(0.5f);
+  for (int j = 0; j < mask.height; j++)
+  {
+    const Scalar dy = Scalar(mask.y + j) + half - center.y;
+    for (int i = 0; i < mask.width; i++)
+    {
+      const Scalar dx = Scalar(mask.x + i) + half - center.x;
+      const int u = floor_pixel((rotation.cos * dx + rotation.sin * dy) / scale) +
+                    texture_width / 2;
+      const int v = floor_pixel((rotation.cos * dy - rotation.sin * dx) / scale) +
+                    texture_height / 2;
+      if (u < 0 || u >= texture_width || v < 0 || v >= texture_height)
+      {
+        continue;
+      }
+      if (!alpha ||
+          alpha[static_cast<size_t>(v) * texture_width + u] >= MASK_ALPHA_THRESHOLD)
+      {
+        mask.rows[j] |= u64(1) << i;
+      }
+    }
+  }
+  return mask;
+}
+
+static CollisionMasks build_masks()
+{
+  CollisionMasks masks;
+  std::vector<u8> alpha;
+  int width, height;
+
+  // Without a texture the whole quad is solid
+  if (!load_alpha(bird_png, bird_png_end - bird_png, alpha, width, height))
+  {
+    alpha.clear();
+    width = BIRD_WIDTH;
+    height = BIRD_HEIGHT;
+  }
+  for (int tilt = -TILT_STEPS; tilt <= TILT_STEPS; tilt++)
+  {
+    const BirdShape& shape = bird_shape(tilt);
+    masks.bird.push_back(SpriteMask::from_alpha(
+      alpha.empty() ? nullptr : alpha.data(), width, height, Scalar(BIRD_SCALE),
+      shape.rotation, { shape.center_x, shape.center_y },
+      Hitbox(shape.left, shape.top, shape.right - shape.left,
+             shape.bottom - shape.top)));
+  }
+
+  if (!load_alpha(pipe_png, pipe_png_end - pipe_png, alpha, width, height))
+  {
+    alpha.clear();
+    width = PIPE_WIDTH;
+    height = 1;
+  }
+  masks.pipe = SpriteMask::from_alpha(
+    alpha.empty() ? nullptr : alpha.data(), width, height, 1, { 0, 1 },
+    { Scalar(width / 2), Scalar(height / 2) }, Hitbox(0, 0, width, height));
+  return masks;
+}
+
+const CollisionMasks& collision_masks()
+{
+  static const CollisionMasks masks = build_masks();
+  return masks;
+}
+
+// EOF
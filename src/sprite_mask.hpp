@@ -0,0 +1,67 @@
+// src/sprite_mask.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <vector>
+#include "bird_shape.hpp"
+#include "collision.hpp"
+#include "types.hpp"
+
+// Texels at least this opaque are solid; the soft edge is not
+const u8 MASK_ALPHA_THRESHOLD = 128;
+
+// Opaque pixels of a sprite as DrawImage draws it, one bit per world pixel
+// and one u64 per row (bit i = column i), so at most 64 pixels wide. Cell
+// (0, 0) sits at (x, y) relative to the position the sprite is drawn at.
+struct SpriteMask
+{
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+  std::vector<u64> rows;
+
+  // Sample an alpha channel (one byte per texel, row major; nullptr for a
+  // fully opaque sprite) at each cell's center, the way SoftRenderer picks
+  // the nearest texel. `center` is where DrawImage puts the middle of the
+  // sprite and `bounds` the box around it, both relative to its position.
+  static SpriteMask from_alpha(const u8* alpha, int texture_width,
+                               int texture_height, Scalar scale,
+                               Rotation rotation, Vec2 center,
+                               const Hitbox& bounds);
+
+  // Rows past the bottom repeat the last one (pipes reach past their
+  // texture down to the ground)
+  u64 row(int y) const
+  {
+    return rows[y < height ? y : height - 1];
+  }
+};
+
+struct CollisionMasks
+{
+  std::vector<SpriteMask> bird;  // Per tilt (see bird_shape.hpp)
+  SpriteMask pipe;               // Bottom pipe, lip in row 0; the top
+                                 // pipe is its mirror
+
+  const SpriteMask& bird_at(int tilt) const
+  {
+    return bird[tilt + TILT_STEPS];
+  }
+};
+
+// Built from the alpha channels of bird.png and pipe.png on first use.
+// libpng decodes them on the console and on the host alike, so every build
+// collides against the same masks.
+const CollisionMasks& collision_masks();
+
+// EOF
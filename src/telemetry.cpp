@@ -0,0 +1,225 @@
+// src/telemetry.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C Standard Library
+#include <string.h>
+
+// Project headers
+#include "telemetry.hpp"
+#include "constants.hpp"
+
+// ============================================================================
+// Records
+// ============================================================================
+
+static void put_u16(u8* out, u16 value)
+{
+  out[0] = static_cast<u8>(value);
+  out[1] = static_cast<u8>(value >> 8);
+}
+
+static void put_u32(u8* out, u32 value)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    out[i] = static_cast<u8>(value >> (8 * i));
+  }
+}
+
+static u16 get_u16(const u8* in)
+{
+  return static_cast<u16>(in[0] | (in[1] << 8));
+}
+
+static u32 get_u32(const u8* in)
+{
+  return static_cast<u32>(in[0]) | (static_cast<u32>(in[1]) << 8) |
+         (static_cast<u32>(in[2]) << 16) | (static_cast<u32>(in[3]) << 24);
+}
+
+void encode_run_record(const RunRecord& record, u8* out)
+{
+  out[0] = TELEMETRY_VERSION;
+  out[1] = record.mode;
+  out[2] = record.cause;
+  out[3] = record.numeric_mode;
+  put_u16(out + 4, record.tick_rate);
+  put_u16(out + 6, record.score);
+  put_u32(out + 8, record.seed);
+  put_u32(out + 12, record.ticks);
+  put_u32(out + 16, record.flaps);
+  put_u32(out + 20, record.frames);
+  for (int i = 0; i < 4; i++)
+  {
+    put_u16(out + 24 + 2 * i, record.frame_us[i]);
+  }
+}
+
+bool decode_run_record(const u8* in, RunRecord& record)
+{
+  if (in[0] != TELEMETRY_VERSION)
+  {
+    return false;
+  }
+
+  record.mode = in[1];
+  record.cause = in[2];
+  record.numeric_mode = in[3];
+  record.tick_rate = get_u16(in + 4);
+  record.score = get_u16(in + 6);
+  record.seed = get_u32(in + 8);
+  record.ticks = get_u32(in + 12);
+  record.flaps = get_u32(in + 16);
+  record.frames = get_u32(in + 20);
+  for (int i = 0; i < 4; i++)
+  {
+    record.frame_us[i] = get_u16(in + 24 + 2 * i);
+  }
+  return true;
+}
+
+// ============================================================================
+// FrameTimes
+// ============================================================================
+
+static u16 clamp_u16(u32 value)
+{
+  return static_cast<u16>(value < 0xFFFF ? value : 0xFFFF);
+}
+
+FrameTimes::FrameTimes()
+{
+  clear();
+}
+
+void FrameTimes::clear()
+{
+  memset(bins, 0, sizeof(bins));
+  frames = 0;
+  max_us = 0;
+}
+
+void FrameTimes::add(u32 micros)
+{
+  const u32 bin = micros / BIN_US;
+  bins[bin < BINS ? bin : BINS - 1]++;
+  frames++;
+  max_us = micros > max_us ? micros : max_us;
+}
+
+u16 FrameTimes::percentile(int percent) const
+{
+  if (frames == 0)
+  {
+    return 0;
+  }
+
+  // Smallest bin with at least `percent` of the frames at or below it
+  const u64 target = (static_cast<u64>(frames) * percent + 99) / 100;
+  u64 seen = 0;
+  int bin = 0;
+  for (; bin < BINS - 1; bin++)
+  {
+    seen += bins[bin];
+    if (seen >= target)
+    {
+      break;
+    }
+  }
+
+  const u32 edge = (bin + 1) * BIN_US;
+  return clamp_u16(edge < max_us ? edge : max_us);
+}
+
+u16 FrameTimes::longest() const
+{
+  return clamp_u16(max_us);
+}
+
+// ============================================================================
+// TelemetryLog
+// ============================================================================
+
+TelemetryLog::TelemetryLog(Storage& storage)
+  : storage(storage)
+{
+}
+
+void TelemetryLog::push(const RunRecord& record)
+{
+  if (pushed - written == RING_RECORDS)
+  {
+    dropped++;
+    return;
+  }
+
+  encode_run_record(record, ring + (pushed % RING_RECORDS) * TELEMETRY_RECORD_SIZE);
+  pushed++;
+}
+
+void TelemetryLog::poll()
+{
+  if (in_flight > 0)
+  {
+    const int result = storage.PollAppend();
+    if (result == IO_PENDING)
+    {
+      return;
+    }
+
+    // A failed batch is not retried: with no card it would only fail again
+    if (result != static_cast<int>(in_flight * TELEMETRY_RECORD_SIZE))
+    {
+      dropped += in_flight;
+    }
+    written += in_flight;
+    in_flight = 0;
+  }
+
+  if (pushed - written < FLUSH_BATCH)
+  {
+    return;
+  }
+
+  // One contiguous piece of the ring; the rest goes next time
+  const u32 start = written % RING_RECORDS;
+  const u32 waiting = pushed - written;
+  const u32 count = waiting < RING_RECORDS - start ? waiting : RING_RECORDS - start;
+  if (storage.AppendFileAsync(TELEMETRY_PATH, ring + start * TELEMETRY_RECORD_SIZE,
+                              count * TELEMETRY_RECORD_SIZE))
+  {
+    in_flight = count;
+  }
+}
+
+void TelemetryLog::flush()
+{
+  while (in_flight > 0)
+  {
+    SleepMicros(1000);
+    poll();
+  }
+
+  while (pushed != written)
+  {
+    const u32 start = written % RING_RECORDS;
+    const u32 waiting = pushed - written;
+    const u32 count = waiting < RING_RECORDS - start ? waiting : RING_RECORDS - start;
+    if (!storage.AppendFile(TELEMETRY_PATH, ring + start * TELEMETRY_RECORD_SIZE,
+                            count * TELEMETRY_RECORD_SIZE))
+    {
+      dropped += count;
+    }
+    written += count;
+  }
+}
+
+// EOF
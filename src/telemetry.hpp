@@ -0,0 +1,138 @@
+// src/telemetry.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <stddef.h>
+#include "platform.hpp"
+#include "types.hpp"
+
+// Telemetry file layout: TELEMETRY_PATH holds one record per finished run,
+// back to back in the order the runs ended. Each record is
+// TELEMETRY_RECORD_SIZE bytes (all multi-byte fields little-endian):
+//
+//   u8  version      TELEMETRY_VERSION
+//   u8  mode         TelemetryMode
+//   u8  cause        Surface the bird died on (see physics.hpp)
+//   u8  numeric      SIM_NUMERIC_MODE
+//   u16 tick_rate    SIM_TICK_RATE
+//   u16 score        Score at death
+//   u32 seed         Run seed
+//   u32 ticks        Ticks of live play survived
+//   u32 flaps        Flaps the bird made
+//   u32 frames       Frames timed during the run
+//   u16 frame_us[4]  Frame time at the 50th, 90th and 99th percentile and
+//                    the longest frame, in microseconds
+//
+// Fixed-size records let a reader seek to any run, and a file cut short
+// by a power loss loses at most its last, partial record.
+
+const u8 TELEMETRY_VERSION = 1;
+const size_t TELEMETRY_RECORD_SIZE = 32;
+
+enum class TelemetryMode : u8
+{
+  Player,
+  GhostRace,
+  Practice,
+  Autopilot
+};
+
+struct RunRecord
+{
+  u8 mode = 0;
+  u8 cause = 0;
+  u8 numeric_mode = 0;
+  u16 tick_rate = 0;
+  u16 score = 0;
+  u32 seed = 0;
+  u32 ticks = 0;
+  u32 flaps = 0;
+  u32 frames = 0;
+  u16 frame_us[4] = {};
+};
+
+void encode_run_record(const RunRecord& record, u8* out);
+
+// False if the record is from another version of the layout
+bool decode_run_record(const u8* in, RunRecord& record);
+
+// Frame times of one run as a histogram, so percentiles need no sample
+// list. Bins are BIN_US wide; anything past the last one lands in it.
+class FrameTimes
+{
+public:
+  static const u32 BIN_US = 128;
+  static const int BINS = 512;
+
+  FrameTimes();
+
+  void clear();
+  void add(u32 micros);
+
+  u32 count() const
+  {
+    return frames;
+  }
+
+  // Upper edge of the bin holding the given percentile (never past the
+  // longest frame), clamped to u16
+  u16 percentile(int percent) const;
+  u16 longest() const;
+
+private:
+  u32 bins[BINS];
+  u32 frames;
+  u32 max_us;
+};
+
+// Records waiting for the card, in a ring. Finished runs are added by the
+// game loop; once FLUSH_BATCH of them are waiting, poll() hands them to
+// Storage::AppendFileAsync in one piece and the loop goes on while the
+// background thread writes them. A full ring drops new records (counted)
+// rather than wait.
+class TelemetryLog
+{
+public:
+  static const u32 RING_RECORDS = 64;
+  static const u32 FLUSH_BATCH = 8;
+
+  explicit TelemetryLog(Storage& storage);
+
+  void push(const RunRecord& record);
+
+  // Finish and start background appends; cheap, call every tick
+  void poll();
+
+  // Write out everything still waiting, blocking (at shutdown)
+  void flush();
+
+  u32 get_dropped() const
+  {
+    return dropped;
+  }
+
+  // Records waiting or being written
+  u32 pending() const
+  {
+    return pushed - written;
+  }
+
+private:
+  Storage& storage;
+  u8 ring[RING_RECORDS * TELEMETRY_RECORD_SIZE];
+  u32 pushed = 0;     // Records ever pushed
+  u32 written = 0;    // Records written out (or given up on)
+  u32 in_flight = 0;  // Records in the background append, from `written`
+  u32 dropped = 0;
+};
+
+// EOF
@@ -0,0 +1,109 @@
+// src/text_format.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Project headers
+#include "text_format.hpp"
+
+TextWriter::TextWriter(char* text, u32 capacity)
+  : text(text)
+  , capacity(capacity)
+  , used(0)
+{
+  if (capacity > 0)
+  {
+    text[0] = '\0';
+  }
+}
+
+TextWriter& TextWriter::put(const char* string)
+{
+  while (*string)
+  {
+    put(*string++);
+  }
+  return *this;
+}
+
+TextWriter& TextWriter::put(char c)
+{
+  if (used + 1 < capacity)
+  {
+    text[used++] = c;
+    text[used] = '\0';
+  }
+  return *this;
+}
+
+TextWriter& TextWriter::put(int value)
+{
+  // Digits come out last first; u32 keeps the most negative value whole
+  char digits[10];
+  int count = 0;
+  u32 magnitude = value < 0 ? 0u - static_cast<u32>(value) : static_cast<u32>(value);
+  do
+  {
+    digits[count++] = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude > 0);
+
+  if (value < 0)
+  {
+    put('-');
+  }
+  while (count > 0)
+  {
+    put(digits[--count]);
+  }
+  return *this;
+}
+
+TextWriter& TextWriter::put_tenths(u32 tenths)
+{
+  put(static_cast<int>(tenths / 10));
+  put('.');
+  return put(static_cast<char>('0' + tenths % 10));
+}
+
+TextWriter& TextWriter::pad_to(u32 column)
+{
+  while (used < column && used + 1 < capacity)
+  {
+    put(' ');
+  }
+  return *this;
+}
+
+bool parse_int(const char* text, u32 size, int& value)
+{
+  u32 pos = 0;
+  const bool negative = size > 0 && text[0] == '-';
+  if (negative)
+  {
+    pos++;
+  }
+
+  u32 magnitude = 0;
+  const u32 first_digit = pos;
+  while (pos < size && text[pos] >= '0' && text[pos] <= '9')
+  {
+    magnitude = magnitude * 10 + static_cast<u32>(text[pos] - '0');
+    pos++;
+  }
+  if (pos == first_digit)
+  {
+    return false;
+  }
+
+  value = static_cast<int>(negative ? 0u - magnitude : magnitude);
+  return true;
+}
+
+// EOF
@@ -0,0 +1,53 @@
+// src/text_format.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include "types.hpp"
+
+// Text for the screen and the save files without the printf family, which
+// would pull newlib's formatter (and its locale and floating point
+// support) into the console binary. Nothing here allocates.
+
+// Writes into a caller's buffer, always keeping it terminated. Text that
+// does not fit is cut off.
+class TextWriter
+{
+public:
+  TextWriter(char* text, u32 capacity);
+
+  TextWriter& put(const char* text);
+  TextWriter& put(char c);
+  TextWriter& put(int value);
+
+  // A count of tenths as a decimal, e.g. 123 as "12.3"
+  TextWriter& put_tenths(u32 tenths);
+
+  // Spaces up to `column`, if the text is not already that long
+  TextWriter& pad_to(u32 column);
+
+  u32 length() const
+  {
+    return used;
+  }
+
+private:
+  char* text;
+  u32 capacity;
+  u32 used;
+};
+
+// Decimal integer at the start of `text` (an optional '-', then digits,
+// ending at `size` bytes or the first other character). False if there
+// are no digits.
+bool parse_int(const char* text, u32 size, int& value);
+
+// EOF
@@ -11,10 +11,12 @@
 
 #pragma once
 
+#include "scalar.hpp"
+
 struct Vec2
 {
-  float x;
-  float y;
+  Scalar x;
+  Scalar y;
 };
 
 // EOF
@@ -11,10 +11,11 @@
 
 #pragma once
 
-#include <gctypes.h>
+#include "types.hpp"
 #include "sound.hpp"
 
-// Forward declarations
+// Forward declarations (defined by the audio backend: AESND on the Wii,
+// a software mixer on the host)
 struct aesndpb_t;
 
 class Voice
@@ -30,9 +31,18 @@ public:
 
   void SetVolume(u16 Volume);
   void SetVolume(u16 LeftVolume, u16 RightVolume);
-  void Play(const Sound& sound, u32 delay = 0, bool looped = false);
+  // Pitch scales the sound's sample rate
+  void Play(const Sound& sound, u32 delay = 0, bool looped = false, f32 pitch = 1.0f);
   void Stop();
   void Mute(bool mute);
+
+  // Backend lifecycle, driven by Audio
+  static void InitBackend();
+  static void ShutdownBackend();
+
+  // Microseconds on the clock the voices play by: the console's timer, or
+  // the output the host mixer has rendered so far
+  static u64 PlaybackMicros();
 };
 
 // EOF
@@ -0,0 +1,123 @@
+// src/voice_pool.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Project headers
+#include "voice_pool.hpp"
+
+static u32 bytes_per_frame(u32 format)
+{
+  switch (format)
+  {
+    case SOUND_MONO8:
+      return 1;
+    case SOUND_STEREO8:
+    case SOUND_MONO16:
+      return 2;
+    default:
+      return 4;
+  }
+}
+
+// How long the sound plays at `pitch`, in microseconds
+static u64 duration_micros(const Sound& sound, f32 pitch)
+{
+  const f64 rate = static_cast<f64>(sound.GetFrequency()) * pitch;
+  if (rate <= 0)
+  {
+    return 0;
+  }
+  const f64 frames = sound.GetSize() / bytes_per_frame(sound.GetFormat());
+  return static_cast<u64>(frames * 1000000.0 / rate);
+}
+
+bool VoicePool::play(const Sound& sound, u8 priority, u16 volume, f32 pitch, u64 now)
+{
+  const int index = choose(priority, now);
+  if (index < 0)
+  {
+    dropped++;
+    return false;
+  }
+
+  Slot& slot = slots[index];
+  if (slot.end > now)
+  {
+    stolen++;
+  }
+  slot.start = now;
+  slot.end = now + duration_micros(sound, pitch);
+  slot.priority = priority;
+  slot.volume = volume;
+
+  voices[index].SetVolume(volume);
+  voices[index].Play(sound, 0, false, pitch);
+  return true;
+}
+
+void VoicePool::stop_all()
+{
+  for (int i = 0; i < VOICES; i++)
+  {
+    voices[i].Stop();
+    slots[i].end = 0;
+  }
+}
+
+int VoicePool::active(u64 now) const
+{
+  int count = 0;
+  for (const Slot& slot : slots)
+  {
+    count += slot.end > now;
+  }
+  return count;
+}
+
+// A free voice, else the least important playing one no more important
+// than `priority`, else -1
+int VoicePool::choose(u8 priority, u64 now) const
+{
+  int best = -1;
+  for (int i = 0; i < VOICES; i++)
+  {
+    const Slot& slot = slots[i];
+    if (slot.end <= now)
+    {
+      return i;
+    }
+    if (slot.priority > priority)
+    {
+      continue;
+    }
+
+    if (best < 0)
+    {
+      best = i;
+      continue;
+    }
+    const Slot& other = slots[best];
+    if (slot.priority != other.priority)
+    {
+      best = slot.priority < other.priority ? i : best;
+    }
+    else if (slot.volume != other.volume)
+    {
+      best = slot.volume < other.volume ? i : best;
+    }
+    else if (slot.start < other.start)
+    {
+      best = i;
+    }
+  }
+  return best;
+}
+
+// EOF
@@ -0,0 +1,79 @@
+// src/voice_pool.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include "sound.hpp"
+#include "types.hpp"
+#include "voice.hpp"
+
+// A fixed set of voices shared by every sound effect, played fire and
+// forget. A sound takes a voice that has finished; with none free it takes
+// over the least important voice still playing: the lowest priority, then
+// the quietest, then the oldest. It never cuts off a sound of higher
+// priority, and is dropped instead.
+//
+// Whether a voice has finished is worked out from the sound's length, the
+// pitch and the time it started, so nothing is asked of the backend. The
+// voice count bounds the DSP's work however many sounds the game starts,
+// and each play costs one pass over the voices.
+//
+// The backend must be up (Voice::InitBackend) before the pool is made.
+class VoicePool
+{
+public:
+  static const int VOICES = 8;
+
+  VoicePool() = default;
+
+  VoicePool(VoicePool const&) = delete;
+  VoicePool& operator=(VoicePool const&) = delete;
+
+  // Start `sound` at `now` (microseconds, any steady clock). Volume is 0 to
+  // 255; pitch scales the sample rate. Returns false if the sound was
+  // dropped.
+  bool play(const Sound& sound, u8 priority, u16 volume, f32 pitch, u64 now);
+
+  // Silence every voice
+  void stop_all();
+
+  // Voices still playing at `now`
+  int active(u64 now) const;
+
+  // Sounds that took a playing voice, and sounds dropped, so far
+  u32 get_stolen() const
+  {
+    return stolen;
+  }
+
+  u32 get_dropped() const
+  {
+    return dropped;
+  }
+
+private:
+  struct Slot
+  {
+    u64 start = 0;
+    u64 end = 0;     // When the sound runs out; 0 for an idle voice
+    u8 priority = 0;
+    u16 volume = 0;
+  };
+
+  Voice voices[VOICES];
+  Slot slots[VOICES];
+  u32 stolen = 0;
+  u32 dropped = 0;
+
+  int choose(u8 priority, u64 now) const;
+};
+
+// EOF
@@ -0,0 +1,249 @@
+// src/wii/flapwii.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2021-2025 TheBlueOompaLoompa
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C++ Standard Library
+#include <memory>
+
+// System headers
+#include <gccore.h>
+
+// Project headers
+#include "audio.hpp"
+#include "boot_profile.hpp"
+#include "constants.hpp"
+#include "game_state.hpp"
+#include "sim_clock.hpp"
+#include "sprite_mask.hpp"
+#include "wii_platform.hpp"
+
+#ifdef FLAPWII_SERIAL_BOOT
+static const char* const BOOT_HEADING = "Boot (serial)";
+#else
+static const char* const BOOT_HEADING = "Boot (overlapped)";
+#endif
+
+// ============================================================================
+// Startup
+// ============================================================================
+
+// What main shares with the startup tasks. Each field is written by one
+// thread and read by another only after joining it.
+struct Boot
+{
+  BootProfile profile;
+  FatStorage storage;
+  GrrlibRenderer* renderer = nullptr;
+  std::unique_ptr<GameState> game;
+  u32 seed;
+
+  // The report, appended to BOOT_LOG_PATH in the background
+  char log[512];
+
+  explicit Boot(u64 origin)
+    : profile(origin)
+    , seed(static_cast<u32>(origin))
+  {
+  }
+};
+
+// Decoding with no hardware behind it, so GameState finds both ready
+static void load_assets(void* context)
+{
+  Boot& boot = *static_cast<Boot*>(context);
+
+  boot.profile.begin(BootPhase::Sounds);
+  sound_bank();
+  boot.profile.end(BootPhase::Sounds);
+
+  boot.profile.begin(BootPhase::Masks);
+  collision_masks();
+  boot.profile.end(BootPhase::Masks);
+}
+
+static void load_storage(void* context)
+{
+  Boot& boot = *static_cast<Boot*>(context);
+
+  boot.profile.begin(BootPhase::Storage);
+  boot.storage.Mount();
+  boot.profile.end(BootPhase::Storage);
+}
+
+static void load_fonts(void* context)
+{
+  Boot& boot = *static_cast<Boot*>(context);
+
+  boot.profile.begin(BootPhase::Fonts);
+  boot.renderer->LoadFonts();
+  boot.profile.end(BootPhase::Fonts);
+}
+
+// Builds the game, which reads the high score and the replays from the card
+// and brings up AESND and its voices. Always on the main thread, after the
+// video system and WPAD, as before startup was overlapped: the audio
+// hardware is not started alongside GRRLIB_Init.
+static void load_game(Boot& boot)
+{
+  boot.profile.begin(BootPhase::Game);
+  boot.game = std::make_unique<GameState>(boot.storage, boot.seed);
+  boot.profile.end(BootPhase::Game);
+}
+
+// The phase times in the top left corner, over whatever is on screen
+static void draw_boot_report(Renderer& renderer, const BootProfile& profile)
+{
+  static const int LINE_HEIGHT = 16;
+
+  char lines[BootProfile::PHASES + 1][64];
+  int count = 0;
+  for (int line = 0; line <= BootProfile::PHASES; line++)
+  {
+    if (profile.format_line(line, lines[count], sizeof(lines[count])))
+    {
+      count++;
+    }
+  }
+
+  renderer.Rectangle(8, 8, 250, 8 + count * LINE_HEIGHT, 0x00000080, true);
+  for (int line = 0; line < count; line++)
+  {
+    renderer.PrintText(14, 12 + line * LINE_HEIGHT, FontId::Score, lines[line], 12,
+                       GRRLIB_WHITE);
+  }
+}
+
+// ============================================================================
+// Main Loop
+// ============================================================================
+
+int main(void)
+{
+  Boot boot(GetTimeMicros());
+
+#ifdef FLAPWII_SERIAL_BOOT
+  // The order startup had before it was overlapped, as the baseline
+  boot.profile.begin(BootPhase::Video);
+  GrrlibRenderer renderer;
+  boot.profile.end(BootPhase::Video);
+  boot.renderer = &renderer;
+
+  boot.profile.begin(BootPhase::Textures);
+  renderer.LoadTextures();
+  boot.profile.end(BootPhase::Textures);
+  load_fonts(&boot);
+
+  boot.profile.begin(BootPhase::Input);
+  WpadInput input;
+  boot.profile.end(BootPhase::Input);
+
+  load_storage(&boot);
+  load_assets(&boot);
+  load_game(boot);
+  boot.profile.begin(BootPhase::FirstFrame);
+#else
+  // The card mount and the asset decoding need nothing from the video
+  // system, so they run while it comes up
+  BootTask storage_task(load_storage, &boot);
+  BootTask assets(load_assets, &boot);
+
+  boot.profile.begin(BootPhase::Video);
+  GrrlibRenderer renderer;
+  boot.profile.end(BootPhase::Video);
+
+  boot.renderer = &renderer;
+  BootTask fonts(load_fonts, &boot);
+
+  boot.profile.begin(BootPhase::Textures);
+  renderer.LoadTextures();
+  boot.profile.end(BootPhase::Textures);
+
+  boot.profile.begin(BootPhase::Input);
+  WpadInput input;
+  boot.profile.end(BootPhase::Input);
+
+  storage_task.join();
+  assets.join();
+  load_game(boot);
+
+  boot.profile.begin(BootPhase::FirstFrame);
+  fonts.join();
+#endif
+  GameState& game = *boot.game;
+
+  SimClock clock(GetTimeMicros());
+  u64 frame_start = GetTimeMicros();
+  u64 report_until = 0;
+  bool first_frame = true;
+
+  // Buttons pressed since the last simulation tick. On frames that run no
+  // tick (tick rate below refresh rate) they carry over to the next one.
+  InputState pending;
+
+  while (1)
+  {
+    renderer.FillScreen(0x0195c3ff);
+
+    InputState state = input.Poll();
+
+    if (state.buttons & INPUT_BUTTON_HOME)
+    {
+      break;
+    }
+
+    pending.buttons |= state.buttons;
+    pending.held = state.held;
+    pending.pointer_x = state.pointer_x;
+    pending.pointer_y = state.pointer_y;
+
+    // Frame to frame, so a missed retrace shows up in the telemetry
+    const u64 now = GetTimeMicros();
+    game.record_frame_time(static_cast<u32>(now - frame_start));
+    frame_start = now;
+
+    // Run as many fixed ticks as real time demands: 1.2 per frame on PAL,
+    // 1 on NTSC at the default 60 Hz tick rate
+    int ticks = clock.advance(now);
+    for (int i = 0; i < ticks; i++)
+    {
+      game.update(pending);
+      pending.buttons = 0;  // A press only acts on one tick
+    }
+
+    game.render(renderer, clock.alpha());
+
+    if (state.buttons != 0)
+    {
+      report_until = 0;
+    }
+    if (now < report_until)
+    {
+      draw_boot_report(renderer, boot.profile);
+    }
+
+    renderer.Present();
+
+    if (first_frame)
+    {
+      first_frame = false;
+      boot.profile.end(BootPhase::FirstFrame);
+      report_until = GetTimeMicros() + BOOT_REPORT_SECONDS * 1000000ull;
+
+      const u32 length = boot.profile.format(BOOT_HEADING, boot.log, sizeof(boot.log));
+      boot.storage.AppendFileAsync(BOOT_LOG_PATH, boot.log, length);
+    }
+  }
+
+  // Save before the video system goes
+  boot.game.reset();
+  return 0;
+}
+
+// EOF
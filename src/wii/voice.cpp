@@ -1,4 +1,4 @@
-// src/voice.cpp
+// src/wii/voice.cpp
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
 // Flapwii Bird
@@ -11,6 +11,27 @@
 
 #include "voice.hpp"
 #include <aesndlib.h>
+#include "platform.hpp"
+
+static_assert(SOUND_MONO8 == VOICE_MONO8 && SOUND_STEREO8 == VOICE_STEREO8 &&
+              SOUND_MONO16 == VOICE_MONO16 && SOUND_STEREO16 == VOICE_STEREO16,
+              "Sound formats must map directly onto AESND voice formats");
+
+void Voice::InitBackend()
+{
+  AESND_Init();
+  AESND_Pause(false);
+}
+
+void Voice::ShutdownBackend()
+{
+  AESND_Pause(true);
+}
+
+u64 Voice::PlaybackMicros()
+{
+  return GetTimeMicros();
+}
 
 Voice::Voice()
 {
@@ -32,10 +53,10 @@ void Voice::SetVolume(u16 LeftVolume, u16 RightVolume)
   AESND_SetVoiceVolume(_Voice, LeftVolume, RightVolume);
 }
 
-void Voice::Play(const Sound& sound, u32 delay, bool looped)
+void Voice::Play(const Sound& sound, u32 delay, bool looped, f32 pitch)
 {
   AESND_PlayVoice(_Voice, sound.GetFormat(), sound.GetBufferPtr(),
-                  sound.GetSize(), sound.GetFrequency(), delay, looped);
+                  sound.GetSize(), sound.GetFrequency() * pitch, delay, looped);
 }
 
 void Voice::Stop()
@@ -0,0 +1,412 @@
+// src/wii/wii_platform.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// C Standard Library
+#include <string.h>
+
+// System libraries
+#include <fcntl.h>
+#include <unistd.h>
+#include <fat.h>
+#include <ogc/lwp_watchdog.h>
+#include <wiiuse/wpad.h>
+
+// Project headers
+#include "wii_platform.hpp"
+
+// Generated asset headers
+#include "bird_png.h"
+#include "flappy_ttf.h"
+#include "font_ttf.h"
+#include "pipe_png.h"
+
+static_assert(INPUT_BUTTON_A == WPAD_BUTTON_A &&
+              INPUT_BUTTON_B == WPAD_BUTTON_B &&
+              INPUT_BUTTON_HOME == WPAD_BUTTON_HOME &&
+              INPUT_BUTTON_PLUS == WPAD_BUTTON_PLUS &&
+              INPUT_BUTTON_MINUS == WPAD_BUTTON_MINUS,
+              "Input button bits must match WPAD button bits");
+
+// ============================================================================
+// GrrlibRenderer
+// ============================================================================
+
+GrrlibRenderer::GrrlibRenderer()
+{
+  GRRLIB_Init();
+}
+
+GrrlibRenderer::~GrrlibRenderer()
+{
+  if (score_font)
+  {
+    GRRLIB_FreeTTF(score_font);
+  }
+  if (title_font)
+  {
+    GRRLIB_FreeTTF(title_font);
+  }
+  if (bird_tex)
+  {
+    GRRLIB_FreeTexture(bird_tex);
+  }
+  if (pipe_tex)
+  {
+    GRRLIB_FreeTexture(pipe_tex);
+  }
+  GRRLIB_Exit();
+}
+
+void GrrlibRenderer::LoadTextures()
+{
+  bird_tex = GRRLIB_LoadTexture(bird_png);
+  pipe_tex = GRRLIB_LoadTexture(pipe_png);
+}
+
+void GrrlibRenderer::LoadFonts()
+{
+  score_font = GRRLIB_LoadTTF(font_ttf, font_ttf_size);
+  title_font = GRRLIB_LoadTTF(flappy_ttf, flappy_ttf_size);
+}
+
+GRRLIB_texImg* GrrlibRenderer::get_texture(TextureId texture) const
+{
+  return texture == TextureId::Bird ? bird_tex : pipe_tex;
+}
+
+GRRLIB_ttfFont* GrrlibRenderer::get_font(FontId font) const
+{
+  return font == FontId::Title ? title_font : score_font;
+}
+
+void GrrlibRenderer::FillScreen(u32 color)
+{
+  GRRLIB_FillScreen(color);
+}
+
+void GrrlibRenderer::Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color,
+                               bool filled)
+{
+  GRRLIB_Rectangle(x, y, width, height, color, filled);
+}
+
+void GrrlibRenderer::Plot(f32 x, f32 y, u32 color)
+{
+  GRRLIB_Plot(x, y, color);
+}
+
+void GrrlibRenderer::DrawImage(f32 x, f32 y, TextureId texture, f32 degrees,
+                               f32 scale_x, f32 scale_y, u32 color)
+{
+  GRRLIB_DrawImg(x, y, get_texture(texture), degrees, scale_x, scale_y, color);
+}
+
+void GrrlibRenderer::PrintText(int x, int y, FontId font, const char* text,
+                               u32 size, u32 color)
+{
+  GRRLIB_PrintfTTF(x, y, get_font(font), text, size, color);
+}
+
+void GrrlibRenderer::Present()
+{
+  GRRLIB_Render();
+}
+
+// ============================================================================
+// WpadInput
+// ============================================================================
+
+WpadInput::WpadInput()
+{
+  WPAD_Init();
+  WPAD_SetDataFormat(WPAD_CHAN_0, WPAD_FMT_BTNS_ACC_IR);
+}
+
+InputState WpadInput::Poll()
+{
+  ir_t ir;
+  InputState state;
+
+  WPAD_ScanPads();
+  WPAD_IR(WPAD_CHAN_0, &ir);
+
+  state.buttons = WPAD_ButtonsDown(WPAD_CHAN_0);
+  state.held = WPAD_ButtonsHeld(WPAD_CHAN_0);
+  state.pointer_x = ir.sx;
+  state.pointer_y = ir.sy;
+  return state;
+}
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+u64 GetTimeMicros()
+{
+  return ticks_to_microsecs(gettime());
+}
+
+void SleepMicros(u32 micros)
+{
+  usleep(micros);
+}
+
+// ============================================================================
+// FatStorage
+// ============================================================================
+
+// Below the main thread, so reads only fill the time it spends waiting
+static const u32 WORKER_STACK_SIZE = 16 * 1024;
+static const u8 WORKER_PRIORITY = 40;
+
+FatStorage::~FatStorage()
+{
+  if (worker == LWP_THREAD_NULL)
+  {
+    return;
+  }
+
+  // The worker serves whatever is still busy before it sees the flag, so
+  // an append left running at exit (boot.log, telemetry) reaches the card
+  stopping = true;
+  LWP_SemPost(wake);
+  LWP_JoinThread(worker, nullptr);
+  LWP_SemDestroy(wake);
+}
+
+bool FatStorage::Mount()
+{
+  return fatInitDefault();
+}
+
+// Plain descriptors rather than stdio: no FILE buffers to allocate and
+// copy through, and no stdio in the binary
+
+// Until `size` bytes are read or the file ends; -1 on an error
+static int read_all(int file, void* buffer, u32 size)
+{
+  u8* out = static_cast<u8*>(buffer);
+  u32 total = 0;
+  while (total < size)
+  {
+    const ssize_t got = read(file, out + total, size - total);
+    if (got < 0)
+    {
+      return -1;
+    }
+    if (got == 0)
+    {
+      break;
+    }
+    total += static_cast<u32>(got);
+  }
+  return static_cast<int>(total);
+}
+
+static bool write_all(int file, const void* data, u32 size)
+{
+  const u8* in = static_cast<const u8*>(data);
+  u32 total = 0;
+  while (total < size)
+  {
+    const ssize_t put = write(file, in + total, size - total);
+    if (put <= 0)
+    {
+      return false;
+    }
+    total += static_cast<u32>(put);
+  }
+  return true;
+}
+
+// Writes `size` bytes with the given open flags; false on any failure
+static bool write_file(const char* path, int flags, const void* data, u32 size)
+{
+  const int file = open(path, O_WRONLY | O_CREAT | flags, 0666);
+  if (file < 0)
+  {
+    return false;
+  }
+
+  const bool ok = write_all(file, data, size);
+  return close(file) == 0 && ok;
+}
+
+int FatStorage::ReadFile(const char* path, void* buffer, u32 capacity)
+{
+  const int file = open(path, O_RDONLY);
+  if (file < 0)
+  {
+    return -1;
+  }
+
+  const int result = read_all(file, buffer, capacity);
+  close(file);
+  return result;
+}
+
+bool FatStorage::WriteFile(const char* path, const void* data, u32 size)
+{
+  // The file may be the one being read; sleeping lets the worker run
+  while (read.busy)
+  {
+    SleepMicros(1000);
+  }
+
+  return write_file(path, O_TRUNC, data, size);
+}
+
+bool FatStorage::AppendFile(const char* path, const void* data, u32 size)
+{
+  // Keep the order of anything still being appended
+  while (append.busy)
+  {
+    SleepMicros(1000);
+  }
+
+  return write_file(path, O_APPEND, data, size);
+}
+
+bool FatStorage::ReadFileAsync(const char* path, u32 offset, void* buffer,
+                               u32 size)
+{
+  return start(read, path, offset, buffer, size);
+}
+
+bool FatStorage::AppendFileAsync(const char* path, const void* data, u32 size)
+{
+  return start(append, path, 0, const_cast<void*>(data), size);
+}
+
+int FatStorage::PollRead()
+{
+  return read.busy ? IO_PENDING : read.result;
+}
+
+int FatStorage::PollAppend()
+{
+  return append.busy ? IO_PENDING : append.result;
+}
+
+bool FatStorage::start(Request& request, const char* path, u32 offset,
+                       void* buffer, u32 size)
+{
+  if (request.busy || strlen(path) >= sizeof(request.path))
+  {
+    return false;
+  }
+
+  if (worker == LWP_THREAD_NULL)
+  {
+    LWP_SemInit(&wake, 0, 4);
+    if (LWP_CreateThread(&worker, serve, this, nullptr, WORKER_STACK_SIZE,
+                         WORKER_PRIORITY) < 0)
+    {
+      worker = LWP_THREAD_NULL;
+      LWP_SemDestroy(wake);
+      return false;
+    }
+  }
+
+  strcpy(request.path, path);
+  request.offset = offset;
+  request.buffer = buffer;
+  request.size = size;
+  request.busy = true;
+  LWP_SemPost(wake);
+  return true;
+}
+
+void* FatStorage::serve(void* storage)
+{
+  FatStorage& self = *static_cast<FatStorage*>(storage);
+  for (;;)
+  {
+    LWP_SemWait(self.wake);
+
+    // One post per request, but a wake-up may find both waiting
+    if (self.read.busy)
+    {
+      Request& request = self.read;
+      int result = -1;
+      const int file = open(request.path, O_RDONLY);
+      if (file >= 0)
+      {
+        if (lseek(file, request.offset, SEEK_SET) >= 0)
+        {
+          result = read_all(file, request.buffer, request.size);
+        }
+        close(file);
+      }
+      request.result = result;
+      request.busy = false;
+    }
+
+    if (self.append.busy)
+    {
+      Request& request = self.append;
+      const bool ok = write_file(request.path, O_APPEND, request.buffer,
+                                 request.size);
+      request.result = ok ? static_cast<int>(request.size) : -1;
+      request.busy = false;
+    }
+
+    if (self.stopping)
+    {
+      break;
+    }
+  }
+  return nullptr;
+}
+
+// ============================================================================
+// BootTask
+// ============================================================================
+
+// Below the main thread, above the storage worker
+static const u32 BOOT_STACK_SIZE = 64 * 1024;
+static const u8 BOOT_PRIORITY = 48;
+
+BootTask::BootTask(Function function, void* context)
+  : function(function)
+  , context(context)
+{
+  if (LWP_CreateThread(&thread, run, this, nullptr, BOOT_STACK_SIZE,
+                       BOOT_PRIORITY) >= 0)
+  {
+    return;
+  }
+  thread = LWP_THREAD_NULL;
+  function(context);
+}
+
+BootTask::~BootTask()
+{
+  join();
+}
+
+void BootTask::join()
+{
+  if (thread != LWP_THREAD_NULL)
+  {
+    LWP_JoinThread(thread, nullptr);
+    thread = LWP_THREAD_NULL;
+  }
+}
+
+void* BootTask::run(void* task)
+{
+  BootTask& self = *static_cast<BootTask*>(task);
+  self.function(self.context);
+  return nullptr;
+}
+
+// EOF
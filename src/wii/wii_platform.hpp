@@ -0,0 +1,146 @@
+// src/wii/wii_platform.hpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+#pragma once
+
+#include <grrlib.h>
+#include <ogc/lwp.h>
+#include <ogc/semaphore.h>
+#include "platform.hpp"
+
+// GRRLIB backed renderer. Owns the video system and the embedded textures
+// and fonts for its whole lifetime. Construction only brings up video;
+// LoadTextures and LoadFonts must both have run before the first frame.
+// They are independent, so startup may run one on a BootTask.
+class GrrlibRenderer : public Renderer
+{
+private:
+  GRRLIB_texImg* bird_tex = nullptr;
+  GRRLIB_texImg* pipe_tex = nullptr;
+  GRRLIB_ttfFont* score_font = nullptr;
+  GRRLIB_ttfFont* title_font = nullptr;
+
+  GRRLIB_texImg* get_texture(TextureId texture) const;
+  GRRLIB_ttfFont* get_font(FontId font) const;
+
+public:
+  GrrlibRenderer();
+  ~GrrlibRenderer() override;
+
+  GrrlibRenderer(GrrlibRenderer const&) = delete;
+  GrrlibRenderer& operator=(GrrlibRenderer const&) = delete;
+
+  void LoadTextures();
+
+  // Needs GRRLIB's FreeType library, which GRRLIB_Init sets up
+  void LoadFonts();
+
+  void FillScreen(u32 color) override;
+  void Rectangle(f32 x, f32 y, f32 width, f32 height, u32 color,
+                 bool filled) override;
+  void Plot(f32 x, f32 y, u32 color) override;
+  void DrawImage(f32 x, f32 y, TextureId texture, f32 degrees,
+                 f32 scale_x, f32 scale_y, u32 color) override;
+  void PrintText(int x, int y, FontId font, const char* text,
+                 u32 size, u32 color) override;
+  void Present() override;
+};
+
+// First Wiimote, buttons plus IR pointer
+class WpadInput : public Input
+{
+public:
+  WpadInput();
+
+  InputState Poll() override;
+};
+
+// SD card / USB storage through libfat, usable once Mount has returned.
+// Background reads and appends run on a low priority LWP thread started by
+// the first one, so they proceed while the main loop waits for the
+// retrace.
+class FatStorage : public Storage
+{
+private:
+  struct Request
+  {
+    // Written by the main thread while idle, read by the worker while busy
+    char path[256];
+    u32 offset = 0;
+    void* buffer = nullptr;
+    u32 size = 0;
+
+    // Set by the main thread, cleared by the worker when it is done
+    volatile bool busy = false;
+    volatile int result = -1;
+  };
+
+  lwp_t worker = LWP_THREAD_NULL;
+  sem_t wake;
+  Request read;
+  Request append;
+  volatile bool stopping = false;
+
+  bool start(Request& request, const char* path, u32 offset, void* buffer,
+             u32 size);
+  static void* serve(void* storage);
+
+public:
+  FatStorage() = default;
+
+  // Finishes any background read or append, then stops the worker
+  ~FatStorage() override;
+
+  FatStorage(FatStorage const&) = delete;
+  FatStorage& operator=(FatStorage const&) = delete;
+
+  // Mount the SD card or USB drive; false if neither could be mounted
+  bool Mount();
+
+  int ReadFile(const char* path, void* buffer, u32 capacity) override;
+  bool WriteFile(const char* path, const void* data, u32 size) override;
+  bool AppendFile(const char* path, const void* data, u32 size) override;
+  bool ReadFileAsync(const char* path, u32 offset, void* buffer,
+                     u32 size) override;
+  bool AppendFileAsync(const char* path, const void* data, u32 size) override;
+  int PollRead() override;
+  int PollAppend() override;
+};
+
+// Runs a function on its own LWP thread during startup. The thread sits
+// below the main thread's priority, so on the single core it only takes
+// the time main spends waiting on the hardware (retraces, IOS calls), and
+// then whatever is left once main joins it. If no thread can be made, the
+// function runs to completion inside the constructor instead.
+class BootTask
+{
+public:
+  typedef void (*Function)(void* context);
+
+  BootTask(Function function, void* context);
+  ~BootTask();
+
+  BootTask(BootTask const&) = delete;
+  BootTask& operator=(BootTask const&) = delete;
+
+  // Wait for the function to return. Callable from any thread, but only
+  // one at a time; later calls return at once.
+  void join();
+
+private:
+  lwp_t thread = LWP_THREAD_NULL;
+  Function function;
+  void* context;
+
+  static void* run(void* task);
+};
+
+// EOF
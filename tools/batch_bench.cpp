@@ -0,0 +1,201 @@
+// tools/batch_bench.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Benchmarks BatchSim and checks it against Physics::update_bird. Every
+// bird is flown by the CPU opponent's policy (cpu_opponent.hpp), with each
+// bird's decisions flipped at its own small rate so the birds spread out
+// along the course and die at different points. Once fewer than half of
+// them are alive the batch starts over on the next seed, so most of the
+// lanes stepped are live ones. The first --verify birds are also stepped through their
+// own Physics instance and compared bit for bit after every tick.
+//
+// Reports alive bird-steps per second (steps of birds still flying when
+// the step began) and the best score among the verified birds, so it can
+// be seen that the check covered pipes and scoring.
+//
+// Usage: batch_bench [--birds N] [--steps N] [--verify N]
+
+// C++ Standard Library
+#include <chrono>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project headers
+#include "batch_sim.hpp"
+#include "cpu_opponent.hpp"
+#include "flap_policy.hpp"
+#include "physics.hpp"
+
+// One in this many decisions is flipped, by bird index modulo the list;
+// 0 never flips, so some birds fly the policy as it is
+static const u32 FLIP_ODDS[] = { 0, 20000, 5000, 1000 };
+static const size_t FLIP_LEVELS = sizeof(FLIP_ODDS) / sizeof(FLIP_ODDS[0]);
+
+static const FlapPolicy pilot(CPU_OPPONENT_WEIGHTS);
+
+static bool same_bits(Scalar a, Scalar b)
+{
+  return memcmp(&a, &b, sizeof(Scalar)) == 0;
+}
+
+static u32 next_noise(u32& state)
+{
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+// Flap inputs for the next step; returns the birds still alive
+static size_t choose_flaps(const BatchSim& batch, u32& noise, std::vector<u8>& flaps)
+{
+  size_t alive = 0;
+  for (size_t i = 0; i < batch.size(); i++)
+  {
+    if (batch.is_dead(i))
+    {
+      flaps[i] = 0;
+      continue;
+    }
+    alive++;
+    bool flap = pilot.decide(batch.get_y()[i], batch.get_velocity()[i],
+                             batch.pipe_1, batch.pipe_2);
+    const u32 odds = FLIP_ODDS[i % FLIP_LEVELS];
+    if (odds != 0 && next_noise(noise) % odds == 0)
+    {
+      flap = !flap;
+    }
+    flaps[i] = flap;
+  }
+  return alive;
+}
+
+int main(int argc, char** argv)
+{
+  size_t birds = 4096;
+  long steps = 20000;
+  size_t verify = 64;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--birds") == 0 && i + 1 < argc)
+    {
+      birds = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+    {
+      steps = strtol(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--verify") == 0 && i + 1 < argc)
+    {
+      verify = strtoul(argv[++i], nullptr, 10);
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--birds N] [--steps N] [--verify N]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  if (verify > birds)
+  {
+    verify = birds;
+  }
+
+  std::vector<u8> flaps(birds);
+  u32 seed = 1;
+  u32 noise = 0x9E3779B9u;
+  BatchSim batch(birds, seed);
+
+  // Verification pass: compare against the reference implementation
+  std::vector<Physics> reference(verify);
+  long mismatches = 0;
+  s32 best_verified = 0;
+
+  for (long step = 0; step < steps && verify > 0; step++)
+  {
+    if (choose_flaps(batch, noise, flaps) * 2 < birds)
+    {
+      batch.reset(++seed);
+      for (Physics& physics : reference)
+      {
+        physics.reset();
+      }
+      choose_flaps(batch, noise, flaps);
+    }
+
+    for (size_t i = 0; i < verify; i++)
+    {
+      reference[i].update_bird(flaps[i] != 0, batch.pipe_1, batch.pipe_2);
+    }
+    batch.step(flaps.data());
+
+    for (size_t i = 0; i < verify; i++)
+    {
+      const Physics& ref = reference[i];
+      if (!same_bits(ref.get_y(), batch.get_y()[i]) ||
+          !same_bits(ref.velocity, batch.get_velocity()[i]) ||
+          ref.dead != batch.is_dead(i) ||
+          ref.score != batch.get_score()[i])
+      {
+        if (mismatches++ < 10)
+        {
+          fprintf(stderr, "mismatch: step %ld bird %zu\n", step, i);
+        }
+      }
+      best_verified = ref.score > best_verified ? ref.score : best_verified;
+    }
+  }
+
+  // Timed pass; only the steps are timed, not choosing the flaps
+  seed = 1;
+  noise = 0x9E3779B9u;
+  batch.reset(seed);
+  double alive_steps = 0;
+  long restarts = 0;
+  std::chrono::duration<double> elapsed(0);
+
+  for (long step = 0; step < steps; step++)
+  {
+    size_t alive = choose_flaps(batch, noise, flaps);
+    if (alive * 2 < birds)
+    {
+      batch.reset(++seed);
+      restarts++;
+      alive = choose_flaps(batch, noise, flaps);
+    }
+    alive_steps += static_cast<double>(alive);
+
+    auto start = std::chrono::steady_clock::now();
+    batch.step(flaps.data());
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+
+  double seconds = elapsed.count();
+
+  printf("birds:             %zu\n", birds);
+  printf("steps:             %ld (%ld restarts)\n", steps, restarts);
+  printf("alive at end:      %zu\n", batch.alive_count());
+  printf("alive bird-steps:  %.0f of %.0f\n", alive_steps,
+         static_cast<double>(birds) * steps);
+  printf("elapsed:           %.3f s\n", seconds);
+  printf("alive bird-steps/second: %.0f\n", seconds > 0 ? alive_steps / seconds : 0.0);
+  printf("verified birds:    %zu (%ld mismatches, best score %d)\n", verify, mismatches,
+         static_cast<int>(best_verified));
+
+  return mismatches == 0 ? 0 : 1;
+}
+
+// EOF
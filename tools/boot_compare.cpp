@@ -0,0 +1,203 @@
+// tools/boot_compare.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Compares the startup reports in a boot.log (see boot_profile.hpp). Every
+// launch appends one report under a heading that names how it started, so
+// a log from a console that ran both a SERIAL_BOOT=1 build and a regular
+// one holds both. For each phase and the total, prints the median time over
+// all reports under each heading, and the change from the first to the
+// second. Card and disc timings vary from launch to launch, so a few
+// launches of each build give steadier numbers than one.
+//
+// Usage: boot_compare [--before HEADING] [--after HEADING] BOOT_LOG
+//
+// The headings default to "Boot (serial)" and "Boot (overlapped)". Exits
+// with status 1 if the log cannot be read or has no report under either.
+
+// C++ Standard Library
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Times of one phase (or the total) under one heading, in ms
+struct Phase
+{
+  std::string name;
+  std::vector<double> before;
+  std::vector<double> after;
+};
+
+static std::string trim(const std::string& text)
+{
+  const size_t first = text.find_first_not_of(" \t\r\n");
+  if (first == std::string::npos)
+  {
+    return "";
+  }
+  const size_t last = text.find_last_not_of(" \t\r\n");
+  return text.substr(first, last - first + 1);
+}
+
+// "Fonts       41.2 ms  (at 12.0 ms)" or "Total       96.3 ms"
+static bool parse_line(const std::string& line, std::string& name, double& ms)
+{
+  const size_t unit = line.find(" ms");
+  if (unit == std::string::npos)
+  {
+    return false;
+  }
+  const size_t start = line.find_last_of(' ', unit - 1);
+  if (start == std::string::npos)
+  {
+    return false;
+  }
+
+  const std::string number = line.substr(start + 1, unit - start - 1);
+  char* end;
+  ms = strtod(number.c_str(), &end);
+  if (number.empty() || *end != '\0')
+  {
+    return false;
+  }
+  name = trim(line.substr(0, start));
+  return !name.empty();
+}
+
+static double median(std::vector<double> values)
+{
+  std::sort(values.begin(), values.end());
+  const size_t middle = values.size() / 2;
+  return values.size() % 2 ? values[middle]
+                           : (values[middle - 1] + values[middle]) / 2;
+}
+
+static void print_time(const std::vector<double>& values)
+{
+  if (values.empty())
+  {
+    printf("  %10s", "-");
+  }
+  else
+  {
+    printf("  %7.1f ms", median(values));
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::string before_heading = "Boot (serial)";
+  std::string after_heading = "Boot (overlapped)";
+  const char* path = nullptr;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--before") == 0 && i + 1 < argc)
+    {
+      before_heading = argv[++i];
+    }
+    else if (strcmp(argv[i], "--after") == 0 && i + 1 < argc)
+    {
+      after_heading = argv[++i];
+    }
+    else if (argv[i][0] != '-' && !path)
+    {
+      path = argv[i];
+    }
+    else
+    {
+      path = nullptr;
+      break;
+    }
+  }
+  if (!path)
+  {
+    fprintf(stderr, "Usage: %s [--before HEADING] [--after HEADING] BOOT_LOG\n",
+            argv[0]);
+    return 1;
+  }
+
+  FILE* file = fopen(path, "r");
+  if (!file)
+  {
+    perror(path);
+    return 1;
+  }
+
+  // Phases in the order the reports list them
+  std::vector<Phase> phases;
+  int reports[2] = { 0, 0 };
+  int side = -1;  // 0 under the first heading, 1 the second, -1 neither
+
+  char buffer[256];
+  while (fgets(buffer, sizeof(buffer), file))
+  {
+    const std::string line = trim(buffer);
+    std::string name;
+    double ms;
+    if (!parse_line(line, name, ms))
+    {
+      side = line == before_heading ? 0 : line == after_heading ? 1 : -1;
+      if (side >= 0)
+      {
+        reports[side]++;
+      }
+      continue;
+    }
+    if (side < 0)
+    {
+      continue;
+    }
+
+    auto phase = std::find_if(phases.begin(), phases.end(),
+                              [&](const Phase& known) { return known.name == name; });
+    if (phase == phases.end())
+    {
+      phases.push_back({ name, {}, {} });
+      phase = phases.end() - 1;
+    }
+    (side == 0 ? phase->before : phase->after).push_back(ms);
+  }
+  fclose(file);
+
+  if (reports[0] == 0 || reports[1] == 0)
+  {
+    fprintf(stderr, "%s: needs reports under both \"%s\" (%d) and \"%s\" (%d)\n",
+            path, before_heading.c_str(), reports[0], after_heading.c_str(),
+            reports[1]);
+    return 1;
+  }
+
+  // The total last, whatever order the phases first showed up in
+  std::stable_partition(phases.begin(), phases.end(),
+                        [](const Phase& phase) { return phase.name != "Total"; });
+
+  printf("median of %d and %d reports\n", reports[0], reports[1]);
+  printf("%-12s  %10s  %10s  %10s\n", "phase", "before", "after", "change");
+  for (const Phase& phase : phases)
+  {
+    printf("%-12s", phase.name.c_str());
+    print_time(phase.before);
+    print_time(phase.after);
+    if (!phase.before.empty() && !phase.after.empty())
+    {
+      printf("  %+7.1f ms", median(phase.after) - median(phase.before));
+    }
+    printf("\n");
+  }
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,212 @@
+// tools/env_client.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Test client for env_server. Drives every environment with random flaps
+// and reports steps per second and round-trip time. --verify also runs an
+// in-process copy of the environments (same seed) and checks every output
+// bit for bit; it needs a freshly started server. --local skips the server
+// and measures the in-process environments alone. --close shuts the server
+// down afterwards.
+//
+// Usage: env_client [--name NAME] [--steps N] [--verify] [--local]
+//                   [--envs N] [--close]
+
+// C++ Standard Library
+#include <chrono>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project headers
+#include "env_shm.hpp"
+#include "flapwii_env.h"
+
+// In-process environments with their own output buffers
+struct LocalEnv
+{
+  FlapwiiEnv* env;
+  std::vector<float> observations;
+  std::vector<float> rewards;
+  std::vector<u8> dones;
+
+  LocalEnv(u32 count, u32 seed)
+    : env(flapwii_env_create(count, seed))
+    , observations(size_t(count) * FLAPWII_ENV_OBS_SIZE)
+    , rewards(count)
+    , dones(count)
+  {
+    flapwii_env_bind(env, observations.data(), rewards.data(), dones.data());
+  }
+
+  ~LocalEnv()
+  {
+    flapwii_env_destroy(env);
+  }
+};
+
+int main(int argc, char** argv)
+{
+  const char* name = ENV_SHM_DEFAULT_NAME;
+  long steps = 10000;
+  bool verify = false;
+  bool local = false;
+  bool close = false;
+  u32 local_envs = 1024;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--name") == 0 && i + 1 < argc)
+    {
+      name = argv[++i];
+    }
+    else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+    {
+      steps = strtol(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--verify") == 0)
+    {
+      verify = true;
+    }
+    else if (strcmp(argv[i], "--local") == 0)
+    {
+      local = true;
+    }
+    else if (strcmp(argv[i], "--envs") == 0 && i + 1 < argc)
+    {
+      local_envs = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--close") == 0)
+    {
+      close = true;
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--name NAME] [--steps N] [--verify] "
+                      "[--local] [--envs N] [--close]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  EnvShm shm;
+  u32 count = local_envs;
+  u32 seed = 1;
+  if (!local)
+  {
+    if (!shm.open(name))
+    {
+      fprintf(stderr, "%s: no compatible env_server is running\n", name);
+      return 1;
+    }
+    count = shm.header().count;
+    seed = shm.header().seed;
+  }
+
+  LocalEnv reference(count, seed);
+  if (!reference.env)
+  {
+    fprintf(stderr, "cannot create %u environments\n", count);
+    return 1;
+  }
+
+  u8* actions = local ? nullptr : shm.actions();
+  std::vector<u8> local_actions(count);
+  if (local)
+  {
+    actions = local_actions.data();
+  }
+
+  const float* observations = local ? reference.observations.data() : shm.observations();
+  const float* rewards = local ? reference.rewards.data() : shm.rewards();
+  const u8* dones = local ? reference.dones.data() : shm.dones();
+
+  u32 state = 0x9E3779B9u;
+  u64 episodes = 0;
+  double total_reward = 0;
+  long mismatch_step = -1;
+
+  auto start = std::chrono::steady_clock::now();
+
+  long step = 0;
+  for (; step < steps; step++)
+  {
+    // Roughly one flap every 20 ticks
+    for (u32 i = 0; i < count; i++)
+    {
+      state ^= state << 13;
+      state ^= state >> 17;
+      state ^= state << 5;
+      actions[i] = state % 20 == 0;
+    }
+
+    if (local)
+    {
+      flapwii_env_step(reference.env, actions);
+    }
+    else if (!shm.call(EnvCommand::Step))
+    {
+      fprintf(stderr, "server stopped responding\n");
+      return 1;
+    }
+
+    for (u32 i = 0; i < count; i++)
+    {
+      episodes += dones[i];
+      total_reward += rewards[i];
+    }
+
+    if (verify && !local)
+    {
+      flapwii_env_step(reference.env, actions);
+      size_t obs_bytes = size_t(count) * FLAPWII_ENV_OBS_SIZE * sizeof(float);
+      if (memcmp(observations, reference.observations.data(), obs_bytes) != 0 ||
+          memcmp(rewards, reference.rewards.data(), count * sizeof(float)) != 0 ||
+          memcmp(dones, reference.dones.data(), count) != 0)
+      {
+        mismatch_step = step;
+        break;
+      }
+    }
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  double seconds = elapsed.count();
+
+  if (close && !local)
+  {
+    shm.call(EnvCommand::Close);
+  }
+
+  printf("transport:        %s\n", local ? "in-process" : "shared memory");
+  printf("environments:     %u\n", count);
+  printf("steps:            %ld\n", step);
+  printf("episodes ended:   %llu\n", static_cast<unsigned long long>(episodes));
+  printf("mean reward/step: %.4f\n", step > 0 ? total_reward / (double(step) * count) : 0.0);
+  printf("steps/second:     %.0f\n", seconds > 0 ? step / seconds : 0.0);
+  printf("env-steps/second: %.0f\n", seconds > 0 ? double(step) * count / seconds : 0.0);
+  printf("us/step:          %.2f\n", step > 0 ? seconds * 1e6 / step : 0.0);
+
+  if (verify && !local)
+  {
+    if (mismatch_step >= 0)
+    {
+      printf("verify:           MISMATCH at step %ld\n", mismatch_step);
+      return 1;
+    }
+    printf("verify:           ok\n");
+  }
+
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,121 @@
+// tools/env_server.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Serves a batch of training environments (flapwii_env.h) over shared
+// memory (env_shm.hpp). The environments write their outputs straight into
+// the segment, so a step costs one semaphore round trip and no copies.
+// Runs until a client sends Close or the process is interrupted.
+//
+// Usage: env_server [--envs N] [--seed N] [--name NAME]
+
+// C Standard Library
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project headers
+#include "env_shm.hpp"
+#include "flapwii_env.h"
+
+static volatile sig_atomic_t interrupted = 0;
+
+static void on_signal(int)
+{
+  interrupted = 1;
+}
+
+int main(int argc, char** argv)
+{
+  u32 envs = 1024;
+  u32 seed = 1;
+  const char* name = ENV_SHM_DEFAULT_NAME;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--envs") == 0 && i + 1 < argc)
+    {
+      envs = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+    {
+      seed = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--name") == 0 && i + 1 < argc)
+    {
+      name = argv[++i];
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--envs N] [--seed N] [--name NAME]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  FlapwiiEnv* env = flapwii_env_create(envs, seed);
+  if (!env)
+  {
+    fprintf(stderr, "cannot create %u environments\n", envs);
+    return 1;
+  }
+
+  EnvShm shm;
+  if (!shm.create(name, envs, seed))
+  {
+    fprintf(stderr, "%s: cannot create shared memory: %s\n", name, strerror(errno));
+    flapwii_env_destroy(env);
+    return 1;
+  }
+  flapwii_env_bind(env, shm.observations(), shm.rewards(), shm.dones());
+
+  // Let sem_wait return on Ctrl-C so the segment gets unlinked
+  struct sigaction action = {};
+  action.sa_handler = on_signal;
+  sigaction(SIGINT, &action, nullptr);
+  sigaction(SIGTERM, &action, nullptr);
+
+  printf("serving %u environments on %s\n", envs, name);
+  fflush(stdout);
+
+  EnvShmHeader& header = shm.header();
+  u64 steps = 0;
+  while (!interrupted)
+  {
+    if (sem_wait(&header.request) != 0)
+    {
+      continue;  // EINTR: check the flag
+    }
+
+    EnvCommand command = header.command;
+    switch (command)
+    {
+      case EnvCommand::Step:
+        flapwii_env_step(env, shm.actions());
+        steps++;
+        break;
+      case EnvCommand::Reset:
+        flapwii_env_reset(env, shm.mask());
+        break;
+      case EnvCommand::Close:
+        interrupted = 1;
+        break;
+    }
+
+    sem_post(&header.response);
+  }
+
+  printf("served %llu steps\n", static_cast<unsigned long long>(steps));
+  flapwii_env_destroy(env);
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,335 @@
+// tools/flapwii_host.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Headless game loop for profiling the simulation on a development machine.
+// Runs GameState unthrottled against scripted input and reports tick rate.
+//
+// Usage: flapwii_host [--frames N] [--script STRING] [--render] [--soft]
+//                     [--sd-root DIR] [--seed N] [--replay FILE]
+//                     [--record-dir DIR] [--autopilot] [--boot-profile]
+//                     [--audio-out FILE.wav|null] [--cubic]
+//
+// --render draws every frame into a null renderer; add --soft to draw into
+// the software rasterizer's framebuffer instead and time real drawing.
+// With --sd-root, save data, replays (last.rpl, best.rpl) and telemetry
+// (telemetry.bin, see telemetry_decode) are read from and written to
+// DIR/apps/flapwii. --replay plays one recorded run back
+// through GameState and prints its score and length. --record-dir saves
+// the replay of every finished run as DIR/run_<n>.rpl. --autopilot ignores
+// the script and lets the attract-mode autopilot play run after run, then
+// reports its scores and search throughput. --boot-profile prints how long
+// each startup phase the host shares with the console took (see
+// boot_profile.hpp), run one after another. --audio-out mixes the game's
+// sound effects in software (see soft_mixer.hpp), one tick's worth of
+// output after every update, into a 48 kHz WAV file, or into nothing with
+// "null"; sounds are timed by the audio rendered, so an event on tick N
+// starts N ticks into the file however fast the loop runs. --cubic
+// resamples with the cubic kernel instead of the linear one.
+
+// C++ Standard Library
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project headers
+#include "audio.hpp"
+#include "boot_profile.hpp"
+#include "game_state.hpp"
+#include "host_platform.hpp"
+#include "soft_mixer.hpp"
+#include "soft_renderer.hpp"
+#include "sprite_mask.hpp"
+
+int main(int argc, char** argv)
+{
+  BootProfile boot(GetTimeMicros());
+  bool boot_profile = false;
+  long frames = 1000000;
+  bool render = false;
+  bool soft = false;
+  std::string sd_root;
+  std::string replay_path;
+  std::string record_dir;
+  u32 seed = 1;
+  bool use_autopilot = false;
+  std::string audio_out;
+  bool cubic = false;
+
+  // Flap, then coast for 25 frames. A flap returns the bird to its starting
+  // height after ~26 frames, so this hovers until the pipes catch it.
+  std::string script = "A" + std::string(25, '.');
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+    {
+      frames = strtol(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc)
+    {
+      script = argv[++i];
+    }
+    else if (strcmp(argv[i], "--render") == 0)
+    {
+      render = true;
+    }
+    else if (strcmp(argv[i], "--soft") == 0)
+    {
+      render = true;
+      soft = true;
+    }
+    else if (strcmp(argv[i], "--sd-root") == 0 && i + 1 < argc)
+    {
+      sd_root = argv[++i];
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+    {
+      seed = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+    {
+      replay_path = argv[++i];
+    }
+    else if (strcmp(argv[i], "--record-dir") == 0 && i + 1 < argc)
+    {
+      record_dir = argv[++i];
+    }
+    else if (strcmp(argv[i], "--autopilot") == 0)
+    {
+      use_autopilot = true;
+    }
+    else if (strcmp(argv[i], "--boot-profile") == 0)
+    {
+      boot_profile = true;
+    }
+    else if (strcmp(argv[i], "--audio-out") == 0 && i + 1 < argc)
+    {
+      audio_out = argv[++i];
+    }
+    else if (strcmp(argv[i], "--cubic") == 0)
+    {
+      cubic = true;
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--frames N] [--script STRING] [--render] "
+                      "[--soft] [--sd-root DIR] [--seed N] [--replay FILE] "
+                      "[--record-dir DIR] [--autopilot] [--boot-profile] "
+                      "[--audio-out FILE.wav|null] [--cubic]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  NullRenderer null_renderer;
+  std::unique_ptr<SoftRenderer> soft_renderer;
+  if (soft)
+  {
+    boot.begin(BootPhase::Video);
+    soft_renderer = std::make_unique<SoftRenderer>();
+    boot.end(BootPhase::Video);
+  }
+  Renderer& renderer = soft ? static_cast<Renderer&>(*soft_renderer)
+                            : null_renderer;
+  ScriptedInput input(use_autopilot ? std::string(".") : script);
+  HostStorage storage(sd_root);
+
+  // Audio goes to a file, to nowhere, or (without --audio-out) is never
+  // mixed at all
+  NullSink null_sink;
+  std::unique_ptr<WavSink> wav_sink;
+  SoftMixer& mixer = host_mixer();
+  if (!audio_out.empty() && audio_out != "null")
+  {
+    wav_sink = std::make_unique<WavSink>(audio_out.c_str());
+    if (!wav_sink->ok())
+    {
+      fprintf(stderr, "%s: cannot write\n", audio_out.c_str());
+      return 1;
+    }
+  }
+  mixer.set_sink(wav_sink ? static_cast<AudioSink*>(wav_sink.get()) : &null_sink);
+  mixer.set_resampling(cubic ? Resampling::Cubic : Resampling::Linear);
+
+  // One tick of output per update, spread so whole seconds come out exact
+  long audio_ticks = 0;
+  auto render_audio = [&]()
+  {
+    if (audio_out.empty())
+    {
+      return;
+    }
+    const u64 rate = SoftMixer::OUTPUT_RATE;
+    const u64 from = audio_ticks * rate / SIM_TICK_RATE;
+    audio_ticks++;
+    mixer.render(static_cast<u32>(audio_ticks * rate / SIM_TICK_RATE - from));
+  };
+
+  boot.begin(BootPhase::Sounds);
+  sound_bank();
+  boot.end(BootPhase::Sounds);
+  boot.begin(BootPhase::Masks);
+  collision_masks();
+  boot.end(BootPhase::Masks);
+  boot.begin(BootPhase::Game);
+  GameState game(storage, seed);
+  boot.end(BootPhase::Game);
+
+  if (boot_profile)
+  {
+    char report[512];
+    boot.format("Boot (host, serial)", report, sizeof(report));
+    fputs(report, stdout);
+  }
+
+  if (!replay_path.empty())
+  {
+    std::vector<u8> data(REPLAY_MAX_SIZE);
+    FILE* file = fopen(replay_path.c_str(), "rb");
+    size_t size = file ? fread(data.data(), 1, data.size(), file) : 0;
+    if (file)
+    {
+      fclose(file);
+    }
+
+    if (!game.play_replay(data.data(), size))
+    {
+      fprintf(stderr, "%s: not a replay for this build\n", replay_path.c_str());
+      return 1;
+    }
+
+    // Play until the run ends and the game drops back to the menu
+    long ticks = 0;
+    while (!game.in_menu() && ticks < frames)
+    {
+      InputState idle;
+      game.update(idle);
+      render_audio();
+      ticks++;
+    }
+
+    ReplayInfo info;
+    read_replay_info(data.data(), size, info);
+    printf("seed:          %u\n", info.seed);
+    printf("claimed score: %u\n", info.score);
+    printf("ticks:         %ld (%u live)\n", ticks, info.frames);
+    printf("flaps:         %u in %zu bytes\n", info.flaps, size);
+    if (!audio_out.empty())
+    {
+      printf("audio:         %.3f s to %s\n",
+             double(mixer.get_frames()) / SoftMixer::OUTPUT_RATE, audio_out.c_str());
+    }
+    return 0;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  u64 frame_start = GetTimeMicros();
+  long frame = 0;
+  long runs = 0;
+  long run_score = 0;
+  long total_score = 0;
+  long best_score = 0;
+  for (; frame < frames; frame++)
+  {
+    InputState state = input.Poll();
+
+    if (state.buttons & INPUT_BUTTON_HOME)
+    {
+      break;
+    }
+
+    if (use_autopilot && game.in_menu())
+    {
+      game.start_autopilot();
+    }
+
+    const u64 now = GetTimeMicros();
+    game.record_frame_time(static_cast<u32>(now - frame_start));
+    frame_start = now;
+
+    bool was_menu = game.in_menu();
+    game.update(state);
+    render_audio();
+
+    // The score resets when the game returns to the menu; keep the last one
+    if (!game.in_menu())
+    {
+      run_score = game.get_score();
+    }
+
+    // A run just ended: the game is back on the title screen
+    if (!was_menu && game.in_menu())
+    {
+      runs++;
+      total_score += run_score;
+      best_score = run_score > best_score ? run_score : best_score;
+      if (!record_dir.empty())
+      {
+        const std::vector<u8>& replay = game.get_last_replay();
+        std::string path = record_dir + "/run_" + std::to_string(runs) + ".rpl";
+        FILE* file = fopen(path.c_str(), "wb");
+        if (file)
+        {
+          fwrite(replay.data(), 1, replay.size(), file);
+          fclose(file);
+        }
+      }
+    }
+
+    if (render)
+    {
+      renderer.FillScreen(0x0195c3ff);
+      game.render(renderer);
+      renderer.Present();
+    }
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  double seconds = elapsed.count();
+
+  printf("frames:        %ld\n", frame);
+  printf("runs:          %ld\n", runs);
+  printf("elapsed:       %.3f s\n", seconds);
+  printf("ticks/second:  %.0f\n", seconds > 0 ? frame / seconds : 0.0);
+  printf("ns/tick:       %.1f\n", frame > 0 ? seconds * 1e9 / frame : 0.0);
+  if (!audio_out.empty())
+  {
+    printf("audio:         %.3f s to %s\n",
+           double(mixer.get_frames()) / SoftMixer::OUTPUT_RATE, audio_out.c_str());
+  }
+
+  if (use_autopilot)
+  {
+    // A run still going when the frame budget ran out counts toward the best
+    if (!game.in_menu() && run_score > best_score)
+    {
+      best_score = run_score;
+    }
+
+    u64 nodes = game.get_autopilot_nodes();
+    printf("average score: %.1f\n", runs > 0 ? double(total_score) / runs : 0.0);
+    printf("best score:    %ld\n", best_score);
+    printf("search nodes:  %llu (%.1f per tick)\n",
+           static_cast<unsigned long long>(nodes),
+           frame > 0 ? double(nodes) / frame : 0.0);
+    printf("nodes/second:  %.0f\n", seconds > 0 ? nodes / seconds : 0.0);
+  }
+
+  return 0;
+}
+
+// EOF
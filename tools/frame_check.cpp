@@ -0,0 +1,331 @@
+// tools/frame_check.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Golden frame test for the drawing code. Plays a few seeded runs (flaps
+// from the CPU opponent's policy, then a climb into the ceiling so every
+// run also shows a death fall), draws selected frames with SoftRenderer and
+// compares each frame's hash with a stored golden list. A frame that does
+// not match is written as a PNG so the difference can be looked at.
+// It also reports how long SoftRenderer takes per frame.
+//
+// Usage: frame_check [--golden FILE] [--update FILE] [--out DIR]
+//                    [--png-all]
+//
+// --update writes the current hashes as the new golden list. --out sets
+// where PNGs go (default: the current directory); --png-all writes every
+// frame, matching or not. Glyph bitmaps come from the system FreeType, so a
+// different FreeType version can change the text pixels; regenerate the
+// list (make golden-update) after checking the PNGs.
+
+// C++ Standard Library
+#include <chrono>
+#include <string>
+#include <vector>
+
+// C Standard Library
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project headers
+#include "constants.hpp"
+#include "cpu_opponent.hpp"
+#include "game_state.hpp"
+#include "host_platform.hpp"
+#include "soft_renderer.hpp"
+
+// Same as the console's main loop
+static const u32 BACKGROUND_COLOR = 0x0195c3ff;
+
+// Run seeds and the ticks drawn from each run (tick 1 is the first tick
+// of the run). The title screen is drawn before and after each run.
+static const u32 RUN_SEEDS[] = { 1, 7, 2026 };
+static const int CAPTURE_TICKS[] = { 1, 150, 330, 700, 990 };
+
+// Ticks of pilot play before the bird climbs into the ceiling
+static const int PLAY_TICKS = 1000;
+
+struct Frame
+{
+  std::string name;
+  u64 hash;
+};
+
+static const FlapPolicy pilot(CPU_OPPONENT_WEIGHTS);
+
+static bool contains(const int* ticks, size_t count, int tick)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    if (ticks[i] == tick)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Draws frames, checks them against the golden list as they come and
+// writes the PNGs asked for
+class FrameRecorder
+{
+private:
+  SoftRenderer renderer;
+  const std::vector<Frame>& golden;
+  std::string out_dir;
+  bool png_all;
+
+  const Frame* find_golden(const std::string& name) const
+  {
+    for (const Frame& entry : golden)
+    {
+      if (entry.name == name)
+      {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  void save(const std::string& name)
+  {
+    std::string path = out_dir + "/" + name + ".png";
+    if (!renderer.SavePng(path.c_str()))
+    {
+      fprintf(stderr, "%s: cannot write\n", path.c_str());
+    }
+  }
+
+public:
+  std::vector<Frame> frames;
+  int mismatches = 0;
+  double render_seconds = 0;
+
+  FrameRecorder(const std::vector<Frame>& golden, std::string out_dir,
+                bool png_all)
+    : golden(golden)
+    , out_dir(std::move(out_dir))
+    , png_all(png_all)
+  {
+  }
+
+  void capture(GameState& game, const std::string& name, float alpha)
+  {
+    auto start = std::chrono::steady_clock::now();
+    renderer.FillScreen(BACKGROUND_COLOR);
+    game.render(renderer, alpha);
+    renderer.Present();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    render_seconds += elapsed.count();
+
+    const u64 hash = renderer.Hash();
+    frames.push_back(Frame{ name, hash });
+
+    bool differs = false;
+    if (!golden.empty())
+    {
+      const Frame* expected = find_golden(name);
+      if (!expected)
+      {
+        printf("MISSING %s: no golden hash\n", name.c_str());
+        differs = true;
+      }
+      else if (expected->hash != hash)
+      {
+        printf("MISMATCH %s: %016" PRIx64 ", golden %016" PRIx64 "\n",
+               name.c_str(), hash, expected->hash);
+        differs = true;
+      }
+    }
+
+    mismatches += differs;
+    if (differs || png_all)
+    {
+      save(name);
+    }
+  }
+};
+
+static void play_run(u32 seed, FrameRecorder& recorder)
+{
+  HostStorage storage;
+  GameState game(storage, seed);
+  char name[64];
+
+  // Point the cursor at the middle of the title screen
+  InputState menu;
+  menu.pointer_x = SCREEN_WIDTH / 2 / WIIMOTE_SENSITIVITY;
+  menu.pointer_y = SCREEN_HEIGHT / 2 / WIIMOTE_SENSITIVITY +
+                   WSP_POINTER_CORRECTION_Y;
+  game.update(menu);
+
+  snprintf(name, sizeof(name), "seed%u_title", seed);
+  recorder.capture(game, name, 1.0f);
+
+  const size_t capture_count = sizeof(CAPTURE_TICKS) / sizeof(CAPTURE_TICKS[0]);
+  bool fall_captured = false;
+
+  game.start_game(seed);
+  for (int tick = 1; !game.in_menu(); tick++)
+  {
+    GameSnapshot before = game.save_snapshot();
+    InputState input;
+    bool flap = tick < PLAY_TICKS
+                  ? pilot.decide(before.physics.get_y(), before.physics.velocity,
+                                 before.pipe_1, before.pipe_2)
+                  : true;  // Climb into the ceiling
+    input.buttons = flap ? INPUT_BUTTON_A : 0;
+    game.update(input);
+
+    if (contains(CAPTURE_TICKS, capture_count, tick))
+    {
+      snprintf(name, sizeof(name), "seed%u_tick%04d", seed, tick);
+      recorder.capture(game, name, 1.0f);
+    }
+
+    // Halfway between ticks, to cover the interpolation
+    if (tick == CAPTURE_TICKS[capture_count - 1])
+    {
+      snprintf(name, sizeof(name), "seed%u_tick%04d_half", seed, tick);
+      recorder.capture(game, name, 0.5f);
+    }
+
+    // One frame of the death fall, once the bird has turned downwards
+    GameSnapshot now = game.save_snapshot();
+    if (!fall_captured && now.is_dying && now.physics.velocity > 0)
+    {
+      snprintf(name, sizeof(name), "seed%u_fall", seed);
+      recorder.capture(game, name, 1.0f);
+      fall_captured = true;
+    }
+  }
+
+  // Back on the title screen, now offering the recorded run
+  game.update(menu);
+  snprintf(name, sizeof(name), "seed%u_menu_after", seed);
+  recorder.capture(game, name, 1.0f);
+}
+
+static bool read_golden(const char* path, std::vector<Frame>& golden)
+{
+  FILE* file = fopen(path, "r");
+  if (!file)
+  {
+    return false;
+  }
+
+  char line[256];
+  while (fgets(line, sizeof(line), file))
+  {
+    char name[128];
+    u64 hash;
+    if (line[0] != '#' && sscanf(line, "%127s %" SCNx64, name, &hash) == 2)
+    {
+      golden.push_back(Frame{ name, hash });
+    }
+  }
+
+  fclose(file);
+  return true;
+}
+
+static bool write_golden(const char* path, const std::vector<Frame>& frames)
+{
+  FILE* file = fopen(path, "w");
+  if (!file)
+  {
+    return false;
+  }
+
+  fprintf(file, "# frame_check golden hashes (make golden-update rewrites it)\n");
+  for (const Frame& frame : frames)
+  {
+    fprintf(file, "%s %016" PRIx64 "\n", frame.name.c_str(), frame.hash);
+  }
+  return fclose(file) == 0;
+}
+
+int main(int argc, char** argv)
+{
+  const char* golden_path = nullptr;
+  const char* update_path = nullptr;
+  std::string out_dir = ".";
+  bool png_all = false;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc)
+    {
+      golden_path = argv[++i];
+    }
+    else if (strcmp(argv[i], "--update") == 0 && i + 1 < argc)
+    {
+      update_path = argv[++i];
+    }
+    else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+    {
+      out_dir = argv[++i];
+    }
+    else if (strcmp(argv[i], "--png-all") == 0)
+    {
+      png_all = true;
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--golden FILE] [--update FILE] [--out DIR] "
+                      "[--png-all]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  std::vector<Frame> golden;
+  if (golden_path && !read_golden(golden_path, golden))
+  {
+    fprintf(stderr, "%s: cannot read\n", golden_path);
+    return 1;
+  }
+
+  FrameRecorder recorder(golden, out_dir, png_all);
+  for (u32 seed : RUN_SEEDS)
+  {
+    play_run(seed, recorder);
+  }
+
+  printf("%zu frames, %.1f us per frame (SoftRenderer)\n",
+         recorder.frames.size(),
+         recorder.render_seconds * 1e6 / recorder.frames.size());
+
+  if (update_path)
+  {
+    if (!write_golden(update_path, recorder.frames))
+    {
+      fprintf(stderr, "%s: cannot write\n", update_path);
+      return 1;
+    }
+    printf("wrote %s\n", update_path);
+  }
+
+  if (golden_path)
+  {
+    if (recorder.mismatches > 0)
+    {
+      printf("%d frame(s) differ from %s; PNGs written to %s\n",
+             recorder.mismatches, golden_path, out_dir.c_str());
+      return 1;
+    }
+    printf("all frames match %s\n", golden_path);
+  }
+
+  return 0;
+}
+
+// EOF
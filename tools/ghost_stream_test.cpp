@@ -0,0 +1,511 @@
+// tools/ghost_stream_test.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Checks the ghost's streaming replay decoder (see ghost.hpp) through
+// HostStorage's background reads, in a scratch directory:
+//   race    a run played by the CPU opponent's policy is saved as best.rpl,
+//           and the ghost must fly it again position for position
+//   stream  a replay of millions of flaps, far past REPLAY_MAX_SIZE and
+//           with gaps that straddle chunk edges, must decode to exactly
+//           the flaps it was written from, after one restart halfway
+//           through a chunk, with no heap allocation and no growth of
+//           the peak resident size while it streams
+//   late    the same stream through a storage that holds back reads at
+//           random, taken without waiting as the game does: ticks must
+//           underrun, and every tick that did not must still match the
+//           flaps it was written from, so the ghost never drifts
+// For race and stream, each tick waits until Ghost::ready(), as the game
+// never does, so a slow disk shows up as time taken rather than as
+// dropped input, and any underrun fails. Exits with status 1 if any check
+// fails.
+//
+// Usage: ghost_stream_test [--flaps N] [--seed N]
+
+// C++ Standard Library
+#include <atomic>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// System libraries
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Project headers
+#include "constants.hpp"
+#include "cpu_opponent.hpp"
+#include "ghost.hpp"
+#include "host_platform.hpp"
+#include "pipe.hpp"
+#include "rng.hpp"
+
+// Streaming must stay within this much more peak resident memory
+static const long MAX_RSS_GROWTH_KB = 1024;
+
+// ============================================================================
+// Allocation Counting
+// ============================================================================
+
+static std::atomic<u64> allocated_bytes(0);
+
+void* operator new(size_t size)
+{
+  allocated_bytes += size;
+  void* block = malloc(size ? size : 1);
+  if (!block)
+  {
+    throw std::bad_alloc();
+  }
+  return block;
+}
+
+void operator delete(void* block) noexcept
+{
+  free(block);
+}
+
+void operator delete(void* block, size_t) noexcept
+{
+  free(block);
+}
+
+static long peak_rss_kb()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+// ============================================================================
+// Replay Files
+// ============================================================================
+
+static void put_varint(FILE* file, u32 value)
+{
+  while (value >= 0x80)
+  {
+    fputc(static_cast<int>((value & 0x7F) | 0x80), file);
+    value >>= 7;
+  }
+  fputc(static_cast<int>(value), file);
+}
+
+// Mostly one-byte gaps, so the file is large for its length in ticks, and
+// a few of two and three bytes so that some straddle a chunk edge
+static u32 make_gap(Rng& rng)
+{
+  if (rng.below(256) == 0)
+  {
+    return 128 + rng.below(20000);
+  }
+  return rng.below(8);
+}
+
+// Writes the stream piece by piece; returns the file size or 0
+static long write_large_replay(const std::string& path, u32 seed, u32 flaps)
+{
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file)
+  {
+    return 0;
+  }
+
+  Rng rng(seed);
+  u32 frames = 0;
+  for (u32 i = 0; i < flaps; i++)
+  {
+    frames += make_gap(rng) + 1;
+  }
+
+  const u8 head[] = {
+    'F', 'W', 'R', 'P', REPLAY_VERSION, SIM_NUMERIC_MODE,
+    static_cast<u8>(SIM_TICK_RATE & 0xFF), static_cast<u8>(SIM_TICK_RATE >> 8),
+    static_cast<u8>(seed), static_cast<u8>(seed >> 8),
+    static_cast<u8>(seed >> 16), static_cast<u8>(seed >> 24)
+  };
+  fwrite(head, 1, sizeof(head), file);
+  put_varint(file, frames);
+  put_varint(file, 0);
+  put_varint(file, flaps);
+
+  rng.reseed(seed);
+  for (u32 i = 0; i < flaps; i++)
+  {
+    put_varint(file, make_gap(rng));
+  }
+
+  const long size = ftell(file);
+  return fclose(file) == 0 ? size : 0;
+}
+
+static bool write_file(const std::string& path, const std::vector<u8>& data)
+{
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file)
+  {
+    return false;
+  }
+  const bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+  return fclose(file) == 0 && ok;
+}
+
+// Input for the next tick, once its bytes are in
+static bool paced_next(Ghost& ghost)
+{
+  while (!ghost.ready())
+  {
+    std::this_thread::yield();
+    ghost.poll();
+  }
+  return ghost.next();
+}
+
+// HostStorage with reads that finish only after a random number of polls,
+// as from a busy card
+class LateStorage : public Storage
+{
+public:
+  LateStorage(Storage& storage, u32 seed, u32 max_delay)
+    : storage(storage)
+    , rng(seed)
+    , max_delay(max_delay)
+  {
+  }
+
+  int ReadFile(const char* path, void* buffer, u32 capacity) override
+  {
+    return storage.ReadFile(path, buffer, capacity);
+  }
+
+  bool WriteFile(const char* path, const void* data, u32 size) override
+  {
+    return storage.WriteFile(path, data, size);
+  }
+
+  bool AppendFile(const char* path, const void* data, u32 size) override
+  {
+    return storage.AppendFile(path, data, size);
+  }
+
+  bool ReadFileAsync(const char* path, u32 offset, void* buffer, u32 size) override
+  {
+    if (!storage.ReadFileAsync(path, offset, buffer, size))
+    {
+      return false;
+    }
+    delay = rng.below(max_delay + 1);
+    return true;
+  }
+
+  bool AppendFileAsync(const char* path, const void* data, u32 size) override
+  {
+    return storage.AppendFileAsync(path, data, size);
+  }
+
+  int PollRead() override
+  {
+    const int result = storage.PollRead();
+    if (result == IO_PENDING || delay == 0)
+    {
+      return result;
+    }
+    delay--;
+    return IO_PENDING;
+  }
+
+  int PollAppend() override
+  {
+    return storage.PollAppend();
+  }
+
+private:
+  Storage& storage;
+  Rng rng;
+  u32 max_delay;
+  u32 delay = 0;
+};
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+// The ghost of a real run must retrace it through the same pipes
+static bool check_race(Storage& storage, const std::string& best_path, u32 seed)
+{
+  static const FlapPolicy pilot(CPU_OPPONENT_WEIGHTS);
+  static const u32 max_frames = 10 * 60 * SIM_TICK_RATE;
+
+  ReplayRecorder recorder;
+  recorder.begin(seed);
+  std::vector<Scalar> heights;
+
+  Rng rng(seed);
+  Pipe pipe_1(rng);
+  Pipe pipe_2(rng);
+  bool first_round = true;
+  Physics bird;
+  while (!bird.dead && heights.size() < max_frames)
+  {
+    const bool flap = pilot.decide(bird.get_y(), bird.velocity, pipe_1, pipe_2);
+    recorder.record(flap);
+    bird.update_bird(flap, pipe_1, pipe_2);
+    advance_pipes(pipe_1, pipe_2, first_round, rng);
+    heights.push_back(bird.get_y());
+  }
+
+  if (!write_file(best_path, recorder.finish(bird.score)))
+  {
+    fprintf(stderr, "race: cannot write %s\n", best_path.c_str());
+    return false;
+  }
+
+  Ghost ghost(storage);
+  ghost.load();
+  if (!ghost.available())
+  {
+    fprintf(stderr, "race: best.rpl did not load\n");
+    return false;
+  }
+  ghost.start();
+
+  rng.reseed(seed);
+  pipe_1.reset(rng);
+  pipe_2.reset(rng);
+  first_round = true;
+  size_t tick = 0;
+  while (!ghost.physics.dead && tick < heights.size())
+  {
+    ghost.physics.update_bird(paced_next(ghost), pipe_1, pipe_2);
+    advance_pipes(pipe_1, pipe_2, first_round, rng);
+    if (ghost.physics.get_y() != heights[tick])
+    {
+      fprintf(stderr, "race: ghost left the run at tick %zu\n", tick);
+      return false;
+    }
+    tick++;
+  }
+
+  const bool ok = tick == heights.size() && ghost.physics.score == bird.score;
+  printf("race:      %zu ticks, score %d, %u bytes streamed: %s\n", tick,
+         ghost.physics.score, ghost.get_bytes_streamed(), ok ? "ok" : "MISMATCH");
+  return ok;
+}
+
+// Decodes `flaps` flaps and compares them with the generator; false on the
+// first difference
+static bool stream_flaps(Ghost& ghost, u32 seed, u32 flaps, u64& ticks)
+{
+  Rng rng(seed);
+  for (u32 i = 0; i < flaps; i++)
+  {
+    const u32 gap = make_gap(rng);
+    for (u32 idle = 0; idle < gap; idle++, ticks++)
+    {
+      if (paced_next(ghost))
+      {
+        fprintf(stderr, "stream: early flap %u at tick %llu\n", i,
+                static_cast<unsigned long long>(ticks));
+        return false;
+      }
+    }
+    ticks++;
+    if (!paced_next(ghost))
+    {
+      fprintf(stderr, "stream: flap %u missing at tick %llu\n", i,
+              static_cast<unsigned long long>(ticks));
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool check_stream(Storage& storage, const std::string& best_path, u32 seed,
+                         u32 flaps)
+{
+  const long file_size = write_large_replay(best_path, seed, flaps);
+  if (file_size == 0)
+  {
+    fprintf(stderr, "stream: cannot write %s\n", best_path.c_str());
+    return false;
+  }
+
+  Ghost ghost(storage);
+  ghost.load();
+  if (!ghost.available())
+  {
+    fprintf(stderr, "stream: best.rpl did not load\n");
+    return false;
+  }
+
+  const u64 bytes = allocated_bytes;
+  const long rss = peak_rss_kb();
+
+  // Part of the way in, start over as a finished race does
+  u64 ticks = 0;
+  ghost.start();
+  bool ok = stream_flaps(ghost, seed, flaps / 3 + 1, ticks);
+  ghost.rewind();
+  ghost.start();
+
+  ticks = 0;
+  ok = ok && stream_flaps(ghost, seed, flaps, ticks);
+  for (int tail = 0; ok && tail < 8 * SIM_TICK_RATE; tail++)
+  {
+    ok = !paced_next(ghost);
+  }
+
+  const u64 heap = allocated_bytes - bytes;
+  const long growth = peak_rss_kb() - rss;
+  printf("stream:    %u flaps over %llu ticks, %ld byte file, %u bytes streamed\n",
+         flaps, static_cast<unsigned long long>(ticks), file_size,
+         ghost.get_bytes_streamed());
+  printf("memory:    Ghost is %zu bytes, %llu heap bytes while streaming, "
+         "peak RSS +%ld KB\n", sizeof(Ghost), static_cast<unsigned long long>(heap),
+         growth);
+  printf("underruns: %u\n", ghost.get_underruns());
+
+  if (!ok)
+  {
+    printf("stream:    MISMATCH\n");
+  }
+  if (heap != 0 || growth > MAX_RSS_GROWTH_KB)
+  {
+    printf("memory:    NOT BOUNDED (limit 0 heap bytes, +%ld KB RSS)\n",
+           MAX_RSS_GROWTH_KB);
+    ok = false;
+  }
+  return ok && ghost.get_underruns() == 0;
+}
+
+// Unpaced: a tick that underran flies without a flap and may lose one;
+// every other tick must be exactly the one written
+static bool check_late(Storage& storage, const std::string& best_path, u32 seed,
+                       u32 flaps)
+{
+  // Polls a read may be held back for; several chunks' worth of ticks
+  static const u32 MAX_DELAY = 3000;
+
+  if (write_large_replay(best_path, seed, flaps) == 0)
+  {
+    fprintf(stderr, "late: cannot write %s\n", best_path.c_str());
+    return false;
+  }
+
+  LateStorage late(storage, seed, MAX_DELAY);
+  Ghost ghost(late);
+  ghost.load();
+  if (!ghost.available())
+  {
+    fprintf(stderr, "late: best.rpl did not load\n");
+    return false;
+  }
+  ghost.start();
+
+  Rng rng(seed);
+  u64 tick = 0;
+  u32 lost = 0;
+  for (u32 i = 0; i < flaps; i++)
+  {
+    const u32 gap = make_gap(rng);
+    for (u32 at = 0; at <= gap; at++, tick++)
+    {
+      const bool expected = at == gap;
+      const u32 underruns = ghost.get_underruns();
+      const bool flap = ghost.next();
+      if (ghost.get_underruns() != underruns)
+      {
+        lost += expected;
+        continue;
+      }
+      if (flap != expected)
+      {
+        fprintf(stderr, "late: %s at tick %llu (flap %u), after %u underruns\n",
+                flap ? "early flap" : "flap missing",
+                static_cast<unsigned long long>(tick), i, underruns);
+        return false;
+      }
+    }
+  }
+
+  printf("late:      %u flaps over %llu ticks, %u underruns, %u flaps lost\n",
+         flaps, static_cast<unsigned long long>(tick), ghost.get_underruns(),
+         lost);
+  if (ghost.get_underruns() == 0)
+  {
+    printf("late:      NO UNDERRUNS (reads were not held back long enough)\n");
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  u32 flaps = 1 << 22;
+  u32 seed = 1;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--flaps") == 0 && i + 1 < argc)
+    {
+      flaps = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+    {
+      seed = strtoul(argv[++i], nullptr, 10);
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--flaps N] [--seed N]\n", argv[0]);
+      return 1;
+    }
+  }
+  if (flaps == 0)
+  {
+    fprintf(stderr, "--flaps must be positive\n");
+    return 1;
+  }
+
+  char scratch[] = "/tmp/ghost_stream_test.XXXXXX";
+  if (!mkdtemp(scratch))
+  {
+    perror("mkdtemp");
+    return 1;
+  }
+  const std::string root = scratch;
+  mkdir((root + "/apps").c_str(), 0755);
+  mkdir((root + "/apps/flapwii").c_str(), 0755);
+  const std::string best_path = root + REPLAY_BEST_PATH;
+
+  bool ok;
+  {
+    HostStorage storage(root);
+    ok = check_race(storage, best_path, seed);
+    ok = check_stream(storage, best_path, seed, flaps) && ok;
+    ok = check_late(storage, best_path, seed, flaps / 16 + 1) && ok;
+  }
+
+  unlink(best_path.c_str());
+  rmdir((root + "/apps/flapwii").c_str());
+  rmdir((root + "/apps").c_str());
+  rmdir(root.c_str());
+
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}
+
+// EOF
@@ -0,0 +1,311 @@
+// tools/map_report.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Size report from a GNU ld link map (the console build writes
+// build/boot.elf.map; `make size-report` runs this on it). Lists the
+// size of each output section, the libraries and the objects that take
+// the most room (debug sections left out), and any object from the list of known heavy C and C++
+// runtime pieces (printf and scanf, locales, iostreams, float
+// conversion) that made it into the link, so a change that drags one back
+// in shows up by name.
+//
+// Usage: map_report [--top N] FILE.map
+
+// C++ Standard Library
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project headers
+#include "types.hpp"
+
+// Object names that mean a heavy runtime piece was linked in
+static const char* const HEAVY_PATTERNS[] = {
+  "printf", "scanf", "locale", "ios", "stream", "dtoa", "mprec", "strtod",
+  "wchar"
+};
+
+struct Usage
+{
+  u64 loaded = 0;  // Bytes stored in the binary (code and data)
+  u64 zeroed = 0;  // Bytes only reserved at run time (.bss, .sbss)
+};
+
+// Sections the loader never sees: debug info, comments, notes
+static const char* const UNLOADED_PREFIXES[] = {
+  ".debug", ".comment", ".stab", ".note", ".gnu.attributes", ".gnu_debug"
+};
+
+static bool is_unloaded(const std::string& section)
+{
+  for (const char* prefix : UNLOADED_PREFIXES)
+  {
+    if (section.compare(0, strlen(prefix), prefix) == 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool is_zeroed(const std::string& section)
+{
+  return section.compare(0, 4, ".bss") == 0 || section.compare(0, 5, ".sbss") == 0;
+}
+
+// "lib/libc.a(lib_a-vfprintf.o)" -> "libc.a"; a plain object keeps its name
+static std::string library_of(const std::string& file)
+{
+  const size_t paren = file.find('(');
+  const std::string archive = paren == std::string::npos ? file : file.substr(0, paren);
+  const size_t slash = archive.rfind('/');
+  return slash == std::string::npos ? archive : archive.substr(slash + 1);
+}
+
+static std::string object_of(const std::string& file)
+{
+  const size_t paren = file.find('(');
+  if (paren != std::string::npos)
+  {
+    return library_of(file) + file.substr(paren);
+  }
+  const size_t slash = file.rfind('/');
+  return slash == std::string::npos ? file : file.substr(slash + 1);
+}
+
+// Splits a line into whitespace separated fields
+static std::vector<std::string> fields_of(const char* line)
+{
+  std::vector<std::string> fields;
+  const char* p = line;
+  while (*p)
+  {
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+    {
+      p++;
+    }
+    const char* start = p;
+    while (*p && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r')
+    {
+      p++;
+    }
+    if (p > start)
+    {
+      fields.emplace_back(start, p);
+    }
+  }
+  return fields;
+}
+
+static bool is_hex(const std::string& field)
+{
+  return field.size() > 2 && field[0] == '0' && field[1] == 'x';
+}
+
+struct Report
+{
+  std::map<std::string, Usage> sections;
+  std::map<std::string, Usage> libraries;
+  std::map<std::string, Usage> objects;
+};
+
+// Reads the memory map part of the file; false if there is none
+static bool read_map(FILE* file, Report& report)
+{
+  char line[4096];
+  bool in_map = false;
+  std::string output_section;
+  std::string input_section;
+
+  while (fgets(line, sizeof(line), file))
+  {
+    if (!in_map)
+    {
+      in_map = strncmp(line, "Linker script and memory map", 28) == 0;
+      continue;
+    }
+
+    const std::vector<std::string> fields = fields_of(line);
+    if (fields.empty())
+    {
+      continue;
+    }
+
+    // An output section starts in the first column
+    if (line[0] == '.')
+    {
+      output_section = fields[0];
+      input_section.clear();
+      continue;
+    }
+    if (line[0] != ' ' || output_section.empty())
+    {
+      continue;
+    }
+
+    // An input section: " .text.name 0xADDR 0xSIZE file", with the
+    // address moved to the next line when the name is long
+    size_t at = 0;
+    if (fields[0][0] == '.' || fields[0] == "COMMON")
+    {
+      input_section = fields[0];
+      at = 1;
+      if (fields.size() == 1)
+      {
+        continue;
+      }
+    }
+    else if (input_section.empty())
+    {
+      continue;
+    }
+
+    // Symbol lines carry an address and a name, not a size and a file
+    if (fields.size() < at + 3 || !is_hex(fields[at]) || !is_hex(fields[at + 1]))
+    {
+      input_section.clear();
+      continue;
+    }
+
+    const u64 size = strtoull(fields[at + 1].c_str(), nullptr, 16);
+    const std::string& path = fields[at + 2];
+    input_section.clear();
+    if (size == 0 || is_unloaded(output_section))
+    {
+      continue;
+    }
+
+    const bool zeroed = is_zeroed(output_section);
+    for (Usage* usage : { &report.sections[output_section],
+                          &report.libraries[library_of(path)],
+                          &report.objects[object_of(path)] })
+    {
+      (zeroed ? usage->zeroed : usage->loaded) += size;
+    }
+  }
+  return in_map;
+}
+
+static void print_top(const char* title, const std::map<std::string, Usage>& usages,
+                      size_t top)
+{
+  std::vector<std::pair<std::string, Usage>> sorted(usages.begin(), usages.end());
+  std::sort(sorted.begin(), sorted.end(),
+            [](const auto& a, const auto& b)
+            {
+              return a.second.loaded + a.second.zeroed > b.second.loaded + b.second.zeroed;
+            });
+
+  printf("\n%s\n", title);
+  printf("  %10s %10s  %s\n", "loaded", "zeroed", "name");
+  for (size_t i = 0; i < sorted.size() && i < top; i++)
+  {
+    printf("  %10llu %10llu  %s\n",
+           static_cast<unsigned long long>(sorted[i].second.loaded),
+           static_cast<unsigned long long>(sorted[i].second.zeroed),
+           sorted[i].first.c_str());
+  }
+}
+
+int main(int argc, char** argv)
+{
+  size_t top = 15;
+  const char* path = nullptr;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--top") == 0 && i + 1 < argc)
+    {
+      top = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (argv[i][0] != '-' && !path)
+    {
+      path = argv[i];
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--top N] FILE.map\n", argv[0]);
+      return 1;
+    }
+  }
+  if (!path)
+  {
+    fprintf(stderr, "Usage: %s [--top N] FILE.map\n", argv[0]);
+    return 1;
+  }
+
+  FILE* file = fopen(path, "r");
+  if (!file)
+  {
+    fprintf(stderr, "%s: cannot read\n", path);
+    return 1;
+  }
+  Report report;
+  const bool ok = read_map(file, report);
+  fclose(file);
+  if (!ok)
+  {
+    fprintf(stderr, "%s: no memory map (link with -Wl,-Map)\n", path);
+    return 1;
+  }
+
+  Usage total;
+  for (const auto& section : report.sections)
+  {
+    total.loaded += section.second.loaded;
+    total.zeroed += section.second.zeroed;
+  }
+  printf("total:         %llu bytes loaded, %llu bytes zeroed\n",
+         static_cast<unsigned long long>(total.loaded),
+         static_cast<unsigned long long>(total.zeroed));
+
+  print_top("sections:", report.sections, report.sections.size());
+  print_top("libraries:", report.libraries, top);
+  print_top("objects:", report.objects, top);
+
+  std::map<std::string, Usage> heavy;
+  for (const auto& object : report.objects)
+  {
+    // Runtime pieces come from archives; only the member name counts
+    const size_t paren = object.first.find('(');
+    if (paren == std::string::npos)
+    {
+      continue;
+    }
+    const std::string member = object.first.substr(paren);
+    for (const char* pattern : HEAVY_PATTERNS)
+    {
+      if (member.find(pattern) != std::string::npos)
+      {
+        heavy.insert(object);
+        break;
+      }
+    }
+  }
+  if (heavy.empty())
+  {
+    printf("\nheavy runtime: none linked\n");
+  }
+  else
+  {
+    print_top("heavy runtime (printf, locale, iostream, float conversion):", heavy,
+              heavy.size());
+  }
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,353 @@
+// tools/neuro_train.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Neuroevolution trainer for FlapPolicy networks. Every generation, each
+// genome flies the same set of fresh pipe seeds; the games are split into
+// (seed, block of genomes) tasks and spread over all cores with the
+// work-stealing pool, each task stepping its block through one BatchSim.
+// Fitness is the mean number of ticks survived. The next generation keeps
+// the best few genomes and fills up with mutated crossovers of
+// tournament winners.
+//
+// Usage: neuro_train [--population N] [--generations N] [--seeds N]
+//                    [--max-ticks N] [--threads N] [--seed N]
+//                    [--export FILE]
+//
+// --export writes the best genome of the last generation as a C++ header
+// in the format of src/cpu_opponent.hpp.
+
+// C++ Standard Library
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project headers
+#include "batch_sim.hpp"
+#include "constants.hpp"
+#include "flap_policy.hpp"
+#include "work_pool.hpp"
+
+// Genomes per evaluation task
+static const size_t BLOCK_SIZE = 64;
+
+struct Options
+{
+  size_t population = 256;
+  int generations = 40;
+  size_t seeds = 16;
+  u32 max_ticks = 5 * 60 * SIM_TICK_RATE;  // Five minutes of play
+  unsigned threads = 0;
+  u32 seed = 1;
+  const char* export_path = nullptr;
+};
+
+// Per (seed, genome) game outcome
+struct GameResult
+{
+  u32 ticks;
+  s32 score;
+};
+
+// Fly genomes [first, first + count) through one pipe stream
+static u64 play_block(const std::vector<float>& genomes, size_t first,
+                      size_t count, u32 run_seed, u32 max_ticks,
+                      GameResult* results)
+{
+  BatchSim sim(count, run_seed);
+  std::vector<u8> flaps(count);
+  std::vector<u32> ticks(count, 0);
+
+  size_t alive = count;
+  u32 tick = 0;
+  for (; tick < max_ticks && alive > 0; tick++)
+  {
+    const Scalar* y = sim.get_y();
+    const Scalar* velocity = sim.get_velocity();
+    for (size_t i = 0; i < count; i++)
+    {
+      FlapPolicy policy(&genomes[(first + i) * POLICY_WEIGHT_COUNT]);
+      flaps[i] = !sim.is_dead(i) &&
+                 policy.decide(y[i], velocity[i], sim.pipe_1, sim.pipe_2);
+    }
+
+    sim.step(flaps.data());
+
+    alive = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+      if (!sim.is_dead(i))
+      {
+        ticks[i]++;
+        alive++;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < count; i++)
+  {
+    results[i].ticks = ticks[i];
+    results[i].score = sim.get_score()[i];
+  }
+  return static_cast<u64>(tick) * count;
+}
+
+static bool write_header(const char* path, const float* genome,
+                         const Options& options, double mean_ticks,
+                         double mean_score)
+{
+  FILE* file = fopen(path, "w");
+  if (!file)
+  {
+    return false;
+  }
+
+  fprintf(file,
+          "// src/cpu_opponent.hpp\n"
+          "// SPDX-License-Identifier: GPL-3.0-or-later\n"
+          "//\n"
+          "// Flapwii Bird\n"
+          "// Copyright (C) 2026 DeltaResero\n"
+          "//\n"
+          "// This program is free software: you can redistribute it and/or modify\n"
+          "// it under the terms of the GNU General Public License as published by\n"
+          "// the Free Software Foundation, either version 3 of the License, or\n"
+          "// (at your option) any later version.\n"
+          "\n"
+          "// Generated by tools/neuro_train.cpp; do not edit by hand.\n"
+          "// Trainer seed %u, %d generations, population %zu, %zu pipe seeds\n"
+          "// per genome, %d Hz ticks. Mean survival %.0f ticks, mean score %.1f.\n"
+          "\n"
+          "#pragma once\n"
+          "\n"
+          "#include \"flap_policy.hpp\"\n"
+          "\n"
+          "// Weights for the on-console CPU opponent (see FlapPolicy)\n"
+          "const float CPU_OPPONENT_WEIGHTS[] = {\n",
+          options.seed, options.generations, options.population,
+          options.seeds, SIM_TICK_RATE, mean_ticks, mean_score);
+
+  // Hex floats round-trip exactly
+  for (int i = 0; i < POLICY_WEIGHT_COUNT; i++)
+  {
+    fprintf(file, "%s%af,%s", i % 4 == 0 ? "  " : " ", genome[i],
+            i % 4 == 3 || i + 1 == POLICY_WEIGHT_COUNT ? "\n" : "");
+  }
+
+  fprintf(file,
+          "};\n"
+          "\n"
+          "static_assert(sizeof(CPU_OPPONENT_WEIGHTS) ==\n"
+          "                POLICY_WEIGHT_COUNT * sizeof(float),\n"
+          "              \"FlapPolicy shape changed; retrain the CPU opponent\");\n"
+          "\n"
+          "// EOF\n");
+
+  return fclose(file) == 0;
+}
+
+int main(int argc, char** argv)
+{
+  Options options;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--population") == 0 && i + 1 < argc)
+    {
+      options.population = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--generations") == 0 && i + 1 < argc)
+    {
+      options.generations = strtol(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--seeds") == 0 && i + 1 < argc)
+    {
+      options.seeds = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--max-ticks") == 0 && i + 1 < argc)
+    {
+      options.max_ticks = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+    {
+      options.threads = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+    {
+      options.seed = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--export") == 0 && i + 1 < argc)
+    {
+      options.export_path = argv[++i];
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--population N] [--generations N] "
+                      "[--seeds N] [--max-ticks N] [--threads N] [--seed N] "
+                      "[--export FILE]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  options.generations = std::max(options.generations, 1);
+  const size_t population = std::max<size_t>(options.population, 4);
+  const size_t seeds = std::max<size_t>(options.seeds, 1);
+  const size_t elites = std::max<size_t>(population / 16, 1);
+  const size_t blocks = (population + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+  std::mt19937 random(options.seed);
+  std::normal_distribution<float> gaussian(0.0f, 1.0f);
+  std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+
+  std::vector<float> genomes(population * POLICY_WEIGHT_COUNT);
+  for (float& weight : genomes)
+  {
+    weight = gaussian(random);
+  }
+
+  WorkPool pool(options.threads);
+  std::vector<GameResult> results(seeds * population);
+  std::vector<u32> run_seeds(seeds);
+  std::vector<double> fitness(population);
+  std::vector<double> mean_score(population);
+  std::vector<size_t> order(population);
+  std::vector<float> next(genomes.size());
+
+  printf("population %zu, %zu seeds per genome, %d weights, %u threads\n",
+         population, seeds, POLICY_WEIGHT_COUNT, pool.size());
+
+  auto train_start = std::chrono::steady_clock::now();
+
+  for (int generation = 0; generation < options.generations; generation++)
+  {
+    // Fresh pipe layouts every generation so nothing overfits one course
+    for (u32& run_seed : run_seeds)
+    {
+      run_seed = random();
+    }
+
+    std::vector<u64> steps(seeds * blocks);
+    auto start = std::chrono::steady_clock::now();
+
+    pool.parallel_for(seeds * blocks, [&](size_t task, unsigned)
+    {
+      size_t seed_index = task / blocks;
+      size_t first = (task % blocks) * BLOCK_SIZE;
+      size_t count = std::min(BLOCK_SIZE, population - first);
+      steps[task] = play_block(genomes, first, count, run_seeds[seed_index],
+                               options.max_ticks,
+                               &results[seed_index * population + first]);
+    });
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+    u64 total_steps = std::accumulate(steps.begin(), steps.end(), u64(0));
+
+    for (size_t g = 0; g < population; g++)
+    {
+      double ticks = 0;
+      double score = 0;
+      for (size_t s = 0; s < seeds; s++)
+      {
+        ticks += results[s * population + g].ticks;
+        score += results[s * population + g].score;
+      }
+      fitness[g] = ticks / seeds;
+      mean_score[g] = score / seeds;
+    }
+
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+    {
+      return fitness[a] > fitness[b];
+    });
+
+    double population_mean =
+      std::accumulate(fitness.begin(), fitness.end(), 0.0) / population;
+    size_t best = order[0];
+
+    printf("gen %3d  best %7.0f ticks  score %6.1f  mean %7.0f ticks  "
+           "%8.0f games/s  %6.1fM steps/s\n",
+           generation, fitness[best], mean_score[best], population_mean,
+           seconds > 0 ? seeds * population / seconds : 0.0,
+           seconds > 0 ? total_steps / seconds / 1e6 : 0.0);
+
+    if (generation + 1 == options.generations)
+    {
+      break;  // Keep the evaluated population for export
+    }
+
+    // Elites survive unchanged at the front
+    for (size_t e = 0; e < elites; e++)
+    {
+      std::copy_n(&genomes[order[e] * POLICY_WEIGHT_COUNT], POLICY_WEIGHT_COUNT,
+                  &next[e * POLICY_WEIGHT_COUNT]);
+    }
+
+    auto tournament = [&]()
+    {
+      size_t winner = random() % population;
+      for (int round = 0; round < 2; round++)
+      {
+        size_t challenger = random() % population;
+        if (fitness[challenger] > fitness[winner])
+        {
+          winner = challenger;
+        }
+      }
+      return &genomes[winner * POLICY_WEIGHT_COUNT];
+    };
+
+    for (size_t child = elites; child < population; child++)
+    {
+      const float* mother = tournament();
+      const float* father = tournament();
+      float* out = &next[child * POLICY_WEIGHT_COUNT];
+
+      for (int w = 0; w < POLICY_WEIGHT_COUNT; w++)
+      {
+        out[w] = uniform(random) < 0.5f ? mother[w] : father[w];
+        if (uniform(random) < 0.1f)
+        {
+          out[w] += 0.3f * gaussian(random);
+        }
+      }
+    }
+
+    genomes.swap(next);
+  }
+
+  std::chrono::duration<double> total = std::chrono::steady_clock::now() - train_start;
+  size_t best = order[0];
+  printf("trained in %.1f s; best genome survives %.0f ticks, score %.1f\n",
+         total.count(), fitness[best], mean_score[best]);
+
+  if (options.export_path)
+  {
+    if (!write_header(options.export_path, &genomes[best * POLICY_WEIGHT_COUNT],
+                      options, fitness[best], mean_score[best]))
+    {
+      fprintf(stderr, "%s: cannot write\n", options.export_path);
+      return 1;
+    }
+    printf("exported %s\n", options.export_path);
+  }
+
+  return 0;
+}
+
+// EOF
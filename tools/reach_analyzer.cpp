@@ -0,0 +1,723 @@
+// tools/reach_analyzer.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Reachability analyzer for pipe layouts. For every pair of consecutive gap
+// heights it decides whether any flap sequence gets the bird through both
+// pipes, using the current tuning constants and the real collision test.
+//
+// The bird's state is (height, velocity). Velocity is exact: it is set by
+// the last flap and then grows by gravity every tick, so it is tracked as
+// a row index (ticks since the last flap). Height is tracked on a grid of
+// 1/scale pixel, with scale picked so every step lands exactly on the grid
+// (the report says so if no such scale exists). One bitset over the height
+// grid per velocity row holds the set of live states.
+//
+// Collision is swept (Physics::sweep) and the bird is tilted by its
+// velocity, so whether a bird survives a tick depends on its velocity row
+// and its move as well as on where it ends up. Each tick gets one
+// collision mask per velocity row. The analyzer's rule is stricter than
+// the game's: on any tick a pipe comes within the bird's widest reach
+// (over every tilt), a bird dies if the box around its tilted sprite,
+// stretched over the whole move, reaches into the pipe's span of heights.
+// The game also needs the pipe to be beside the bird at that moment and
+// the rotated sprite's pixels to touch it, so every layout this rule can
+// clear the game can clear too, and an impossible layout is never missed.
+//
+// Pipe timing comes from running advance_pipes itself. Each pair of
+// consecutive pipes A, B is split where B first overlaps the bird:
+//   - forward, per gap height a: every state a bird can be in at that
+//     moment, starting from any state in front of A
+//   - backward, per gap height b: every state from which B can be cleared
+// A pair (a, b) is feasible if the two sets meet. The sources and targets
+// are independent, so both passes run in parallel over gap heights.
+//
+// Usage: reach_analyzer [--threads N] [--pbm FILE] [--check]
+//
+// --pbm writes the table as a PIPE_Y_COUNT x PIPE_Y_COUNT bitmap (row =
+// first gap, column = next gap, black = impossible). --check exits with
+// status 1 if any layout the game can generate is impossible.
+
+// C++ Standard Library
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project headers
+#include "bird_shape.hpp"
+#include "constants.hpp"
+#include "physics.hpp"
+#include "pipe.hpp"
+#include "rng.hpp"
+#include "work_pool.hpp"
+
+typedef std::chrono::steady_clock Clock;
+
+// ============================================================================
+// State Model
+// ============================================================================
+
+struct Model
+{
+  int scale;    // Grid cells per pixel
+  bool exact;   // Every move lands on the grid
+  int cells;    // Heights [0, GROUND_Y) in grid cells
+  int words;    // u64 words per bitset row
+
+  // Velocity rows. Rows [0, flap_rows) follow a flap (row 0 is the flap
+  // itself); the rest follow the initial velocity of 0 at the start of a
+  // run. A bird in a row whose next is -1 has fallen further than the
+  // screen is tall, so it cannot be alive a tick later.
+  std::vector<Scalar> velocity;
+  std::vector<int> next;
+  std::vector<int> shift;  // Cells moved on the tick that enters the row
+  int flap_rows;
+  int start_row;
+  int start_cell;
+};
+
+// Append a velocity chain starting at v, in Physics::update_bird's float
+// arithmetic
+static void add_chain(Model& model, Scalar v)
+{
+  Scalar fallen = 0;
+  for (;;)
+  {
+    int row = static_cast<int>(model.velocity.size());
+    model.velocity.push_back(v);
+    model.next.push_back(-1);
+
+    if (v > 0)
+    {
+      fallen += v;
+    }
+    if (fallen > GROUND_Y)
+    {
+      break;
+    }
+
+    model.next[row] = row + 1;
+    v += Physics::gravity;
+  }
+}
+
+static Model build_model()
+{
+  Model model;
+  add_chain(model, Physics::flap_height);
+  model.flap_rows = static_cast<int>(model.velocity.size());
+  model.start_row = model.flap_rows;
+  add_chain(model, 0);
+
+  // Smallest power-of-two grid that holds every position exactly
+  model.scale = 16;
+  model.exact = false;
+  for (int scale = 1; scale <= 16; scale *= 2)
+  {
+    bool fits = std::floor(BIRD_START_Y * scale) == BIRD_START_Y * scale;
+    for (Scalar velocity : model.velocity)
+    {
+      const float v = to_float(velocity);
+      fits = fits && std::floor(v * scale) == v * scale;
+    }
+    if (fits)
+    {
+      model.scale = scale;
+      model.exact = true;
+      break;
+    }
+  }
+
+  model.cells = GROUND_Y * model.scale;
+  model.words = (model.cells + 63) / 64;
+  model.start_cell = static_cast<int>(std::lround(BIRD_START_Y * model.scale));
+  for (Scalar v : model.velocity)
+  {
+    model.shift.push_back(static_cast<int>(std::lround(to_float(v) * model.scale)));
+  }
+  return model;
+}
+
+// ============================================================================
+// Bitsets
+// ============================================================================
+
+// dst |= src moved by delta cells (towards the ground if positive)
+static void shift_or(u64* dst, const u64* src, int delta, int words)
+{
+  if (delta >= 0)
+  {
+    int word_shift = delta / 64;
+    int bit_shift = delta % 64;
+    for (int i = words - 1; i >= word_shift; i--)
+    {
+      u64 value = src[i - word_shift] << bit_shift;
+      if (bit_shift && i - word_shift - 1 >= 0)
+      {
+        value |= src[i - word_shift - 1] >> (64 - bit_shift);
+      }
+      dst[i] |= value;
+    }
+  }
+  else
+  {
+    int word_shift = -delta / 64;
+    int bit_shift = -delta % 64;
+    for (int i = 0; i + word_shift < words; i++)
+    {
+      u64 value = src[i + word_shift] >> bit_shift;
+      if (bit_shift && i + word_shift + 1 < words)
+      {
+        value |= src[i + word_shift + 1] << (64 - bit_shift);
+      }
+      dst[i] |= value;
+    }
+  }
+}
+
+static bool any(const u64* row, int words)
+{
+  for (int i = 0; i < words; i++)
+  {
+    if (row[i])
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static Scalar height_at(const Model& model, int cell)
+{
+  return Scalar(static_cast<float>(cell) / model.scale);
+}
+
+// Whether a bird that moved into velocity row r and ended the tick at
+// `cell` dies, with `pipe` beside it (nullptr for open air)
+static bool dies(const Model& model, int r, int cell, const Pipe* pipe)
+{
+  const BirdShape& shape = bird_shape(bird_tilt(model.velocity[r]));
+  const Scalar to = height_at(model, cell);
+  if (to + shape.top < 0 || to + shape.bottom >= GROUND_Y)
+  {
+    return true;
+  }
+  if (!pipe)
+  {
+    return false;
+  }
+
+  // The whole move against the edges Physics::pipe_contact tests first
+  const Scalar from = height_at(model, cell - model.shift[r]);
+  const Scalar high = (from < to ? from : to) + shape.top;
+  const Scalar low = (from < to ? to : from) + shape.bottom;
+  const bool top_pipe = !(low < 0) && !(high > pipe->y - PIPE_GAP);
+  const bool bottom_pipe = !(low < pipe->y) && !(high > GROUND_Y);
+  return top_pipe || bottom_pipe;
+}
+
+// Live heights per velocity row on a tick with `pipe` near the bird
+// (nullptr for none): row r holds the heights a bird can end the tick at
+// after moving with velocity r
+static std::vector<u64> build_mask(const Model& model, const Pipe* pipe)
+{
+  const int rows = static_cast<int>(model.velocity.size());
+  std::vector<u64> mask(static_cast<size_t>(rows) * model.words, 0);
+  for (int r = 0; r < rows; r++)
+  {
+    u64* row = &mask[static_cast<size_t>(r) * model.words];
+    for (int cell = 0; cell < model.cells; cell++)
+    {
+      if (!dies(model, r, cell, pipe))
+      {
+        row[cell / 64] |= u64(1) << (cell % 64);
+      }
+    }
+  }
+  return mask;
+}
+
+// Rows x words state sets
+struct StateSet
+{
+  std::vector<u64> bits;
+
+  StateSet(const Model& model)
+    : bits(model.velocity.size() * model.words, 0)
+  {
+  }
+
+  u64* row(const Model& model, int r)
+  {
+    return &bits[static_cast<size_t>(r) * model.words];
+  }
+  const u64* row(const Model& model, int r) const
+  {
+    return &bits[static_cast<size_t>(r) * model.words];
+  }
+};
+
+// One tick forward: move every state without and with a flap, then keep
+// the ones the tick's collision mask (one bitset per row) lets live
+static void step_forward(const Model& model, const StateSet& from, StateSet& to,
+                         const u64* mask)
+{
+  std::fill(to.bits.begin(), to.bits.end(), 0);
+  const int rows = static_cast<int>(model.velocity.size());
+  for (int r = 0; r < rows; r++)
+  {
+    const u64* source = from.row(model, r);
+    if (!any(source, model.words))
+    {
+      continue;
+    }
+    int n = model.next[r];
+    if (n >= 0)
+    {
+      shift_or(to.row(model, n), source, model.shift[n], model.words);
+    }
+    shift_or(to.row(model, 0), source, model.shift[0], model.words);
+  }
+
+  for (int r = 0; r < rows; r++)
+  {
+    u64* row = to.row(model, r);
+    const u64* live = mask + static_cast<size_t>(r) * model.words;
+    for (int i = 0; i < model.words; i++)
+    {
+      row[i] &= live[i];
+    }
+  }
+}
+
+// Step through a run of ticks; kinds[t] is tick t's kind (see
+// find_shapes) and masks[kind] its collision mask. In open air the live
+// set soon stops changing, after which the rest of that stretch can be
+// skipped.
+static void run_forward(const Model& model, StateSet& current, StateSet& scratch,
+                        const std::vector<u8>& kinds,
+                        const std::vector<const u64*>& masks)
+{
+  for (size_t t = 0; t < kinds.size(); t++)
+  {
+    step_forward(model, current, scratch, masks[kinds[t]]);
+    std::swap(current, scratch);
+
+    if (!kinds[t] && current.bits == scratch.bits)
+    {
+      while (t + 1 < kinds.size() && !kinds[t + 1])
+      {
+        t++;
+      }
+    }
+  }
+}
+
+// One tick backward over the flap rows: a state is good if a move from it
+// survives this tick's mask into a good state
+static void step_backward(const Model& model, const StateSet& after,
+                          StateSet& before, StateSet& scratch, const u64* mask)
+{
+  for (int r = 0; r < model.flap_rows; r++)
+  {
+    const u64* good = after.row(model, r);
+    const u64* allowed = mask + static_cast<size_t>(r) * model.words;
+    u64* live = scratch.row(model, r);
+    for (int i = 0; i < model.words; i++)
+    {
+      live[i] = good[i] & allowed[i];
+    }
+  }
+
+  std::fill(before.bits.begin(), before.bits.end(), 0);
+  for (int r = 0; r < model.flap_rows; r++)
+  {
+    u64* out = before.row(model, r);
+    int n = model.next[r];
+    if (n >= 0)
+    {
+      shift_or(out, scratch.row(model, n), -model.shift[n], model.words);
+    }
+    shift_or(out, scratch.row(model, 0), -model.shift[0], model.words);
+  }
+}
+
+// ============================================================================
+// Pipe Timing
+// ============================================================================
+
+// Tick kinds: whether a pipe comes within the bird's reach on a tick
+enum : u8
+{
+  TICK_OPEN = 0,
+  TICK_PIPE = 1
+};
+
+// Tick kinds around one pair of pipes
+struct PairShape
+{
+  std::vector<u8> lead;   // Ticks from A's first overlap to B's: A's kinds
+  std::vector<u8> pass;   // Ticks from B's first overlap to its last: B's kinds
+
+  bool operator==(const PairShape& other) const
+  {
+    return lead == other.lead && pass == other.pass;
+  }
+};
+
+static u8 tick_kind(const Pipe& pipe)
+{
+  const Scalar bird_x = Scalar(BIRD_START_X);
+  Scalar enter, exit;
+  return Physics::overlap_window(bird_x + bird_reach_left(), bird_x + bird_reach_right(),
+                                 pipe, enter, exit) ? TICK_PIPE : TICK_OPEN;
+}
+
+// Run the real pipe logic long enough to see every spacing it produces
+static void find_shapes(std::vector<PairShape>& shapes, std::vector<u8>& opening)
+{
+  Rng rng(0);
+  Pipe pipes[2] = { Pipe(rng), Pipe(rng) };
+  bool first_round = true;
+
+  const int ticks = static_cast<int>(8 * (SCREEN_WIDTH + PIPE_WIDTH) / PIPE_SPEED);
+  std::vector<u8> kind[2];
+  for (int t = 0; t < ticks; t++)
+  {
+    // Collision sees the pipes before they move this tick
+    kind[0].push_back(tick_kind(pipes[0]));
+    kind[1].push_back(tick_kind(pipes[1]));
+    advance_pipes(pipes[0], pipes[1], first_round, rng);
+  }
+
+  // Overlap spans in order: (first tick, last tick, pipe)
+  struct Span
+  {
+    int first, last, pipe;
+  };
+  std::vector<Span> spans;
+  for (int p = 0; p < 2; p++)
+  {
+    for (int t = 0; t < ticks; t++)
+    {
+      if (kind[p][t] && (t == 0 || !kind[p][t - 1]))
+      {
+        int last = t;
+        while (last + 1 < ticks && kind[p][last + 1])
+        {
+          last++;
+        }
+        if (last + 1 < ticks)
+        {
+          spans.push_back({ t, last, p });
+        }
+      }
+    }
+  }
+  std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b)
+  {
+    return a.first < b.first;
+  });
+
+  // From the start of a run through the first pipe
+  opening.assign(kind[spans[0].pipe].begin(),
+                 kind[spans[0].pipe].begin() + spans[0].last + 1);
+
+  for (size_t i = 0; i + 1 < spans.size(); i++)
+  {
+    const Span& a = spans[i];
+    const Span& b = spans[i + 1];
+    PairShape shape;
+    for (int t = a.first; t < b.first; t++)
+    {
+      shape.lead.push_back(kind[a.pipe][t]);
+      if (kind[b.pipe][t])
+      {
+        fprintf(stderr, "pipes overlap the bird at the same time\n");
+        exit(2);
+      }
+    }
+    for (int t = b.first; t <= b.last; t++)
+    {
+      shape.pass.push_back(kind[b.pipe][t]);
+    }
+
+    if (std::find(shapes.begin(), shapes.end(), shape) == shapes.end())
+    {
+      shapes.push_back(shape);
+    }
+  }
+}
+
+// ============================================================================
+// Report
+// ============================================================================
+
+// Feasible next-gap ranges of one table row, as text
+static void format_ranges(const u8* row, char* out, size_t size)
+{
+  size_t used = 0;
+  out[0] = '\0';
+  for (int b = 0; b < PIPE_Y_COUNT; b++)
+  {
+    if (!row[b] || (b > 0 && row[b - 1]))
+    {
+      continue;
+    }
+    int end = b;
+    while (end + 1 < PIPE_Y_COUNT && row[end + 1])
+    {
+      end++;
+    }
+    used += snprintf(out + used, used < size ? size - used : 0, "%s%d..%d",
+                     used ? ", " : "", PIPE_Y_MIN + b, PIPE_Y_MIN + end);
+  }
+  if (!used)
+  {
+    snprintf(out, size, "none");
+  }
+}
+
+static bool write_pbm(const char* path, const std::vector<u8>& table)
+{
+  FILE* file = fopen(path, "wb");
+  if (!file)
+  {
+    return false;
+  }
+
+  fprintf(file, "P4\n%d %d\n", PIPE_Y_COUNT, PIPE_Y_COUNT);
+  std::vector<u8> line((PIPE_Y_COUNT + 7) / 8);
+  for (int a = 0; a < PIPE_Y_COUNT; a++)
+  {
+    std::fill(line.begin(), line.end(), 0);
+    for (int b = 0; b < PIPE_Y_COUNT; b++)
+    {
+      if (!table[a * PIPE_Y_COUNT + b])
+      {
+        line[b / 8] |= 0x80 >> (b % 8);
+      }
+    }
+    fwrite(line.data(), 1, line.size(), file);
+  }
+  return fclose(file) == 0;
+}
+
+static double milliseconds(Clock::time_point from, Clock::time_point to)
+{
+  return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+int main(int argc, char** argv)
+{
+  unsigned threads = 0;
+  const char* pbm_path = nullptr;
+  bool check = false;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+    {
+      threads = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--pbm") == 0 && i + 1 < argc)
+    {
+      pbm_path = argv[++i];
+    }
+    else if (strcmp(argv[i], "--check") == 0)
+    {
+      check = true;
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--threads N] [--pbm FILE] [--check]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  Clock::time_point start = Clock::now();
+
+  const Model model = build_model();
+  std::vector<PairShape> shapes;
+  std::vector<u8> opening;
+  find_shapes(shapes, opening);
+
+  // Collision masks per gap height: no pipe near the bird or the pipe
+  // near it
+  const std::vector<u64> open_mask = build_mask(model, nullptr);
+
+  WorkPool pool(threads);
+
+  std::vector<std::vector<u64>> pipe_masks(PIPE_Y_COUNT);
+  pool.parallel_for(PIPE_Y_COUNT, [&](size_t h, unsigned)
+  {
+    Rng rng(0);
+    Pipe pipe(rng);
+    pipe.x = Scalar(BIRD_START_X);
+    pipe.y = PIPE_Y_MIN + static_cast<int>(h);
+    pipe_masks[h] = build_mask(model, &pipe);
+  });
+
+  std::vector<std::vector<const u64*>> gap_masks(PIPE_Y_COUNT);
+  for (int h = 0; h < PIPE_Y_COUNT; h++)
+  {
+    gap_masks[h] = { open_mask.data(), pipe_masks[h].data() };
+  }
+  Clock::time_point setup_done = Clock::now();
+
+  // Forward: live states when B reaches the bird, per (shape, a)
+  const size_t tasks = shapes.size() * PIPE_Y_COUNT;
+  std::vector<StateSet> reached(tasks, StateSet(model));
+  pool.parallel_for(tasks, [&](size_t task, unsigned)
+  {
+    const PairShape& shape = shapes[task / PIPE_Y_COUNT];
+    const std::vector<const u64*>& masks = gap_masks[task % PIPE_Y_COUNT];
+
+    StateSet current(model);
+    StateSet scratch(model);
+    for (int r = 0; r < model.flap_rows; r++)
+    {
+      std::copy(open_mask.begin() + r * model.words,
+                open_mask.begin() + (r + 1) * model.words, current.row(model, r));
+    }
+    run_forward(model, current, scratch, shape.lead, masks);
+    reached[task] = std::move(current);
+  });
+  Clock::time_point forward_done = Clock::now();
+
+  // Backward: states that get past B, per (shape, b)
+  std::vector<StateSet> clears(tasks, StateSet(model));
+  pool.parallel_for(tasks, [&](size_t task, unsigned)
+  {
+    const PairShape& shape = shapes[task / PIPE_Y_COUNT];
+    const std::vector<const u64*>& masks = gap_masks[task % PIPE_Y_COUNT];
+
+    StateSet good(model);
+    StateSet before(model);
+    StateSet scratch(model);
+    for (int r = 0; r < model.flap_rows; r++)
+    {
+      std::copy(open_mask.begin() + r * model.words,
+                open_mask.begin() + (r + 1) * model.words, good.row(model, r));
+    }
+    for (size_t t = shape.pass.size(); t-- > 0;)
+    {
+      step_backward(model, good, before, scratch, masks[shape.pass[t]]);
+      std::swap(good, before);
+    }
+    clears[task] = std::move(good);
+  });
+  Clock::time_point backward_done = Clock::now();
+
+  // Meet in the middle; a pair must work with every spacing
+  std::vector<u8> table(PIPE_Y_COUNT * PIPE_Y_COUNT, 1);
+  pool.parallel_for(PIPE_Y_COUNT, [&](size_t a, unsigned)
+  {
+    for (size_t s = 0; s < shapes.size(); s++)
+    {
+      const StateSet& from = reached[s * PIPE_Y_COUNT + a];
+      for (int b = 0; b < PIPE_Y_COUNT; b++)
+      {
+        const StateSet& to = clears[s * PIPE_Y_COUNT + b];
+        bool meet = false;
+        for (size_t i = 0; i < model.flap_rows * size_t(model.words) && !meet; i++)
+        {
+          meet = (from.bits[i] & to.bits[i]) != 0;
+        }
+        if (!meet)
+        {
+          table[a * PIPE_Y_COUNT + b] = 0;
+        }
+      }
+    }
+  });
+
+  // First pipe of a run, from the real starting state
+  std::vector<u8> first_ok(PIPE_Y_COUNT);
+  pool.parallel_for(PIPE_Y_COUNT, [&](size_t a, unsigned)
+  {
+    StateSet current(model);
+    StateSet scratch(model);
+    current.row(model, model.start_row)[model.start_cell / 64] |=
+      u64(1) << (model.start_cell % 64);
+    run_forward(model, current, scratch, opening, gap_masks[a]);
+    first_ok[a] = any(current.bits.data(), static_cast<int>(current.bits.size()));
+  });
+  Clock::time_point done = Clock::now();
+
+  // --------------------------------------------------------------------------
+  // Report
+  // --------------------------------------------------------------------------
+
+  size_t impossible = std::count(table.begin(), table.end(), 0);
+  size_t bad_first = std::count(first_ok.begin(), first_ok.end(), 0);
+
+  printf("tick rate:       %d Hz (gravity %g, flap %g, pipe speed %g)\n",
+         SIM_TICK_RATE, to_float(Physics::gravity),
+         to_float(Physics::flap_height), PIPE_SPEED);
+  printf("gap heights:     %d..%d, gap %d px\n", PIPE_Y_MIN,
+         PIPE_Y_MIN + PIPE_Y_COUNT - 1, PIPE_GAP);
+  printf("state grid:      1/%d px, %d heights x %zu velocities (%s)\n",
+         model.scale, model.cells, model.velocity.size(),
+         model.exact ? "exact" : "rounded, approximate");
+  printf("pipe spacings:   ");
+  for (size_t s = 0; s < shapes.size(); s++)
+  {
+    printf("%s%zu ticks", s ? ", " : "", shapes[s].lead.size());
+  }
+  printf("\n\n");
+
+  // Rows with the same feasible set are printed once
+  char ranges[512];
+  char previous[512] = "";
+  int group_start = 0;
+  for (int a = 0; a <= PIPE_Y_COUNT; a++)
+  {
+    if (a < PIPE_Y_COUNT)
+    {
+      format_ranges(&table[a * PIPE_Y_COUNT], ranges, sizeof(ranges));
+    }
+    if (a > 0 && (a == PIPE_Y_COUNT || strcmp(ranges, previous) != 0))
+    {
+      printf("gap %3d..%3d -> next %s\n", PIPE_Y_MIN + group_start,
+             PIPE_Y_MIN + a - 1, previous);
+      group_start = a;
+    }
+    strcpy(previous, ranges);
+  }
+
+  format_ranges(first_ok.data(), ranges, sizeof(ranges));
+  printf("first pipe       %s\n\n", ranges);
+
+  printf("impossible:      %zu of %d pairs, %zu first gaps\n", impossible,
+         PIPE_Y_COUNT * PIPE_Y_COUNT, bad_first);
+  printf("threads:         %u\n", pool.size());
+  printf("setup:           %.1f ms\n", milliseconds(start, setup_done));
+  printf("forward:         %.1f ms\n", milliseconds(setup_done, forward_done));
+  printf("backward:        %.1f ms\n", milliseconds(forward_done, backward_done));
+  printf("meet and first:  %.1f ms\n", milliseconds(backward_done, done));
+  printf("total:           %.1f ms\n", milliseconds(start, done));
+
+  if (pbm_path && !write_pbm(pbm_path, table))
+  {
+    fprintf(stderr, "%s: cannot write\n", pbm_path);
+    return 1;
+  }
+
+  return check && (impossible || bad_first) ? 1 : 0;
+}
+
+// EOF
@@ -0,0 +1,213 @@
+// tools/replay_verify.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Batch replay verifier for high-score events. Re-simulates every replay
+// in a directory through Physics/Pipe and checks the claimed score and
+// run length against the result. Files are spread over all cores with a
+// work-stealing pool.
+//
+// Usage: replay_verify [--threads N] [--max-frames N] [--quiet] DIR
+//
+// Exit status is 0 only if every file verified.
+
+// C++ Standard Library
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project headers
+#include "constants.hpp"
+#include "replay.hpp"
+#include "work_pool.hpp"
+
+enum class Verdict
+{
+  Ok,
+  Unreadable,  // I/O error, bad header or wrong tick rate
+  Mismatch,    // Simulated result differs from the claim
+  Timeout      // Still alive after --max-frames ticks
+};
+
+struct FileResult
+{
+  Verdict verdict = Verdict::Unreadable;
+  ReplayInfo claimed;
+  ReplayResult actual;
+};
+
+static bool read_file(const std::string& path, std::vector<u8>& buffer)
+{
+  FILE* file = fopen(path.c_str(), "rb");
+  if (!file)
+  {
+    return false;
+  }
+
+  buffer.resize(REPLAY_MAX_SIZE);
+  size_t size = fread(buffer.data(), 1, buffer.size(), file);
+  bool truncated = size == buffer.size() && fgetc(file) != EOF;
+  fclose(file);
+
+  buffer.resize(size);
+  return !truncated;
+}
+
+int main(int argc, char** argv)
+{
+  unsigned threads = 0;
+  u32 max_frames = 10 * 60 * 60 * SIM_TICK_RATE;  // Ten hours of play
+  bool quiet = false;
+  const char* directory = nullptr;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+    {
+      threads = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--max-frames") == 0 && i + 1 < argc)
+    {
+      max_frames = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--quiet") == 0)
+    {
+      quiet = true;
+    }
+    else if (argv[i][0] != '-' && !directory)
+    {
+      directory = argv[i];
+    }
+    else
+    {
+      directory = nullptr;
+      break;
+    }
+  }
+
+  if (!directory)
+  {
+    fprintf(stderr, "Usage: %s [--threads N] [--max-frames N] [--quiet] DIR\n",
+            argv[0]);
+    return 2;
+  }
+
+  std::vector<std::string> paths;
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+  {
+    if (entry.is_regular_file())
+    {
+      paths.push_back(entry.path().string());
+    }
+  }
+  if (error)
+  {
+    fprintf(stderr, "%s: %s\n", directory, error.message().c_str());
+    return 2;
+  }
+
+  WorkPool pool(threads);
+  std::vector<FileResult> results(paths.size());
+  std::vector<std::vector<u8>> buffers(pool.size());
+  std::atomic<u64> total_frames{0};
+
+  auto start = std::chrono::steady_clock::now();
+
+  pool.parallel_for(paths.size(), [&](size_t index, unsigned worker)
+  {
+    std::vector<u8>& buffer = buffers[worker];
+    FileResult& result = results[index];
+
+    if (!read_file(paths[index], buffer) ||
+        !read_replay_info(buffer.data(), buffer.size(), result.claimed))
+    {
+      return;
+    }
+
+    result.actual = simulate_replay(buffer.data(), buffer.size(), max_frames);
+    total_frames.fetch_add(result.actual.frames, std::memory_order_relaxed);
+
+    if (!result.actual.valid)
+    {
+      result.verdict = Verdict::Unreadable;
+    }
+    else if (result.actual.frames >= max_frames)
+    {
+      result.verdict = Verdict::Timeout;
+    }
+    else if (result.actual.score != result.claimed.score ||
+             result.actual.frames != result.claimed.frames ||
+             result.actual.unused_input)
+    {
+      result.verdict = Verdict::Mismatch;
+    }
+    else
+    {
+      result.verdict = Verdict::Ok;
+    }
+  });
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  double seconds = elapsed.count();
+
+  size_t counts[4] = {};
+  for (size_t i = 0; i < paths.size(); i++)
+  {
+    const FileResult& result = results[i];
+    counts[static_cast<int>(result.verdict)]++;
+
+    if (quiet)
+    {
+      continue;
+    }
+
+    switch (result.verdict)
+    {
+      case Verdict::Ok:
+        break;
+      case Verdict::Unreadable:
+        printf("UNREADABLE %s\n", paths[i].c_str());
+        break;
+      case Verdict::Timeout:
+        printf("TIMEOUT    %s: still alive after %u frames\n",
+               paths[i].c_str(), result.actual.frames);
+        break;
+      case Verdict::Mismatch:
+        printf("MISMATCH   %s: claimed score %u in %u frames, "
+               "got score %u in %u frames%s\n",
+               paths[i].c_str(), result.claimed.score, result.claimed.frames,
+               result.actual.score, result.actual.frames,
+               result.actual.unused_input ? " (input after death)" : "");
+        break;
+    }
+  }
+
+  printf("replays:        %zu\n", paths.size());
+  printf("verified:       %zu\n", counts[static_cast<int>(Verdict::Ok)]);
+  printf("mismatched:     %zu\n", counts[static_cast<int>(Verdict::Mismatch)]);
+  printf("unreadable:     %zu\n", counts[static_cast<int>(Verdict::Unreadable)]);
+  printf("timed out:      %zu\n", counts[static_cast<int>(Verdict::Timeout)]);
+  printf("threads:        %u\n", pool.size());
+  printf("elapsed:        %.3f s\n", seconds);
+  printf("replays/second: %.0f\n", seconds > 0 ? paths.size() / seconds : 0.0);
+  printf("ticks/second:   %.0f\n", seconds > 0 ? total_frames.load() / seconds : 0.0);
+
+  return counts[static_cast<int>(Verdict::Ok)] == paths.size() ? 0 : 1;
+}
+
+// EOF
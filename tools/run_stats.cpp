@@ -0,0 +1,647 @@
+// tools/run_stats.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Aggregates a corpus of runs: telemetry.bin files (see telemetry.hpp) and
+// replays (see replay.hpp), given as files or directories searched
+// recursively. Writes to the output directory:
+//   scores.csv       runs per final score
+//   survival.csv     runs that reached each pipe, and the fraction
+//   transitions.csv  per change in gap height between one pipe and the
+//                    next: runs that faced it and runs that died there
+//   heatmap.csv      where birds died relative to the gap they died at
+//   survival.png     the survival curve
+//   heatmap.png      the death heatmap, with the gap drawn in
+//
+// Gap heights come from the run seed alone (see Pipe), so telemetry gives
+// scores, survival and transitions without any input. Death positions need
+// the run itself, so only replays feed the heatmap; they are re-simulated
+// the way GameState plays them.
+//
+// Files are memory-mapped and parsed in place: a telemetry record is
+// decoded on the stack and a replay is read by a ReplayPlayer over the
+// mapping, and every count goes into fixed arrays per worker, merged at
+// the end. Large telemetry files are split into pieces so one console's
+// log does not hold up the rest.
+//
+// Usage: run_stats [--out DIR] [--threads N] [--max-frames N] [--all-modes]
+//                  PATH...
+//
+// Only player runs and ghost races count unless --all-modes also takes in
+// practice runs and autopilot demos.
+
+// C++ Standard Library
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// System libraries
+#include <fcntl.h>
+#include <png.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Project headers
+#include "constants.hpp"
+#include "physics.hpp"
+#include "pipe.hpp"
+#include "replay.hpp"
+#include "telemetry.hpp"
+#include "work_pool.hpp"
+
+// Scores at or past this share the last bucket
+static const int MAX_SCORE = 1023;
+
+// Gap height change from one pipe to the next, in DY_STEP pixel buckets
+static const int DY_STEP = 8;
+static const int DY_BUCKETS = (2 * PIPE_Y_COUNT + DY_STEP - 1) / DY_STEP;
+
+// Heatmap of the bird's center relative to the pipe it died at: x from
+// the pipe's left edge, y from the middle of its gap
+static const int HEAT_CELL = 4;
+static const int HEAT_LEFT = -96;
+static const int HEAT_RIGHT = PIPE_WIDTH + 96;
+static const int HEAT_TOP = -SCREEN_HEIGHT / 2;
+static const int HEAT_BOTTOM = SCREEN_HEIGHT / 2;
+static const int HEAT_W = (HEAT_RIGHT - HEAT_LEFT) / HEAT_CELL;
+static const int HEAT_H = (HEAT_BOTTOM - HEAT_TOP) / HEAT_CELL;
+
+// Telemetry records per work item
+static const size_t ITEM_RECORDS = 1 << 16;
+
+static const int CAUSE_COUNT = static_cast<int>(Surface::Ground) + 1;
+static const char* const CAUSE_NAMES[CAUSE_COUNT] = { "none", "pipe_top", "pipe_bottom",
+                                                      "ceiling", "ground" };
+
+// ============================================================================
+// Aggregates
+// ============================================================================
+
+struct Stats
+{
+  u64 telemetry_runs = 0;
+  u64 replay_runs = 0;
+  u64 skipped_runs = 0;  // Other modes, versions or builds
+  u64 bad_files = 0;
+  u64 outside_heatmap = 0;
+  u64 scores[MAX_SCORE + 1] = {};
+  u64 causes[CAUSE_COUNT] = {};
+  u64 faced[DY_BUCKETS] = {};
+  u64 died[DY_BUCKETS] = {};
+  u32 heat[HEAT_H][HEAT_W] = {};
+
+  void merge(const Stats& other)
+  {
+    telemetry_runs += other.telemetry_runs;
+    replay_runs += other.replay_runs;
+    skipped_runs += other.skipped_runs;
+    bad_files += other.bad_files;
+    outside_heatmap += other.outside_heatmap;
+    for (int i = 0; i <= MAX_SCORE; i++)
+    {
+      scores[i] += other.scores[i];
+    }
+    for (int i = 0; i < CAUSE_COUNT; i++)
+    {
+      causes[i] += other.causes[i];
+    }
+    for (int i = 0; i < DY_BUCKETS; i++)
+    {
+      faced[i] += other.faced[i];
+      died[i] += other.died[i];
+    }
+    for (int y = 0; y < HEAT_H; y++)
+    {
+      for (int x = 0; x < HEAT_W; x++)
+      {
+        heat[y][x] += other.heat[y][x];
+      }
+    }
+  }
+};
+
+static int dy_bucket(int dy)
+{
+  return (dy + PIPE_Y_COUNT - 1) / DY_STEP;
+}
+
+// A run that ended on pipe `score` (0-based): the score histogram, and
+// every gap change it went through, replaying the layout from the seed
+static void add_run(Stats& stats, u32 seed, u32 score, u8 cause)
+{
+  stats.scores[std::min<u32>(score, MAX_SCORE)]++;
+  stats.causes[cause < CAUSE_COUNT ? cause : 0]++;
+
+  // Same draws as GameState::start_run and advance_pipes: one per pipe
+  Rng rng(seed);
+  Pipe pipe(rng);
+  int previous = to_pixel(pipe.y);
+  for (u32 index = 1; index <= score; index++)
+  {
+    pipe.reset(rng);
+    const int y = to_pixel(pipe.y);
+    const int bucket = dy_bucket(y - previous);
+    stats.faced[bucket]++;
+    if (index == score)
+    {
+      stats.died[bucket]++;
+    }
+    previous = y;
+  }
+}
+
+static bool wanted_mode(u8 mode, bool all_modes)
+{
+  return all_modes || mode == static_cast<u8>(TelemetryMode::Player) ||
+         mode == static_cast<u8>(TelemetryMode::GhostRace);
+}
+
+// ============================================================================
+// Inputs
+// ============================================================================
+
+// Read-only mapping of a whole file, released on destruction
+class MappedFile
+{
+private:
+  const u8* bytes = nullptr;
+  size_t length = 0;
+
+public:
+  explicit MappedFile(const std::string& path)
+  {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+      void* mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping != MAP_FAILED)
+      {
+        bytes = static_cast<const u8*>(mapping);
+        length = info.st_size;
+      }
+    }
+    close(fd);
+  }
+
+  ~MappedFile()
+  {
+    if (bytes)
+    {
+      munmap(const_cast<u8*>(bytes), length);
+    }
+  }
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  const u8* data() const
+  {
+    return bytes;
+  }
+  size_t size() const
+  {
+    return length;
+  }
+};
+
+// A file, or a range of records of a large telemetry file
+struct WorkItem
+{
+  size_t path;
+  size_t first_record;
+  size_t record_count;  // 0: the whole file, of either kind
+};
+
+static void add_telemetry(Stats& stats, const u8* data, size_t count, bool all_modes)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    RunRecord record;
+    if (!decode_run_record(data + i * TELEMETRY_RECORD_SIZE, record) ||
+        !wanted_mode(record.mode, all_modes))
+    {
+      stats.skipped_runs++;
+      continue;
+    }
+    add_run(stats, record.seed, record.score, record.cause);
+    stats.telemetry_runs++;
+  }
+}
+
+// Re-simulates the run in the same order as simulate_replay and records
+// where it ended relative to the nearer pipe
+static void add_replay(Stats& stats, const u8* data, size_t size, u32 max_frames)
+{
+  ReplayPlayer player;
+  if (!player.open(data, size))
+  {
+    stats.skipped_runs++;
+    return;
+  }
+
+  Rng rng(player.get_info().seed);
+  Pipe pipe_1(rng);
+  Pipe pipe_2(rng);
+  bool first_round = true;
+  Physics physics;
+  u32 frames = 0;
+  while (!physics.dead && frames < max_frames)
+  {
+    physics.update_bird(player.next(), pipe_1, pipe_2);
+    advance_pipes(pipe_1, pipe_2, first_round, rng);
+    frames++;
+  }
+  if (!physics.dead)
+  {
+    stats.skipped_runs++;
+    return;
+  }
+
+  add_run(stats, player.get_info().seed, physics.score,
+          static_cast<u8>(physics.contact.surface));
+  stats.replay_runs++;
+
+  // The pipes have moved on by one tick since the contact
+  const Vec2 position = physics.get_position();
+  const float center_x = to_float(position.x) + BIRD_WIDTH * BIRD_SCALE / 2;
+  const float center_y = to_float(position.y) + BIRD_HEIGHT * BIRD_SCALE / 2;
+  const float pipe_1_x = to_float(pipe_1.x + pipe_1.get_speed());
+  const float pipe_2_x = to_float(pipe_2.x + pipe_2.get_speed());
+  const bool use_1 = first_round ||
+                     std::fabs(pipe_1_x + PIPE_WIDTH / 2 - center_x) <=
+                     std::fabs(pipe_2_x + PIPE_WIDTH / 2 - center_x);
+  const Pipe& pipe = use_1 ? pipe_1 : pipe_2;
+
+  const int x = static_cast<int>(std::floor(
+    (center_x - (use_1 ? pipe_1_x : pipe_2_x) - HEAT_LEFT) / HEAT_CELL));
+  const int y = static_cast<int>(std::floor(
+    (center_y - (to_float(pipe.y) - PIPE_GAP / 2.0f) - HEAT_TOP) / HEAT_CELL));
+  if (x < 0 || x >= HEAT_W || y < 0 || y >= HEAT_H)
+  {
+    stats.outside_heatmap++;
+    return;
+  }
+  stats.heat[y][x]++;
+}
+
+static bool is_replay(const u8* data, size_t size)
+{
+  return size >= 4 && memcmp(data, "FWRP", 4) == 0;
+}
+
+static void process(Stats& stats, const std::string& path, const WorkItem& item,
+                    u32 max_frames, bool all_modes)
+{
+  MappedFile file(path);
+  const u8* data = file.data();
+  const size_t size = file.size();
+  if (!data)
+  {
+    stats.bad_files++;
+    return;
+  }
+
+  if (item.record_count > 0)
+  {
+    add_telemetry(stats, data + item.first_record * TELEMETRY_RECORD_SIZE,
+                  item.record_count, all_modes);
+  }
+  else if (is_replay(data, size))
+  {
+    add_replay(stats, data, size, max_frames);
+  }
+  else if (size % TELEMETRY_RECORD_SIZE == 0)
+  {
+    add_telemetry(stats, data, size / TELEMETRY_RECORD_SIZE, all_modes);
+  }
+  else
+  {
+    stats.bad_files++;
+  }
+}
+
+// ============================================================================
+// Output
+// ============================================================================
+
+static bool write_png(const std::string& path, int width, int height,
+                      const std::vector<u8>& rgb)
+{
+  png_image image = {};
+  image.version = PNG_IMAGE_VERSION;
+  image.width = width;
+  image.height = height;
+  image.format = PNG_FORMAT_RGB;
+  return png_image_write_to_file(&image, path.c_str(), 0, rgb.data(), 0, nullptr) != 0;
+}
+
+// Black through red and yellow to white
+static void heat_color(float t, u8* rgb)
+{
+  const float scaled = t * 3;
+  rgb[0] = static_cast<u8>(255 * std::clamp(scaled, 0.0f, 1.0f));
+  rgb[1] = static_cast<u8>(255 * std::clamp(scaled - 1, 0.0f, 1.0f));
+  rgb[2] = static_cast<u8>(255 * std::clamp(scaled - 2, 0.0f, 1.0f));
+}
+
+static bool write_heatmap(const std::string& dir, const Stats& stats)
+{
+  FILE* csv = fopen((dir + "/heatmap.csv").c_str(), "w");
+  if (!csv)
+  {
+    return false;
+  }
+  fprintf(csv, "x,y,deaths\n");
+  u32 most = 0;
+  for (int y = 0; y < HEAT_H; y++)
+  {
+    for (int x = 0; x < HEAT_W; x++)
+    {
+      if (stats.heat[y][x] > 0)
+      {
+        fprintf(csv, "%d,%d,%u\n", HEAT_LEFT + x * HEAT_CELL, HEAT_TOP + y * HEAT_CELL,
+                stats.heat[y][x]);
+      }
+      most = std::max(most, stats.heat[y][x]);
+    }
+  }
+  const bool ok = fclose(csv) == 0;
+
+  // One pixel per world pixel, log scale so rare spots still show; the
+  // pipe's lips at the gap are drawn in green
+  const int width = HEAT_W * HEAT_CELL;
+  const int height = HEAT_H * HEAT_CELL;
+  std::vector<u8> rgb(static_cast<size_t>(width) * height * 3);
+  for (int py = 0; py < height; py++)
+  {
+    const int world_y = HEAT_TOP + py;
+    const bool in_gap = world_y >= -PIPE_GAP / 2 && world_y < PIPE_GAP / 2;
+    for (int px = 0; px < width; px++)
+    {
+      const int world_x = HEAT_LEFT + px;
+      u8* pixel = &rgb[(static_cast<size_t>(py) * width + px) * 3];
+      const u32 count = stats.heat[py / HEAT_CELL][px / HEAT_CELL];
+      heat_color(most > 0 ? std::log1p(float(count)) / std::log1p(float(most)) : 0.0f,
+                 pixel);
+      const bool pipe_edge = (world_x == 0 || world_x == PIPE_WIDTH - 1) && !in_gap;
+      const bool lip = world_x >= 0 && world_x < PIPE_WIDTH &&
+                       (world_y == -PIPE_GAP / 2 - 1 || world_y == PIPE_GAP / 2);
+      if (count == 0 && (pipe_edge || lip))
+      {
+        pixel[0] = 0x4A;
+        pixel[1] = 0xAB;
+        pixel[2] = 0x3C;
+      }
+    }
+  }
+  return write_png(dir + "/heatmap.png", width, height, rgb) && ok;
+}
+
+static bool write_survival(const std::string& dir, const Stats& stats, u64 runs)
+{
+  FILE* scores = fopen((dir + "/scores.csv").c_str(), "w");
+  FILE* survival = fopen((dir + "/survival.csv").c_str(), "w");
+  if (!scores || !survival)
+  {
+    if (scores)
+    {
+      fclose(scores);
+    }
+    if (survival)
+    {
+      fclose(survival);
+    }
+    return false;
+  }
+
+  int last = 0;
+  fprintf(scores, "score,runs\n");
+  for (int score = 0; score <= MAX_SCORE; score++)
+  {
+    if (stats.scores[score] > 0)
+    {
+      fprintf(scores, "%d,%llu\n", score,
+              static_cast<unsigned long long>(stats.scores[score]));
+      last = score;
+    }
+  }
+
+  // Reaching pipe k means a score of at least k
+  std::vector<double> fraction(last + 1);
+  u64 reached = runs;
+  fprintf(survival, "pipe,reached,fraction\n");
+  for (int pipe = 0; pipe <= last; pipe++)
+  {
+    fraction[pipe] = runs > 0 ? double(reached) / runs : 0.0;
+    fprintf(survival, "%d,%llu,%.6f\n", pipe, static_cast<unsigned long long>(reached),
+            fraction[pipe]);
+    reached -= stats.scores[pipe];
+  }
+  bool ok = fclose(scores) == 0;
+  ok = fclose(survival) == 0 && ok;
+
+  // A step plot, one column band per pipe, on a light background
+  const int width = 640;
+  const int height = 240;
+  std::vector<u8> rgb(static_cast<size_t>(width) * height * 3, 0xF0);
+  for (int px = 0; px < width; px++)
+  {
+    const int pipe = px * (last + 1) / width;
+    const int top = height - 1 - static_cast<int>(fraction[pipe] * (height - 1));
+    for (int py = top; py < height; py++)
+    {
+      u8* pixel = &rgb[(static_cast<size_t>(py) * width + px) * 3];
+      pixel[0] = 0x01;
+      pixel[1] = 0x95;
+      pixel[2] = 0xC3;
+    }
+  }
+  return write_png(dir + "/survival.png", width, height, rgb) && ok;
+}
+
+static bool write_transitions(const std::string& dir, const Stats& stats)
+{
+  FILE* csv = fopen((dir + "/transitions.csv").c_str(), "w");
+  if (!csv)
+  {
+    return false;
+  }
+  fprintf(csv, "dy_from,dy_to,faced,died,death_rate\n");
+  for (int bucket = 0; bucket < DY_BUCKETS; bucket++)
+  {
+    if (stats.faced[bucket] == 0)
+    {
+      continue;
+    }
+    const int from = bucket * DY_STEP - (PIPE_Y_COUNT - 1);
+    fprintf(csv, "%d,%d,%llu,%llu,%.6f\n", from, from + DY_STEP - 1,
+            static_cast<unsigned long long>(stats.faced[bucket]),
+            static_cast<unsigned long long>(stats.died[bucket]),
+            double(stats.died[bucket]) / stats.faced[bucket]);
+  }
+  return fclose(csv) == 0;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv)
+{
+  std::string out_dir = "run_stats";
+  unsigned threads = 0;
+  u32 max_frames = 10 * 60 * 60 * SIM_TICK_RATE;  // Ten hours of play
+  bool all_modes = false;
+  std::vector<std::string> inputs;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+    {
+      out_dir = argv[++i];
+    }
+    else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+    {
+      threads = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--max-frames") == 0 && i + 1 < argc)
+    {
+      max_frames = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--all-modes") == 0)
+    {
+      all_modes = true;
+    }
+    else if (argv[i][0] != '-')
+    {
+      inputs.push_back(argv[i]);
+    }
+    else
+    {
+      inputs.clear();
+      break;
+    }
+  }
+  if (inputs.empty())
+  {
+    fprintf(stderr, "Usage: %s [--out DIR] [--threads N] [--max-frames N] "
+            "[--all-modes] PATH...\n", argv[0]);
+    return 2;
+  }
+
+  // Files, with large telemetry logs cut into pieces. Replays are never
+  // larger than REPLAY_MAX_SIZE, so anything bigger is telemetry.
+  std::vector<std::string> paths;
+  std::vector<WorkItem> items;
+  auto add_file = [&](const std::filesystem::path& path, uintmax_t size)
+  {
+    const size_t index = paths.size();
+    paths.push_back(path.string());
+    if (size <= REPLAY_MAX_SIZE || size % TELEMETRY_RECORD_SIZE != 0)
+    {
+      items.push_back({ index, 0, 0 });
+      return;
+    }
+    const size_t records = size / TELEMETRY_RECORD_SIZE;
+    for (size_t first = 0; first < records; first += ITEM_RECORDS)
+    {
+      items.push_back({ index, first, std::min(ITEM_RECORDS, records - first) });
+    }
+  };
+  for (const std::string& input : inputs)
+  {
+    std::error_code error;
+    if (std::filesystem::is_directory(input, error))
+    {
+      for (const auto& entry : std::filesystem::recursive_directory_iterator(input, error))
+      {
+        if (entry.is_regular_file())
+        {
+          add_file(entry.path(), entry.file_size());
+        }
+      }
+    }
+    else if (std::filesystem::is_regular_file(input, error))
+    {
+      add_file(input, std::filesystem::file_size(input, error));
+    }
+    if (error)
+    {
+      fprintf(stderr, "%s: %s\n", input.c_str(), error.message().c_str());
+      return 2;
+    }
+  }
+
+  WorkPool pool(threads);
+  std::vector<Stats> worker_stats(pool.size());
+
+  auto start = std::chrono::steady_clock::now();
+  pool.parallel_for(items.size(), [&](size_t index, unsigned worker)
+  {
+    const WorkItem& item = items[index];
+    process(worker_stats[worker], paths[item.path], item, max_frames, all_modes);
+  });
+
+  Stats& total = worker_stats[0];
+  for (size_t i = 1; i < worker_stats.size(); i++)
+  {
+    total.merge(worker_stats[i]);
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::error_code error;
+  std::filesystem::create_directories(out_dir, error);
+  const u64 runs = total.telemetry_runs + total.replay_runs;
+  bool ok = write_survival(out_dir, total, runs);
+  ok = write_transitions(out_dir, total) && ok;
+  ok = write_heatmap(out_dir, total) && ok;
+
+  printf("files:          %zu (%llu unreadable)\n", paths.size(),
+         static_cast<unsigned long long>(total.bad_files));
+  printf("runs:           %llu (%llu from telemetry, %llu replays, %llu skipped)\n",
+         static_cast<unsigned long long>(runs),
+         static_cast<unsigned long long>(total.telemetry_runs),
+         static_cast<unsigned long long>(total.replay_runs),
+         static_cast<unsigned long long>(total.skipped_runs));
+  printf("died on:       ");
+  for (int cause = 1; cause < CAUSE_COUNT; cause++)
+  {
+    printf(" %s %llu", CAUSE_NAMES[cause],
+           static_cast<unsigned long long>(total.causes[cause]));
+  }
+  printf("\n");
+  printf("heatmap:        %llu deaths outside it\n",
+         static_cast<unsigned long long>(total.outside_heatmap));
+  printf("elapsed:        %.3f s on %u threads (%.0f runs/s)\n", elapsed.count(),
+         pool.size(), elapsed.count() > 0 ? runs / elapsed.count() : 0.0);
+  if (!ok)
+  {
+    fprintf(stderr, "%s: cannot write results\n", out_dir.c_str());
+    return 1;
+  }
+  return 0;
+}
+
+// EOF
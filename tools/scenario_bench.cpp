@@ -0,0 +1,681 @@
+// tools/scenario_bench.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Scenario benchmarks for GameState. Each scenario puts a fresh game into a
+// fixed situation (untimed), then times a window of ticks. Each tick has
+// three stages, measured separately:
+//
+//   update  GameState::update
+//   render  GameState::render (the whole frame, ground included)
+//   ground  GameState::render_ground on its own (only where it is drawn)
+//
+// For each stage the bench reports nanoseconds per tick (lower quartile over
+// repetitions, timer overhead subtracted), draw calls per frame and heap
+// bytes allocated per tick. The scripted flaps come from the CPU opponent's
+// policy, so every run plays the same games.
+//
+// Usage: scenario_bench [--min-ticks N] [--counts FILE] [--times FILE]
+//                       [--tolerance F] [--write-counts FILE]
+//                       [--write-times FILE]
+//
+// --counts compares draw calls and allocations against a stored run and
+// exits with status 1 if any goes up at all; they do not depend on the
+// machine, so the repository keeps that file. --times does the same for
+// the times, allowing --tolerance (a fraction, default 0.3) for jitter.
+// Times only mean something against a run on the same machine, so that
+// file is made locally (make bench-baseline) and never committed.
+// --write-counts and --write-times store the current numbers.
+
+// C++ Standard Library
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Project headers
+#include "constants.hpp"
+#include "cpu_opponent.hpp"
+#include "game_state.hpp"
+#include "host_platform.hpp"
+
+// ============================================================================
+// Allocation Counting
+// ============================================================================
+
+// The bench is single threaded; plain counters are enough
+static u64 allocated_bytes = 0;
+
+void* operator new(size_t size)
+{
+  allocated_bytes += size;
+  void* block = malloc(size ? size : 1);
+  if (!block)
+  {
+    throw std::bad_alloc();
+  }
+  return block;
+}
+
+void operator delete(void* block) noexcept
+{
+  free(block);
+}
+
+void operator delete(void* block, size_t) noexcept
+{
+  free(block);
+}
+
+// ============================================================================
+// Draw Call Counting
+// ============================================================================
+
+class CountingRenderer : public Renderer
+{
+public:
+  u64 calls = 0;
+
+  void FillScreen(u32) override
+  {
+    calls++;
+  }
+  void Rectangle(f32, f32, f32, f32, u32, bool) override
+  {
+    calls++;
+  }
+  void Plot(f32, f32, u32) override
+  {
+    calls++;
+  }
+  void DrawImage(f32, f32, TextureId, f32, f32, f32, u32) override
+  {
+    calls++;
+  }
+  void PrintText(int, int, FontId, const char*, u32, u32) override
+  {
+    calls++;
+  }
+  void Present() override
+  {
+  }
+};
+
+// ============================================================================
+// Scenarios
+// ============================================================================
+
+static const FlapPolicy pilot(CPU_OPPONENT_WEIGHTS);
+
+static bool pilot_flaps(const GameState& game)
+{
+  GameSnapshot now = game.save_snapshot();
+  return pilot.decide(now.physics.get_y(), now.physics.velocity,
+                      now.pipe_1, now.pipe_2);
+}
+
+// Play untimed ticks until the condition holds
+template <typename Condition>
+static void advance_until(GameState& game, bool flap_by_pilot,
+                          Condition condition)
+{
+  while (!condition(game))
+  {
+    InputState input;
+    if (flap_by_pilot && pilot_flaps(game))
+    {
+      input.buttons = INPUT_BUTTON_A;
+    }
+    game.update(input);
+  }
+}
+
+// Flap straight into the ceiling so the death fall starts from the top
+static void die_at_ceiling(GameState& game, u32 seed)
+{
+  game.start_game(seed);
+  while (!game.save_snapshot().is_dying)
+  {
+    InputState input;
+    input.buttons = INPUT_BUTTON_A;
+    game.update(input);
+  }
+}
+
+// A practice run with a full rewind history: the pilot flies REWIND_SECONDS
+// without crashing, on the first seed from `seed` on where it manages to
+static void fill_rewind_history(GameState& game, u32 seed)
+{
+  for (;; seed++)
+  {
+    game.start_practice(seed);
+    int ticks = 0;
+    advance_until(game, true, [&ticks](const GameState& g)
+    {
+      return g.save_snapshot().is_dying || ticks++ == REWIND_SECONDS * SIM_TICK_RATE;
+    });
+    if (!game.save_snapshot().is_dying)
+    {
+      return;
+    }
+  }
+}
+
+// True when the next tick of a death fall lands and resets to the menu
+static bool lands_next_tick(const GameState& game)
+{
+  GameSnapshot next = game.save_snapshot();
+  step_snapshot(next, false);
+  return next.physics.get_y() + Scalar(BIRD_HEIGHT * BIRD_SCALE) >= GROUND_Y;
+}
+
+struct Scenario
+{
+  const char* name;
+  void (*prepare)(GameState& game, u32 seed);
+  bool (*running)(const GameState& game);  // Window continues while true
+  int max_ticks;
+  bool flap_by_pilot;
+  bool draws_ground;
+  u32 held;                                // Buttons held on every tick
+};
+
+static const Scenario SCENARIOS[] = {
+  {
+    "menu_idle",
+    [](GameState&, u32) {},
+    [](const GameState&) { return true; },
+    ATTRACT_IDLE_TICKS - 1,  // Stop before the attract demo kicks in
+    false,
+    false,
+    0
+  },
+  {
+    "first_round",
+    [](GameState& game, u32 seed) { game.start_game(seed); },
+    [](const GameState& game) { return game.save_snapshot().first_round; },
+    10 * SIM_TICK_RATE,
+    true,
+    true,
+    0
+  },
+  {
+    "two_pipe",
+    [](GameState& game, u32 seed)
+    {
+      game.start_game(seed);
+      advance_until(game, true, [](const GameState& g)
+      {
+        return !g.save_snapshot().first_round;
+      });
+    },
+    [](const GameState& game) { return !game.save_snapshot().is_dying; },
+    20 * SIM_TICK_RATE,
+    true,
+    true,
+    0
+  },
+  {
+    "death_fall",
+    die_at_ceiling,
+    [](const GameState& game) { return !lands_next_tick(game); },
+    10 * SIM_TICK_RATE,
+    false,
+    true,
+    0
+  },
+  {
+    // Holding B in practice, one tick back per tick through a full history
+    "rewind",
+    fill_rewind_history,
+    [](const GameState& game) { return game.can_rewind(); },
+    REWIND_SECONDS * SIM_TICK_RATE,
+    false,
+    true,
+    INPUT_BUTTON_B
+  },
+  {
+    // The landing tick, which goes through handle_collision
+    "reset",
+    [](GameState& game, u32 seed)
+    {
+      die_at_ceiling(game, seed);
+      advance_until(game, false, lands_next_tick);
+    },
+    [](const GameState&) { return true; },
+    1,
+    false,
+    false,
+    0
+  },
+};
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+enum Stage
+{
+  STAGE_UPDATE,
+  STAGE_RENDER,
+  STAGE_GROUND,
+  STAGE_COUNT
+};
+
+static const char* const STAGE_NAMES[STAGE_COUNT] = {
+  "update", "render", "ground"
+};
+
+struct Result
+{
+  std::string scenario;
+  std::string stage;
+  double ns_per_tick;
+  double draws_per_frame;
+  double bytes_per_tick;
+};
+
+struct StageTotals
+{
+  std::vector<double> rep_ns;  // Mean ns/tick of each repetition
+  u64 draws = 0;
+  u64 bytes = 0;
+  u64 ticks = 0;
+};
+
+typedef std::chrono::steady_clock Clock;
+
+static double elapsed_ns(Clock::time_point start, Clock::time_point end)
+{
+  return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+// Cost of an empty timed region, subtracted from every measurement
+static double timer_overhead_ns()
+{
+  std::vector<double> samples(10000);
+  for (double& sample : samples)
+  {
+    Clock::time_point start = Clock::now();
+    sample = elapsed_ns(start, Clock::now());
+  }
+  std::nth_element(samples.begin(), samples.begin() + samples.size() / 2,
+                   samples.end());
+  return samples[samples.size() / 2];
+}
+
+// Lower quartile of the repetitions: interference from the rest of the
+// machine only ever adds time, so the faster runs are the steadier ones
+static double lower_quartile(std::vector<double> values)
+{
+  if (values.empty())
+  {
+    return 0;
+  }
+  std::nth_element(values.begin(), values.begin() + values.size() / 4,
+                   values.end());
+  return values[values.size() / 4];
+}
+
+static void run_scenario(const Scenario& scenario, long min_ticks,
+                         double overhead, std::vector<Result>& results)
+{
+  StageTotals totals[STAGE_COUNT];
+  HostStorage storage;
+  CountingRenderer renderer;
+
+  long timed = 0;
+  for (u32 rep = 0; timed < min_ticks || rep < 16; rep++)
+  {
+    GameState game(storage, rep + 1);
+    scenario.prepare(game, rep + 1);
+
+    double rep_ns[STAGE_COUNT] = {};
+    long ticks = 0;
+    for (; ticks < scenario.max_ticks && scenario.running(game); ticks++)
+    {
+      InputState input;
+      input.held = scenario.held;
+      if (scenario.flap_by_pilot && pilot_flaps(game))
+      {
+        input.buttons = INPUT_BUTTON_A;
+      }
+
+      // Update
+      u64 bytes = allocated_bytes;
+      Clock::time_point start = Clock::now();
+      game.update(input);
+      Clock::time_point end = Clock::now();
+      rep_ns[STAGE_UPDATE] += std::max(elapsed_ns(start, end) - overhead, 0.0);
+      totals[STAGE_UPDATE].bytes += allocated_bytes - bytes;
+
+      // Whole frame
+      bytes = allocated_bytes;
+      u64 calls = renderer.calls;
+      start = Clock::now();
+      game.render(renderer);
+      end = Clock::now();
+      rep_ns[STAGE_RENDER] += std::max(elapsed_ns(start, end) - overhead, 0.0);
+      totals[STAGE_RENDER].bytes += allocated_bytes - bytes;
+      totals[STAGE_RENDER].draws += renderer.calls - calls;
+
+      // Ground alone, at the scroll position this tick reached
+      if (scenario.draws_ground)
+      {
+        GameSnapshot now = game.save_snapshot();
+        bytes = allocated_bytes;
+        calls = renderer.calls;
+        start = Clock::now();
+        GameState::render_ground(renderer, now.ground_scroll_offset,
+                                 now.world_scroll_x);
+        end = Clock::now();
+        rep_ns[STAGE_GROUND] += std::max(elapsed_ns(start, end) - overhead, 0.0);
+        totals[STAGE_GROUND].bytes += allocated_bytes - bytes;
+        totals[STAGE_GROUND].draws += renderer.calls - calls;
+      }
+    }
+
+    if (ticks == 0)
+    {
+      fprintf(stderr, "%s: scenario has no ticks to time\n", scenario.name);
+      exit(1);
+    }
+
+    for (int stage = 0; stage < STAGE_COUNT; stage++)
+    {
+      totals[stage].rep_ns.push_back(rep_ns[stage] / ticks);
+      totals[stage].ticks += ticks;
+    }
+    timed += ticks;
+  }
+
+  for (int stage = 0; stage < STAGE_COUNT; stage++)
+  {
+    if (stage == STAGE_GROUND && !scenario.draws_ground)
+    {
+      continue;
+    }
+
+    const StageTotals& total = totals[stage];
+    results.push_back(Result{
+      scenario.name,
+      STAGE_NAMES[stage],
+      lower_quartile(total.rep_ns),
+      static_cast<double>(total.draws) / total.ticks,
+      static_cast<double>(total.bytes) / total.ticks
+    });
+  }
+}
+
+// ============================================================================
+// Baseline
+// ============================================================================
+
+// What a baseline file holds: the counts (scenario stage draws/frame
+// bytes/tick) or the times (scenario stage ns/tick)
+enum class Baseline
+{
+  Counts,
+  Times
+};
+
+static bool write_baseline(const char* path, Baseline kind,
+                           const std::vector<Result>& results)
+{
+  FILE* file = fopen(path, "w");
+  if (!file)
+  {
+    return false;
+  }
+
+  if (kind == Baseline::Counts)
+  {
+    fprintf(file, "# scenario_bench counts (make bench-counts rewrites it)\n"
+                  "# scenario stage draws/frame bytes/tick\n");
+  }
+  else
+  {
+    fprintf(file, "# scenario_bench times on this machine (make bench-baseline)\n"
+                  "# scenario stage ns/tick\n");
+  }
+  for (const Result& result : results)
+  {
+    if (kind == Baseline::Counts)
+    {
+      fprintf(file, "%s %s %.3f %.3f\n", result.scenario.c_str(),
+              result.stage.c_str(), result.draws_per_frame, result.bytes_per_tick);
+    }
+    else
+    {
+      fprintf(file, "%s %s %.1f\n", result.scenario.c_str(), result.stage.c_str(),
+              result.ns_per_tick);
+    }
+  }
+  return fclose(file) == 0;
+}
+
+static bool read_baseline(const char* path, Baseline kind,
+                          std::vector<Result>& baseline)
+{
+  FILE* file = fopen(path, "r");
+  if (!file)
+  {
+    return false;
+  }
+
+  char line[256];
+  while (fgets(line, sizeof(line), file))
+  {
+    char scenario[64];
+    char stage[64];
+    Result result = {};
+    const bool parsed =
+      kind == Baseline::Counts
+      ? sscanf(line, "%63s %63s %lf %lf", scenario, stage,
+               &result.draws_per_frame, &result.bytes_per_tick) == 4
+      : sscanf(line, "%63s %63s %lf", scenario, stage, &result.ns_per_tick) == 3;
+    if (line[0] == '#' || !parsed)
+    {
+      continue;
+    }
+    result.scenario = scenario;
+    result.stage = stage;
+    baseline.push_back(result);
+  }
+
+  fclose(file);
+  return true;
+}
+
+// Counts are exact; times get the tolerance
+static int compare(const std::vector<Result>& results, Baseline kind,
+                   const std::vector<Result>& baseline, double tolerance)
+{
+  const double EXACT = 1e-3;     // Rounding of the stored values
+  const double JITTER_NS = 20;  // Below this, times are timer noise
+  int regressions = 0;
+
+  for (const Result& result : results)
+  {
+    auto base = std::find_if(baseline.begin(), baseline.end(),
+                             [&](const Result& entry)
+    {
+      return entry.scenario == result.scenario && entry.stage == result.stage;
+    });
+    if (base == baseline.end())
+    {
+      printf("%-12s %-7s not in the baseline\n", result.scenario.c_str(),
+             result.stage.c_str());
+      continue;
+    }
+
+    if (kind == Baseline::Times &&
+        result.ns_per_tick > base->ns_per_tick * (1 + tolerance) + JITTER_NS)
+    {
+      printf("REGRESSION %s %s: %.1f ns/tick, baseline %.1f\n",
+             result.scenario.c_str(), result.stage.c_str(),
+             result.ns_per_tick, base->ns_per_tick);
+      regressions++;
+    }
+    if (kind == Baseline::Counts &&
+        result.draws_per_frame > base->draws_per_frame + EXACT)
+    {
+      printf("REGRESSION %s %s: %.3f draws/frame, baseline %.3f\n",
+             result.scenario.c_str(), result.stage.c_str(),
+             result.draws_per_frame, base->draws_per_frame);
+      regressions++;
+    }
+    if (kind == Baseline::Counts &&
+        result.bytes_per_tick > base->bytes_per_tick + EXACT)
+    {
+      printf("REGRESSION %s %s: %.3f bytes/tick, baseline %.3f\n",
+             result.scenario.c_str(), result.stage.c_str(),
+             result.bytes_per_tick, base->bytes_per_tick);
+      regressions++;
+    }
+  }
+
+  return regressions;
+}
+
+// Compares against one baseline file; false if it regressed or cannot be read
+static bool check_baseline(const char* path, Baseline kind,
+                           const std::vector<Result>& results, double tolerance)
+{
+  std::vector<Result> baseline;
+  if (!read_baseline(path, kind, baseline))
+  {
+    fprintf(stderr, "%s: cannot read\n", path);
+    return false;
+  }
+
+  const int regressions = compare(results, kind, baseline, tolerance);
+  if (regressions > 0)
+  {
+    printf("%d regression(s) against %s\n", regressions, path);
+    return false;
+  }
+  if (kind == Baseline::Counts)
+  {
+    printf("no regressions against %s\n", path);
+  }
+  else
+  {
+    printf("no regressions against %s (time tolerance %.0f%%)\n", path,
+           tolerance * 100);
+  }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  long min_ticks = 20000;
+  const char* counts_path = nullptr;
+  const char* times_path = nullptr;
+  const char* write_counts = nullptr;
+  const char* write_times = nullptr;
+  double tolerance = 0.3;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--min-ticks") == 0 && i + 1 < argc)
+    {
+      min_ticks = strtol(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--counts") == 0 && i + 1 < argc)
+    {
+      counts_path = argv[++i];
+    }
+    else if (strcmp(argv[i], "--times") == 0 && i + 1 < argc)
+    {
+      times_path = argv[++i];
+    }
+    else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc)
+    {
+      tolerance = strtod(argv[++i], nullptr);
+    }
+    else if (strcmp(argv[i], "--write-counts") == 0 && i + 1 < argc)
+    {
+      write_counts = argv[++i];
+    }
+    else if (strcmp(argv[i], "--write-times") == 0 && i + 1 < argc)
+    {
+      write_times = argv[++i];
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--min-ticks N] [--counts FILE] [--times FILE] "
+                      "[--tolerance F] [--write-counts FILE] [--write-times FILE]\n",
+              argv[0]);
+      return 1;
+    }
+  }
+
+  const double overhead = timer_overhead_ns();
+  std::vector<Result> results;
+  for (const Scenario& scenario : SCENARIOS)
+  {
+    run_scenario(scenario, min_ticks, overhead, results);
+  }
+
+  printf("timer overhead %.1f ns (subtracted)\n", overhead);
+  printf("%-12s %-7s %10s %12s %11s\n", "scenario", "stage", "ns/tick",
+         "draws/frame", "bytes/tick");
+  for (const Result& result : results)
+  {
+    printf("%-12s %-7s %10.1f %12.1f %11.1f\n", result.scenario.c_str(),
+           result.stage.c_str(), result.ns_per_tick, result.draws_per_frame,
+           result.bytes_per_tick);
+  }
+
+  const struct
+  {
+    const char* path;
+    Baseline kind;
+  } writes[] = { { write_counts, Baseline::Counts }, { write_times, Baseline::Times } };
+  for (const auto& write : writes)
+  {
+    if (!write.path)
+    {
+      continue;
+    }
+    if (!write_baseline(write.path, write.kind, results))
+    {
+      fprintf(stderr, "%s: cannot write\n", write.path);
+      return 1;
+    }
+    printf("wrote %s\n", write.path);
+  }
+
+  // Both are checked, so one run reports every regression
+  bool ok = true;
+  if (counts_path)
+  {
+    ok = check_baseline(counts_path, Baseline::Counts, results, tolerance) && ok;
+  }
+  if (times_path)
+  {
+    ok = check_baseline(times_path, Baseline::Times, results, tolerance) && ok;
+  }
+  if (!ok)
+  {
+    return 1;
+  }
+
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,201 @@
+// tools/sfx_convert.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Converts a PCM WAV file into the sound file the game embeds (see
+// sound.hpp): 16-bit samples byte-swapped to big-endian, 8-bit samples
+// made signed, behind a small header and padded to SOUND_ALIGN. The
+// Makefile runs it on every assets/sfx/*.wav for both builds, so the
+// console plays the samples in place instead of converting them at boot.
+//
+// Built on its own, without the game objects, since those embed its
+// output.
+//
+// Usage: sfx_convert IN.wav OUT.pcm
+
+// C++ Standard Library
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <string.h>
+
+// Project headers
+#include "sound.hpp"
+
+static const u16 WAVE_FORMAT_PCM = 1;
+
+static u16 get_u16_le(const u8* in)
+{
+  return static_cast<u16>(in[0] | (in[1] << 8));
+}
+
+static u32 get_u32_le(const u8* in)
+{
+  return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<u32>(in[3]) << 24);
+}
+
+static void put_u32_be(u8* out, u32 value)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    out[i] = static_cast<u8>(value >> (24 - 8 * i));
+  }
+}
+
+static bool read_file(const char* path, std::vector<u8>& data)
+{
+  FILE* file = fopen(path, "rb");
+  if (!file)
+  {
+    return false;
+  }
+  u8 buffer[65536];
+  size_t got;
+  while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0)
+  {
+    data.insert(data.end(), buffer, buffer + got);
+  }
+  const bool ok = !ferror(file);
+  fclose(file);
+  return ok;
+}
+
+// Fills `out` with the converted file; prints why and returns false if
+// the WAV is not one the console can play
+static bool convert(const char* path, const std::vector<u8>& wav, std::vector<u8>& out)
+{
+  if (wav.size() < 12 || memcmp(wav.data(), "RIFF", 4) != 0 ||
+      memcmp(wav.data() + 8, "WAVE", 4) != 0)
+  {
+    fprintf(stderr, "%s: not a RIFF WAVE file\n", path);
+    return false;
+  }
+
+  // Walk the chunks: each is an id, a little-endian size, then the body,
+  // padded to an even length
+  const u8* fmt = nullptr;
+  const u8* samples = nullptr;
+  u32 samples_size = 0;
+  size_t pos = 12;
+  while (pos + 8 <= wav.size())
+  {
+    const u8* chunk = wav.data() + pos;
+    const u32 size = get_u32_le(chunk + 4);
+    if (size > wav.size() - pos - 8)
+    {
+      fprintf(stderr, "%s: chunk runs past the end of the file\n", path);
+      return false;
+    }
+    if (memcmp(chunk, "fmt ", 4) == 0 && size >= 16)
+    {
+      fmt = chunk + 8;
+    }
+    else if (memcmp(chunk, "data", 4) == 0)
+    {
+      samples = chunk + 8;
+      samples_size = size;
+    }
+    pos += 8 + size + (size & 1);
+  }
+  if (!fmt || !samples)
+  {
+    fprintf(stderr, "%s: no fmt or data chunk\n", path);
+    return false;
+  }
+
+  const u16 encoding = get_u16_le(fmt);
+  const u16 channels = get_u16_le(fmt + 2);
+  const u32 frequency = get_u32_le(fmt + 4);
+  const u16 bits = get_u16_le(fmt + 14);
+  if (encoding != WAVE_FORMAT_PCM || (channels != 1 && channels != 2) ||
+      (bits != 8 && bits != 16) || frequency == 0)
+  {
+    fprintf(stderr, "%s: only 8 or 16-bit PCM, mono or stereo (have format %u, "
+            "%u channels, %u bits)\n", path, encoding, channels, bits);
+    return false;
+  }
+
+  // Whole frames only
+  const u32 frame_size = channels * bits / 8;
+  samples_size -= samples_size % frame_size;
+
+  u8 format;
+  if (bits == 8)
+  {
+    format = channels == 2 ? SOUND_STEREO8 : SOUND_MONO8;
+  }
+  else
+  {
+    format = channels == 2 ? SOUND_STEREO16 : SOUND_MONO16;
+  }
+
+  const u32 padded = (samples_size + SOUND_ALIGN - 1) / SOUND_ALIGN * SOUND_ALIGN;
+  out.assign(SOUND_HEADER_SIZE + padded, 0);
+  memcpy(out.data(), SOUND_FILE_MAGIC, 4);
+  out[4] = SOUND_FILE_VERSION;
+  out[5] = format;
+  put_u32_be(out.data() + 8, frequency);
+  put_u32_be(out.data() + 12, samples_size);
+
+  u8* body = out.data() + SOUND_HEADER_SIZE;
+  if (bits == 8)
+  {
+    // WAV stores 8-bit samples unsigned, the DSP reads them signed
+    for (u32 i = 0; i < samples_size; i++)
+    {
+      body[i] = samples[i] ^ 0x80;
+    }
+  }
+  else
+  {
+    for (u32 i = 0; i < samples_size; i += 2)
+    {
+      body[i] = samples[i + 1];
+      body[i + 1] = samples[i];
+    }
+  }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc != 3)
+  {
+    fprintf(stderr, "Usage: %s IN.wav OUT.pcm\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<u8> wav;
+  if (!read_file(argv[1], wav))
+  {
+    fprintf(stderr, "%s: cannot read\n", argv[1]);
+    return 1;
+  }
+
+  std::vector<u8> out;
+  if (!convert(argv[1], wav, out))
+  {
+    return 1;
+  }
+
+  FILE* file = fopen(argv[2], "wb");
+  bool ok = file && fwrite(out.data(), 1, out.size(), file) == out.size();
+  ok = file && fclose(file) == 0 && ok;
+  if (!ok)
+  {
+    fprintf(stderr, "%s: cannot write\n", argv[2]);
+    remove(argv[2]);
+    return 1;
+  }
+  return 0;
+}
+
+// EOF
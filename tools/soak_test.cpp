@@ -0,0 +1,639 @@
+// tools/soak_test.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Property-based soak test. Plays many randomized games through
+// GameState::update (random seeds, random flap policies) and checks
+// invariants after every tick:
+//   - Physics::velocity and the bird position are finite
+//   - a bird that is alive after a tick does not overlap the top or bottom
+//     pipe as they stood during that tick, the ground or the space above
+//     the screen. This is checked against a reference written apart from
+//     the game's collision code (see ReferenceBird), so a bug in that code
+//     shows up instead of agreeing with itself.
+//   - the score rises by at most one per tick, only when the trailing edge
+//     of a pipe has just passed the bird, and never beyond the number of
+//     pipes passed so far
+// A failing game is shrunk (fewer flaps, shorter run) while it still breaks
+// the same invariant, then saved as a replay that flapwii_host --replay
+// plays back. Games are spread over all cores with the work-stealing pool.
+//
+// Usage: soak_test [--games N] [--seed N] [--threads N] [--max-frames N]
+//                  [--out DIR] [--self-test]
+//
+// --self-test adds a deliberately false invariant (score stays below 2)
+// to exercise the shrinker end to end.
+
+// C++ Standard Library
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// System libraries
+#include <png.h>
+
+// Project headers
+#include "bird_shape.hpp"
+#include "constants.hpp"
+#include "game_state.hpp"
+#include "host_platform.hpp"
+#include "physics.hpp"
+#include "replay.hpp"
+#include "work_pool.hpp"
+
+enum class Violation
+{
+  None,
+  NotFinite,
+  Overlap,
+  ScoreJump,
+  ScoreWithoutPass,
+  SelfTest,
+  Count
+};
+
+static const char* const VIOLATION_NAMES[] = {
+  "none",
+  "non-finite velocity or position",
+  "alive overlapping a pipe or the screen edge",
+  "score rose by more than one",
+  "score rose without a pipe pass",
+  "self-test: score reached 2"
+};
+
+// How the flaps of one game are chosen. Mixed so that some games die early
+// and others fly deep into the pipe stream.
+struct SoakPolicy
+{
+  enum Kind
+  {
+    Random,    // Flap with a fixed chance each tick
+    Tracking,  // Aim for the next gap with a random offset, plus noise
+    Pulse      // Flap every N ticks
+  } kind;
+
+  float chance;
+  float margin;
+  int period;
+  Rng rng;
+
+  explicit SoakPolicy(u32 seed)
+    : rng(seed ^ 0x5EEDF1A9u)
+  {
+    kind = static_cast<Kind>(rng.below(3));
+    chance = 0.01f + rng.below(200) / 1000.0f;
+    margin = static_cast<float>(rng.below(PIPE_GAP)) - PIPE_GAP / 4;
+    period = 10 + rng.below(30);
+  }
+
+  bool decide(const GameSnapshot& game, int frame)
+  {
+    switch (kind)
+    {
+      case Random:
+        return rng.below(1000) < chance * 1000;
+      case Tracking:
+      {
+        const Pipe& next = game.physics.pipe_iter ? game.pipe_2 : game.pipe_1;
+        float bottom = to_float(game.physics.get_y()) + BIRD_HEIGHT * BIRD_SCALE;
+        bool want = bottom > to_float(next.y) - margin && game.physics.velocity > 0;
+        return rng.below(1000) < chance * 250 ? !want : want;
+      }
+      default:
+        return frame % period == 0;
+    }
+  }
+};
+
+struct GameOutcome
+{
+  Violation violation = Violation::None;
+  int frame = 0;    // Tick of the violation, or ticks played
+  std::vector<int> flaps;
+};
+
+static bool finite(Scalar value)
+{
+  return std::isfinite(to_float(value));
+}
+
+// Embedded by the build, as for the game's collision masks
+extern "C" {
+    extern const u8 bird_png[];
+    extern const u8 bird_png_end[];
+}
+
+// Texels this far away in every direction must be opaque as well, about
+// a world pixel at the bird's scale
+static const int CORE_RADIUS = 4;
+
+// Every POINT_STRIDE-th core texel across and down becomes a point
+static const int POINT_STRIDE = 4;
+
+// How far inside a pipe or past a screen edge a point must be to count
+static const double OVERLAP_MARGIN = 3.0;
+
+// The bird for the overlap invariant, built without Hitbox, OrientedBox,
+// the bird_shape table or the collision masks. For each tilt it is a cloud
+// of points: the centers of bird.png texels deep inside its opaque part,
+// placed in world space as GRRLIB draws the tilted sprite, with the trig
+// done in double precision. A point more than OVERLAP_MARGIN pixels inside
+// a pipe or past an edge is an overlap; the inset and the margin take up
+// the game's rounding to whole pixels and the transparent columns down the
+// sides of the pipe's body, so only a real overlap counts.
+class ReferenceBird
+{
+public:
+  static const ReferenceBird& get()
+  {
+    static const ReferenceBird bird;
+    return bird;
+  }
+
+  bool overlaps(double x, double y, int tilt, const Pipe& pipe_1,
+                const Pipe& pipe_2) const
+  {
+    const Cloud& cloud = clouds[tilt + TILT_STEPS];
+    const double far = std::numeric_limits<double>::infinity();
+    if (cloud.inside(x, y, -far, far, -far, -OVERLAP_MARGIN) ||
+        cloud.inside(x, y, -far, far, GROUND_Y + OVERLAP_MARGIN, far))
+    {
+      return true;
+    }
+
+    const Pipe* pipes[2] = { &pipe_1, &pipe_2 };
+    for (const Pipe* pipe : pipes)
+    {
+      const double left = to_float(pipe->x) + OVERLAP_MARGIN;
+      const double right = to_float(pipe->x) + PIPE_WIDTH - OVERLAP_MARGIN;
+      const double gap_top = to_float(pipe->y) - PIPE_GAP - OVERLAP_MARGIN;
+      const double gap_bottom = to_float(pipe->y) + OVERLAP_MARGIN;
+      if (cloud.inside(x, y, left, right, -far, gap_top) ||
+          cloud.inside(x, y, left, right, gap_bottom, far))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  // Points relative to the bird's position, and the box around them
+  struct Cloud
+  {
+    std::vector<double> x;
+    std::vector<double> y;
+    double left = 0;
+    double top = 0;
+    double right = 0;
+    double bottom = 0;
+
+    // Whether a point of the bird at (bird_x, bird_y) lies strictly inside
+    // the rectangle
+    bool inside(double bird_x, double bird_y, double rect_left, double rect_right,
+                double rect_top, double rect_bottom) const
+    {
+      if (bird_x + right <= rect_left || bird_x + left >= rect_right ||
+          bird_y + bottom <= rect_top || bird_y + top >= rect_bottom)
+      {
+        return false;
+      }
+      for (size_t i = 0; i < x.size(); i++)
+      {
+        const double px = bird_x + x[i];
+        const double py = bird_y + y[i];
+        if (px > rect_left && px < rect_right && py > rect_top && py < rect_bottom)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+  };
+
+  std::vector<Cloud> clouds;
+
+  ReferenceBird()
+  {
+    // Without a texture the whole quad is solid, as in the game
+    int width = BIRD_WIDTH;
+    int height = BIRD_HEIGHT;
+    std::vector<u8> alpha(static_cast<size_t>(width) * height, 255);
+    png_image image = {};
+    image.version = PNG_IMAGE_VERSION;
+    if (png_image_begin_read_from_memory(&image, bird_png, bird_png_end - bird_png))
+    {
+      image.format = PNG_FORMAT_GA;
+      std::vector<u8> bytes(PNG_IMAGE_SIZE(image));
+      if (png_image_finish_read(&image, nullptr, bytes.data(), 0, nullptr))
+      {
+        width = image.width;
+        height = image.height;
+        alpha.resize(static_cast<size_t>(width) * height);
+        for (size_t i = 0; i < alpha.size(); i++)
+        {
+          alpha[i] = bytes[i * 2 + 1];
+        }
+      }
+    }
+
+    auto core = [&](int u, int v)
+    {
+      for (int dv = -CORE_RADIUS; dv <= CORE_RADIUS; dv++)
+      {
+        for (int du = -CORE_RADIUS; du <= CORE_RADIUS; du++)
+        {
+          const int cu = u + du;
+          const int cv = v + dv;
+          if (cu < 0 || cu >= width || cv < 0 || cv >= height ||
+              alpha[static_cast<size_t>(cv) * width + cu] < 128)
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    };
+
+    // GRRLIB_DrawImg turns the sprite about its center, and with the
+    // default handle puts that center at the half size rotated
+    const double scale = BIRD_SCALE;
+    const double half_width = width * scale / 2;
+    const double half_height = height * scale / 2;
+    for (int tilt = -TILT_STEPS; tilt <= TILT_STEPS; tilt++)
+    {
+      const double radians = tilt * TILT_DEGREES_PER_STEP * M_PI / 180;
+      const double s = std::sin(radians);
+      const double c = std::cos(radians);
+      const double center_x = half_width * c - half_height * s;
+      const double center_y = half_height * c - half_width * s;
+
+      Cloud cloud;
+      for (int v = 0; v < height; v += POINT_STRIDE)
+      {
+        for (int u = 0; u < width; u += POINT_STRIDE)
+        {
+          if (!core(u, v))
+          {
+            continue;
+          }
+          const double dx = (u + 0.5) * scale - half_width;
+          const double dy = (v + 0.5) * scale - half_height;
+          cloud.x.push_back(center_x + c * dx - s * dy);
+          cloud.y.push_back(center_y + s * dx + c * dy);
+        }
+      }
+      if (!cloud.x.empty())
+      {
+        cloud.left = *std::min_element(cloud.x.begin(), cloud.x.end());
+        cloud.right = *std::max_element(cloud.x.begin(), cloud.x.end());
+        cloud.top = *std::min_element(cloud.y.begin(), cloud.y.end());
+        cloud.bottom = *std::max_element(cloud.y.begin(), cloud.y.end());
+      }
+      clouds.push_back(std::move(cloud));
+    }
+  }
+};
+
+// Check one tick: `before` is the state the tick started from
+static Violation check_tick(const GameSnapshot& before, const GameSnapshot& after,
+                            int& passes, bool self_test)
+{
+  const Physics& bird = after.physics;
+  if (!finite(bird.velocity) || !finite(bird.get_x()) || !finite(bird.get_y()))
+  {
+    return Violation::NotFinite;
+  }
+
+  // Collision saw the pipes before they moved on this tick
+  if (!bird.dead &&
+      ReferenceBird::get().overlaps(to_float(bird.get_x()), to_float(bird.get_y()),
+                                    bird_tilt(bird.velocity), before.pipe_1,
+                                    before.pipe_2))
+  {
+    return Violation::Overlap;
+  }
+
+  // A pass: a pipe's trailing edge has moved past the bird's centre, both
+  // in this tick or in the scoring window just behind it
+  const Scalar center = Scalar(BIRD_START_X) + Scalar((BIRD_WIDTH * BIRD_SCALE) / 2);
+  const Pipe* old_pipes[2] = { &before.pipe_1, &before.pipe_2 };
+  const Pipe* new_pipes[2] = { &after.pipe_1, &after.pipe_2 };
+  bool passing = false;
+  for (int p = 0; p < 2; p++)
+  {
+    Scalar right = old_pipes[p]->x + PIPE_WIDTH;
+    if (right < center && right + 20 > center)
+    {
+      passing = true;
+    }
+    if (right >= center && new_pipes[p]->x < old_pipes[p]->x &&
+        new_pipes[p]->x + PIPE_WIDTH < center)
+    {
+      passes++;
+    }
+  }
+
+  int gained = after.physics.score - before.physics.score;
+  if (gained < 0 || gained > 1)
+  {
+    return Violation::ScoreJump;
+  }
+  if (gained == 1 && (!passing || after.physics.score > passes))
+  {
+    return Violation::ScoreWithoutPass;
+  }
+
+  if (self_test && after.physics.score >= 2)
+  {
+    return Violation::SelfTest;
+  }
+
+  return Violation::None;
+}
+
+// Play one run. With a policy, flaps are chosen live and recorded;
+// without one, the given flap ticks are replayed (for shrinking).
+static GameOutcome play(GameState& game, u32 seed, SoakPolicy* policy,
+                        const std::vector<int>* flaps, int max_frames,
+                        bool self_test)
+{
+  GameOutcome outcome;
+  game.start_game(seed);
+
+  int passes = 0;
+  size_t next_flap = 0;
+  for (int frame = 0; frame < max_frames && !game.in_menu(); frame++)
+  {
+    GameSnapshot before = game.save_snapshot();
+
+    bool flap;
+    if (policy)
+    {
+      flap = !before.is_dying && policy->decide(before, frame);
+    }
+    else
+    {
+      flap = next_flap < flaps->size() && (*flaps)[next_flap] == frame;
+      next_flap += flap;
+    }
+    if (flap)
+    {
+      outcome.flaps.push_back(frame);
+    }
+
+    InputState input;
+    input.buttons = flap ? INPUT_BUTTON_A : 0;
+    game.update(input);
+
+    if (game.in_menu())
+    {
+      break;  // Fell to the ground; the run is over
+    }
+
+    Violation violation = check_tick(before, game.save_snapshot(), passes,
+                                     self_test);
+    if (violation != Violation::None)
+    {
+      outcome.violation = violation;
+      outcome.frame = frame;
+      return outcome;
+    }
+    outcome.frame = frame + 1;
+  }
+
+  return outcome;
+}
+
+// Greedy delta debugging: drop runs of flaps, halving the run length,
+// while the game still breaks the same invariant
+static GameOutcome shrink(GameState& game, u32 seed, GameOutcome failing,
+                          bool self_test)
+{
+  auto still_fails = [&](const std::vector<int>& flaps, GameOutcome& result)
+  {
+    result = play(game, seed, nullptr, &flaps, failing.frame + 1, self_test);
+    return result.violation == failing.violation;
+  };
+
+  for (size_t chunk = std::max<size_t>(failing.flaps.size() / 2, 1); chunk > 0;
+       chunk /= 2)
+  {
+    size_t i = 0;
+    while (i < failing.flaps.size())
+    {
+      std::vector<int> candidate = failing.flaps;
+      candidate.erase(candidate.begin() + i,
+                      candidate.begin() + std::min(i + chunk, candidate.size()));
+
+      GameOutcome result;
+      if (still_fails(candidate, result))
+      {
+        failing = result;  // Also picks up an earlier failure frame
+      }
+      else
+      {
+        i += chunk;
+      }
+    }
+  }
+
+  return failing;
+}
+
+static bool save_replay(const std::string& path, u32 seed,
+                        const GameOutcome& outcome, int score)
+{
+  ReplayRecorder recorder;
+  recorder.begin(seed);
+  size_t next_flap = 0;
+  for (int frame = 0; frame <= outcome.frame; frame++)
+  {
+    bool flap = next_flap < outcome.flaps.size() &&
+                outcome.flaps[next_flap] == frame;
+    next_flap += flap;
+    recorder.record(flap);
+  }
+  const std::vector<u8>& file = recorder.finish(score);
+
+  FILE* out = fopen(path.c_str(), "wb");
+  if (!out)
+  {
+    return false;
+  }
+  fwrite(file.data(), 1, file.size(), out);
+  return fclose(out) == 0;
+}
+
+// SplitMix-style scramble so consecutive game numbers get unrelated seeds
+static u32 game_seed(u32 base, u64 index)
+{
+  u64 z = (static_cast<u64>(base) << 32) + index + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return static_cast<u32>(z ^ (z >> 31));
+}
+
+int main(int argc, char** argv)
+{
+  u64 games = 100000;
+  u32 base_seed = 1;
+  unsigned threads = 0;
+  int max_frames = 60 * 60 * SIM_TICK_RATE;  // An hour of play
+  std::string out_dir = ".";
+  bool self_test = false;
+  const size_t max_reports = 8;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--games") == 0 && i + 1 < argc)
+    {
+      games = strtoull(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+    {
+      base_seed = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+    {
+      threads = strtoul(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--max-frames") == 0 && i + 1 < argc)
+    {
+      max_frames = strtol(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+    {
+      out_dir = argv[++i];
+    }
+    else if (strcmp(argv[i], "--self-test") == 0)
+    {
+      self_test = true;
+    }
+    else
+    {
+      fprintf(stderr, "Usage: %s [--games N] [--seed N] [--threads N] "
+                      "[--max-frames N] [--out DIR] [--self-test]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  WorkPool pool(threads);
+
+  // One game per worker, reused for every run it plays
+  HostStorage storage("");
+  std::vector<std::unique_ptr<GameState>> workers(pool.size());
+  for (auto& worker : workers)
+  {
+    worker = std::make_unique<GameState>(storage, 0);
+  }
+
+  struct Failure
+  {
+    u64 index;
+    u32 seed;
+    GameOutcome original;
+  };
+
+  std::atomic<u64> total_frames{0};
+  std::atomic<u64> counts[static_cast<int>(Violation::Count)] = {};
+  std::mutex failures_lock;
+  std::vector<Failure> failures;
+
+  auto start = std::chrono::steady_clock::now();
+
+  pool.parallel_for(games, [&](size_t index, unsigned worker)
+  {
+    u32 seed = game_seed(base_seed, index);
+    SoakPolicy policy(seed);
+    GameOutcome outcome = play(*workers[worker], seed, &policy, nullptr,
+                               max_frames, self_test);
+
+    total_frames.fetch_add(outcome.frame, std::memory_order_relaxed);
+    if (outcome.violation == Violation::None)
+    {
+      return;
+    }
+
+    counts[static_cast<int>(outcome.violation)]++;
+    std::lock_guard<std::mutex> guard(failures_lock);
+    if (failures.size() < max_reports)
+    {
+      failures.push_back({ index, seed, outcome });
+    }
+  });
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  double seconds = elapsed.count();
+
+  // Shrink and save the first few failures (single-threaded; rare)
+  std::sort(failures.begin(), failures.end(), [](const Failure& a, const Failure& b)
+  {
+    return a.index < b.index;
+  });
+  for (const Failure& failure : failures)
+  {
+    GameState& game = *workers[0];
+    GameOutcome minimal = shrink(game, failure.seed, failure.original, self_test);
+
+    // Score at the failing tick, for the replay header
+    play(game, failure.seed, nullptr, &minimal.flaps, minimal.frame + 1, self_test);
+    int score = game.save_snapshot().physics.score;
+
+    std::string path = out_dir + "/soak_fail_" + std::to_string(failure.index) + ".rpl";
+    bool saved = save_replay(path, failure.seed, minimal, score);
+
+    printf("FAIL game %llu (seed %u): %s at tick %d\n",
+           static_cast<unsigned long long>(failure.index), failure.seed,
+           VIOLATION_NAMES[static_cast<int>(failure.original.violation)],
+           failure.original.frame);
+    printf("     shrunk from %zu flaps / %d ticks to %zu flaps / %d ticks%s%s\n",
+           failure.original.flaps.size(), failure.original.frame + 1,
+           minimal.flaps.size(), minimal.frame + 1,
+           saved ? ", saved " : ", could not save ", path.c_str());
+  }
+
+  u64 failed = 0;
+  for (int v = 1; v < static_cast<int>(Violation::Count); v++)
+  {
+    failed += counts[v];
+  }
+
+  printf("games:         %llu\n", static_cast<unsigned long long>(games));
+  printf("ticks:         %llu\n", static_cast<unsigned long long>(total_frames.load()));
+  printf("failed games:  %llu\n", static_cast<unsigned long long>(failed));
+  for (int v = 1; v < static_cast<int>(Violation::Count); v++)
+  {
+    if (counts[v])
+    {
+      printf("  %-30s %llu\n", VIOLATION_NAMES[v],
+             static_cast<unsigned long long>(counts[v].load()));
+    }
+  }
+  printf("threads:       %u\n", pool.size());
+  printf("elapsed:       %.3f s\n", seconds);
+  printf("games/second:  %.0f\n", seconds > 0 ? games / seconds : 0.0);
+  printf("ticks/second:  %.0f\n", seconds > 0 ? total_frames.load() / seconds : 0.0);
+
+  return failed ? 1 : 0;
+}
+
+// EOF
@@ -0,0 +1,235 @@
+// tools/telemetry_decode.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Decodes telemetry.bin files (see telemetry.hpp) copied off any number of
+// consoles and summarizes them: runs per mode, scores and survival time,
+// what the birds died on, and frame times. --csv prints every record as
+// one CSV row instead, for a spreadsheet or further scripts.
+//
+// Usage: telemetry_decode [--csv] FILE...
+
+// C++ Standard Library
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+#include <string.h>
+
+// Project headers
+#include "physics.hpp"
+#include "telemetry.hpp"
+
+static const char* const MODE_NAMES[] = { "player", "ghost", "practice", "autopilot" };
+static const char* const CAUSE_NAMES[] = { "none", "pipe_top", "pipe_bottom", "ceiling",
+                                           "ground" };
+static const int MODE_COUNT = sizeof(MODE_NAMES) / sizeof(MODE_NAMES[0]);
+static const int CAUSE_COUNT = sizeof(CAUSE_NAMES) / sizeof(CAUSE_NAMES[0]);
+
+static_assert(CAUSE_COUNT == static_cast<int>(Surface::Ground) + 1,
+              "Surface changed; update CAUSE_NAMES");
+
+static const char* mode_name(u8 mode)
+{
+  return mode < MODE_COUNT ? MODE_NAMES[mode] : "unknown";
+}
+
+static const char* cause_name(u8 cause)
+{
+  return cause < CAUSE_COUNT ? CAUSE_NAMES[cause] : "unknown";
+}
+
+struct Run
+{
+  std::string file;
+  RunRecord record;
+};
+
+// Appends the file's records; false if it cannot be read
+static bool read_runs(const char* path, std::vector<Run>& runs, size_t& skipped)
+{
+  FILE* file = fopen(path, "rb");
+  if (!file)
+  {
+    return false;
+  }
+
+  u8 bytes[TELEMETRY_RECORD_SIZE];
+  size_t got;
+  while ((got = fread(bytes, 1, sizeof(bytes), file)) > 0)
+  {
+    // A short tail is a record cut off mid-write
+    Run run;
+    if (got < sizeof(bytes) || !decode_run_record(bytes, run.record))
+    {
+      skipped++;
+      continue;
+    }
+    run.file = path;
+    runs.push_back(run);
+  }
+  fclose(file);
+  return true;
+}
+
+template <typename T>
+static T median(std::vector<T> values)
+{
+  if (values.empty())
+  {
+    return T();
+  }
+  std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+  return values[values.size() / 2];
+}
+
+static void print_csv(const std::vector<Run>& runs)
+{
+  printf("file,mode,cause,numeric,tick_rate,seed,score,ticks,flaps,frames,"
+         "frame_p50_us,frame_p90_us,frame_p99_us,frame_max_us\n");
+  for (const Run& run : runs)
+  {
+    const RunRecord& r = run.record;
+    printf("%s,%s,%s,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u,%u\n", run.file.c_str(),
+           mode_name(r.mode), cause_name(r.cause), r.numeric_mode, r.tick_rate, r.seed,
+           r.score, r.ticks, r.flaps, r.frames, r.frame_us[0], r.frame_us[1],
+           r.frame_us[2], r.frame_us[3]);
+  }
+}
+
+static void print_summary(const std::vector<Run>& runs)
+{
+  printf("runs:          %zu\n", runs.size());
+  for (int mode = 0; mode < MODE_COUNT; mode++)
+  {
+    std::vector<u32> scores;
+    std::vector<double> seconds;
+    u64 flaps = 0;
+    double play_seconds = 0;
+    size_t causes[CAUSE_COUNT] = {};
+    for (const Run& run : runs)
+    {
+      const RunRecord& r = run.record;
+      if (r.mode != mode)
+      {
+        continue;
+      }
+      scores.push_back(r.score);
+      seconds.push_back(r.tick_rate ? double(r.ticks) / r.tick_rate : 0.0);
+      flaps += r.flaps;
+      play_seconds += seconds.back();
+      if (r.cause < CAUSE_COUNT)
+      {
+        causes[r.cause]++;
+      }
+    }
+    if (scores.empty())
+    {
+      continue;
+    }
+
+    u64 total = 0;
+    for (u32 score : scores)
+    {
+      total += score;
+    }
+    printf("\n%s: %zu runs\n", MODE_NAMES[mode], scores.size());
+    printf("  score:       mean %.1f, median %u, best %u\n",
+           double(total) / scores.size(), median(scores),
+           *std::max_element(scores.begin(), scores.end()));
+    printf("  survived:    median %.1f s, %.2f flaps per second of play\n",
+           median(seconds), play_seconds > 0 ? flaps / play_seconds : 0.0);
+    printf("  died on:    ");
+    for (int cause = 1; cause < CAUSE_COUNT; cause++)
+    {
+      printf(" %s %.0f%%", CAUSE_NAMES[cause], 100.0 * causes[cause] / scores.size());
+    }
+    printf("\n");
+  }
+
+  // Per-run percentiles cannot be merged exactly; the median of each and
+  // the worst frame anywhere still show a console falling behind
+  std::vector<u16> p50, p90, p99;
+  u16 worst = 0;
+  for (const Run& run : runs)
+  {
+    const RunRecord& r = run.record;
+    if (r.frames == 0)
+    {
+      continue;
+    }
+    p50.push_back(r.frame_us[0]);
+    p90.push_back(r.frame_us[1]);
+    p99.push_back(r.frame_us[2]);
+    worst = std::max(worst, r.frame_us[3]);
+  }
+  if (!p50.empty())
+  {
+    printf("\nframe time:    median per-run p50 %u us, p90 %u us, p99 %u us; "
+           "longest %u us\n", median(p50), median(p90), median(p99), worst);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  bool csv = false;
+  std::vector<const char*> paths;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--csv") == 0)
+    {
+      csv = true;
+    }
+    else if (argv[i][0] == '-')
+    {
+      fprintf(stderr, "Usage: %s [--csv] FILE...\n", argv[0]);
+      return 1;
+    }
+    else
+    {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.empty())
+  {
+    fprintf(stderr, "Usage: %s [--csv] FILE...\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<Run> runs;
+  size_t skipped = 0;
+  for (const char* path : paths)
+  {
+    if (!read_runs(path, runs, skipped))
+    {
+      fprintf(stderr, "%s: cannot read\n", path);
+      return 1;
+    }
+  }
+
+  if (csv)
+  {
+    print_csv(runs);
+  }
+  else
+  {
+    print_summary(runs);
+  }
+  if (skipped > 0)
+  {
+    fprintf(stderr, "skipped %zu records (other version or cut short)\n", skipped);
+  }
+  return 0;
+}
+
+// EOF
@@ -0,0 +1,222 @@
+// tools/voice_pool_test.cpp
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+// Flapwii Bird
+// Copyright (C) 2026 DeltaResero
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// Checks VoicePool's voice stealing (see voice_pool.hpp) against the host
+// software mixer, with the mixer's frame clock as the pool's `now`:
+//   drop      a pool full of important sounds drops a less important one
+//   priority  the least important playing sound is the one taken over
+//   quietest  among equals, the quietest voice is taken over
+//   oldest    among equally loud equals, the oldest voice is taken over
+//   reuse     a voice whose sound has finished is reused, not stolen
+// Every sound is silence of its own length, so which voice was taken over
+// shows in when the pool runs dry. At each point the pool's count of busy
+// voices must also match the voices the mixer is still playing. Exits
+// with status 1 if any check fails.
+//
+// Usage: voice_pool_test
+
+// C++ Standard Library
+#include <vector>
+
+// C Standard Library
+#include <stdio.h>
+
+// Project headers
+#include "soft_mixer.hpp"
+#include "sound.hpp"
+#include "voice.hpp"
+#include "voice_pool.hpp"
+
+static const u32 FRAMES_PER_MS = SoftMixer::OUTPUT_RATE / 1000;
+
+// Silence lasting `ms` at the mixer's rate, so it plays one to one
+struct Clip
+{
+  std::vector<u8> samples;
+  Sound sound;
+
+  explicit Clip(u32 ms)
+    : samples(ms * FRAMES_PER_MS * 2)
+    , sound(SOUND_MONO16, samples.data(), static_cast<u32>(samples.size()),
+            static_cast<f32>(SoftMixer::OUTPUT_RATE))
+  {
+  }
+};
+
+static u64 now()
+{
+  return Voice::PlaybackMicros();
+}
+
+static void advance(u32 ms)
+{
+  host_mixer().render(ms * FRAMES_PER_MS);
+}
+
+static bool failed = false;
+
+// Busy voices by the pool's reckoning must be `expected`, and the mixer
+// must agree
+static void expect_active(const char* check, const VoicePool& pool, int expected)
+{
+  const int active = pool.active(now());
+  const int playing = static_cast<int>(host_mixer().get_playing());
+  if (active != expected || playing != expected)
+  {
+    fprintf(stderr, "%s: %d voices busy, mixer playing %d, expected %d\n", check,
+            active, playing, expected);
+    failed = true;
+  }
+}
+
+static void expect_counts(const char* check, const VoicePool& pool, u32 stolen,
+                          u32 dropped)
+{
+  if (pool.get_stolen() != stolen || pool.get_dropped() != dropped)
+  {
+    fprintf(stderr, "%s: %u stolen, %u dropped, expected %u and %u\n", check,
+            pool.get_stolen(), pool.get_dropped(), stolen, dropped);
+    failed = true;
+  }
+}
+
+static void check_drop()
+{
+  const Clip long_clip(100);
+  const Clip short_clip(10);
+  VoicePool pool;
+  for (int i = 0; i < VoicePool::VOICES; i++)
+  {
+    pool.play(long_clip.sound, 3, 255, 1.0f, now());
+  }
+  advance(1);
+
+  if (pool.play(short_clip.sound, 0, 255, 1.0f, now()))
+  {
+    fprintf(stderr, "drop: a low priority sound took a voice\n");
+    failed = true;
+  }
+  expect_counts("drop", pool, 0, 1);
+  expect_active("drop", pool, VoicePool::VOICES);
+  pool.stop_all();
+}
+
+// The voice playing the long clip should be the one taken over: with it
+// gone, everything is over once the short clips end
+static void check_taken(const char* check, VoicePool& pool, u8 priority)
+{
+  const Clip newcomer(10);
+  advance(1);
+  if (!pool.play(newcomer.sound, priority, 255, 1.0f, now()))
+  {
+    fprintf(stderr, "%s: sound dropped\n", check);
+    failed = true;
+  }
+  expect_counts(check, pool, 1, 0);
+
+  // The short clips (100 ms) are over, the long one (300 ms) would not be
+  advance(150);
+  expect_active(check, pool, 0);
+  pool.stop_all();
+}
+
+static void check_priority()
+{
+  const Clip clip(100);
+  const Clip long_clip(300);
+  VoicePool pool;
+  for (int i = 0; i < VoicePool::VOICES; i++)
+  {
+    // The odd one out is loud, but matters least
+    const bool odd = i == 5;
+    pool.play(odd ? long_clip.sound : clip.sound, odd ? 1 : 2, odd ? 255 : 60, 1.0f,
+              now());
+  }
+  check_taken("priority", pool, 2);
+}
+
+static void check_quietest()
+{
+  const Clip clip(100);
+  const Clip long_clip(300);
+  VoicePool pool;
+  for (int i = 0; i < VoicePool::VOICES; i++)
+  {
+    const bool odd = i == 3;
+    pool.play(odd ? long_clip.sound : clip.sound, 2, odd ? 100 : 255, 1.0f, now());
+  }
+  check_taken("quietest", pool, 2);
+}
+
+static void check_oldest()
+{
+  const Clip clip(100);
+  const Clip long_clip(300);
+  VoicePool pool;
+  pool.play(long_clip.sound, 2, 255, 1.0f, now());
+  for (int i = 1; i < VoicePool::VOICES; i++)
+  {
+    advance(1);
+    pool.play(clip.sound, 2, 255, 1.0f, now());
+  }
+  check_taken("oldest", pool, 2);
+}
+
+static void check_reuse()
+{
+  const Clip clip(20);
+  VoicePool pool;
+  for (int i = 0; i < VoicePool::VOICES; i++)
+  {
+    pool.play(clip.sound, 3, 255, 1.0f, now());
+  }
+  advance(30);
+  expect_active("reuse", pool, 0);
+
+  pool.play(clip.sound, 0, 255, 1.0f, now());
+  advance(1);
+  expect_counts("reuse", pool, 0, 0);
+  expect_active("reuse", pool, 1);
+  pool.stop_all();
+}
+
+int main()
+{
+  Voice::InitBackend();
+
+  struct Check
+  {
+    const char* name;
+    void (*run)();
+  };
+  static const Check CHECKS[] = {
+    { "drop", check_drop },
+    { "priority", check_priority },
+    { "quietest", check_quietest },
+    { "oldest", check_oldest },
+    { "reuse", check_reuse },
+  };
+
+  for (const Check& check : CHECKS)
+  {
+    const bool failed_before = failed;
+    failed = false;
+    check.run();
+    printf("%-9s  %s\n", check.name, failed ? "FAILED" : "ok");
+    failed = failed || failed_before;
+  }
+
+  Voice::ShutdownBackend();
+  printf("%s\n", failed ? "FAIL" : "PASS");
+  return failed ? 1 : 0;
+}
+
+// EOF